@@ -7,6 +7,11 @@
 #   SPDX-License-Identifier: MIT
 # =========================================================================
 
+require 'digest'
+require 'fileutils'
+require 'json'
+require 'pathname'
+
 class UnityTestRunnerGenerator
   def initialize(options = nil)
     @options = UnityTestRunnerGenerator.default_options
@@ -44,6 +49,8 @@ class UnityTestRunnerGenerator
       main_name: 'main', # set to :auto to automatically generate each time
       main_export_decl: '',
       cmdline_args: false,
+      shard_timings: nil,
+      cache_runners: false,
       omit_begin_end: false,
       use_param_tests: false,
       use_system_files: true,
@@ -69,6 +76,14 @@ class UnityTestRunnerGenerator
     # pull required data from source file
     source = File.read(input_file)
     source = source.force_encoding('ISO-8859-1').encode('utf-8', replace: nil)
+
+    # a runner generated from the same source and options is still up to date
+    if @options[:cache_runners]
+      cache_key = runner_cache_key(input_file, output_file, source)
+      cached_files_used = read_runner_cache(output_file, cache_key)
+      return cached_files_used unless cached_files_used.nil?
+    end
+
     tests = find_tests(source)
     headers = find_includes(source)
     testfile_includes = @options[:use_system_files] ? (headers[:local] + headers[:system]) : (headers[:local])
@@ -77,20 +92,102 @@ class UnityTestRunnerGenerator
     testfile_includes.delete_if { |inc| inc =~ /(unity|cmock)/ }
     find_setup_and_teardown(source)
 
-    # build runner file
-    generate(input_file, output_file, tests, used_mocks, testfile_includes)
-
     # determine which files were used to return them
     all_files_used = [input_file, output_file]
     all_files_used += testfile_includes.map { |filename| "#{filename}.c" } unless testfile_includes.empty?
     all_files_used += @options[:includes] unless @options[:includes].empty?
     all_files_used += headers[:linkonly] unless headers[:linkonly].empty?
+    all_files_used.uniq!
+
+    # build runner file
+    @cache_stamp = cache_key.nil? ? nil : "/* Runner cache: #{cache_key} #{all_files_used.to_json} */"
+    generate(input_file, output_file, tests, used_mocks, testfile_includes)
+
+    all_files_used
+  end
+
+  # Generates the runners of many test files in one process, which saves
+  # starting Ruby for every file. Runners are named as on the command line,
+  # next to their test files or in runner_dir.
+  def self.run_batch(options, input_files, runner_dir = nil)
+    FileUtils.mkdir_p(runner_dir) unless runner_dir.nil?
+    input_files.map do |input_file|
+      output_file = input_file.gsub('.c', '_Runner.c')
+      output_file = File.join(runner_dir, File.basename(output_file)) unless runner_dir.nil?
+      new(options).run(input_file, output_file)
+    end
+  end
+
+  # Generates a single runner for many test files, so that they are linked
+  # into one executable and started once. Every test file gets a suite file,
+  # next to the runner, which includes it with its setUp, tearDown and tests
+  # renamed after the file; the runner calls each suite in turn.
+  def run_aggregate(input_files, output_file)
+    runner_dir = File.dirname(output_file)
+    suites = aggregate_suite_names(input_files)
+    all_files_used = [output_file]
+    # suiteSetUp and suiteTearDown are looked for in each file on its own
+    suite_flags = @options.values_at(:has_suite_setup, :has_suite_teardown)
+    input_files.zip(suites).each do |input_file, suite|
+      @suite = suite
+      @options[:has_suite_setup], @options[:has_suite_teardown] = suite_flags
+      all_files_used += run(input_file, File.join(runner_dir, "#{suite}_Suite.c"))
+    end
+    @suite = nil
+
+    File.open(output_file, 'w') do |output|
+      create_aggregate_main(output, output_file, suites)
+    end
     all_files_used.uniq
   end
 
+  # One C identifier per test file, from its name without the extension
+  def aggregate_suite_names(input_files)
+    taken = Hash.new(0)
+    input_files.map do |input_file|
+      suite = TypeSanitizer.sanitize_c_identifier(File.basename(input_file, '.*'))
+      taken[suite] += 1
+      taken[suite] > 1 ? "#{suite}_#{taken[suite]}" : suite
+    end
+  end
+
+  # Changes to this script invalidate every cached runner
+  def self.generator_digest
+    @generator_digest ||= Digest::SHA256.hexdigest(%w[generate_test_runner.rb run_test.erb type_sanitizer.rb].map do |file|
+      File.read(File.join(__dir__, file))
+    end.join)
+  end
+
+  def runner_cache_key(input_file, output_file, source)
+    digest = Digest::SHA256.new
+    digest << UnityTestRunnerGenerator.generator_digest
+    digest << @options.sort_by { |key, _| key.to_s }.inspect << @suite.to_s
+    digest << input_file << "\0" << output_file << "\0" << source
+    timings = @options[:shard_timings]
+    digest << File.read(timings) if timings && !timings.to_s.empty? && File.exist?(timings)
+    digest.hexdigest
+  end
+
+  # Returns the files used by the runner when it was generated with this key
+  def read_runner_cache(output_file, cache_key)
+    return nil unless File.exist?(output_file)
+    return nil if @options[:header_file] && !@options[:header_file].empty? && !File.exist?(@options[:header_file])
+
+    stamp = File.foreach(output_file).first(2)[1]
+    return nil unless stamp =~ %r{^/\* Runner cache: (\h+) (.*) \*/$} && Regexp.last_match(1) == cache_key
+
+    JSON.parse(Regexp.last_match(2))
+  rescue JSON::ParserError
+    nil
+  end
+
   def generate(input_file, output_file, tests, used_mocks, testfile_includes)
     File.open(output_file, 'w') do |output|
-      create_header(output, used_mocks, testfile_includes)
+      if @suite
+        create_suite_header(output, input_file, output_file, tests)
+      else
+        create_header(output, used_mocks, testfile_includes)
+      end
       create_externs(output, tests, used_mocks)
       create_mock_management(output, used_mocks)
       create_setup(output)
@@ -100,9 +197,15 @@ class UnityTestRunnerGenerator
       create_reset(output)
       create_run_test(output) unless tests.empty?
       create_args_wrappers(output, tests)
-      create_main(output, input_file, tests, used_mocks)
+      create_test_table(output, tests)
+      if @suite
+        create_suite_main(output, input_file, tests, used_mocks)
+      else
+        create_main(output, input_file, tests, used_mocks)
+      end
     end
 
+    return if @suite
     return unless @options[:header_file] && !@options[:header_file].empty?
 
     File.open(@options[:header_file], 'w') do |output|
@@ -110,32 +213,34 @@ class UnityTestRunnerGenerator
     end
   end
 
+  # contains characters which will be substituted from within strings, doing
+  # this prevents these characters from interfering with scrubbers
+  # @ is not a valid C character, so there should be no clashes with files genuinely containing these markers
+  SUBSTRING_SUBS = { '{' => '@co@', '}' => '@cc@', ';' => '@ss@', '/' => '@fs@' }.freeze
+  SUBSTRING_RE = Regexp.union(SUBSTRING_SUBS.keys)
+  SUBSTRING_UNSUBS = SUBSTRING_SUBS.invert.freeze # the inverse map will be used to fix the strings afterwords
+  SUBSTRING_UNRE = Regexp.union(SUBSTRING_UNSUBS.keys)
+
+  # Strings, characters and comments in the order they start, so that one pass
+  # removes the comments and finds the strings, whatever they contain
+  SCRUB_RE = %r{("(?:\\.|[^"\\\n])*"|'(?:\\.|[^'\\\n])*')|/\*.*?\*/|//[^\n]*}m
+
   def find_tests(source)
     tests_and_line_numbers = []
 
-    # contains characters which will be substituted from within strings, doing
-    # this prevents these characters from interfering with scrubbers
-    # @ is not a valid C character, so there should be no clashes with files genuinely containing these markers
-    substring_subs = { '{' => '@co@', '}' => '@cc@', ';' => '@ss@', '/' => '@fs@' }
-    substring_re = Regexp.union(substring_subs.keys)
-    substring_unsubs = substring_subs.invert                   # the inverse map will be used to fix the strings afterwords
-    substring_unsubs['@quote@'] = '\\"'
-    substring_unsubs['@apos@'] = '\\\''
-    substring_unre = Regexp.union(substring_unsubs.keys)
-    source_scrubbed = source.clone
-    source_scrubbed = source_scrubbed.gsub(/\\"/, '@quote@')   # hide escaped quotes to allow capture of the full string/char
-    source_scrubbed = source_scrubbed.gsub(/\\'/, '@apos@')    # hide escaped apostrophes to allow capture of the full string/char
-    source_scrubbed = source_scrubbed.gsub(/("[^"\n]*")|('[^'\n]*')/) { |s| s.gsub(substring_re, substring_subs) } # temporarily hide problematic characters within strings
-    source_scrubbed = source_scrubbed.gsub(/\/\/(?:.+\/\*|\*(?:$|[^\/])).*$/, '')  # remove line comments that comment out the start of blocks
-    source_scrubbed = source_scrubbed.gsub(/\/\*.*?\*\//m, '')                     # remove block comments
-    source_scrubbed = source_scrubbed.gsub(/\/\/.*$/, '')                          # remove line comments (all that remain)
+    source_scrubbed = source.gsub(SCRUB_RE) do
+      string = Regexp.last_match(1)
+      string.nil? ? '' : string.gsub(SUBSTRING_RE, SUBSTRING_SUBS) # temporarily hide problematic characters within strings
+    end
     lines = source_scrubbed.split(/(^\s*\#.*$) | (;|\{|\}) /x)                     # Treat preprocessor directives as a logical line. Match ;, {, and } as end of lines
-                           .map { |line| line.gsub(substring_unre, substring_unsubs) } # unhide the problematic characters previously removed
+                           .map { |line| line.gsub(SUBSTRING_UNRE, SUBSTRING_UNSUBS) } # unhide the problematic characters previously removed
 
-    lines.each_with_index do |line, _index|
+    # built once, as building it for every line took most of the time of the scan
+    test_re = /^((?:\s*(?:TEST_(?:CASE|RANGE|MATRIX))\s*\(.*?\)\s*)*)\s*void\s+((?:#{@options[:test_prefix]})\w*)\s*\(\s*(.*)\s*\)/m
+
+    lines.each do |line|
       # find tests
-      next unless line =~ /^((?:\s*(?:TEST_(?:CASE|RANGE|MATRIX))\s*\(.*?\)\s*)*)\s*void\s+((?:#{@options[:test_prefix]}).*)\s*\(\s*(.*)\s*\)/m
-      next unless line =~ /^((?:\s*(?:TEST_(?:CASE|RANGE|MATRIX))\s*\(.*?\)\s*)*)\s*void\s+((?:#{@options[:test_prefix]})\w*)\s*\(\s*(.*)\s*\)/m
+      next unless line.include?('void') && line =~ test_re
 
       arguments = Regexp.last_match(1)
       name = Regexp.last_match(2)
@@ -186,17 +291,18 @@ class UnityTestRunnerGenerator
 
     tests_and_line_numbers.uniq! { |v| v[:test] }
 
-    # determine line numbers and create tests to run
-    source_lines = source.split("\n")
-    source_index = 0
-    tests_and_line_numbers.size.times do |i|
-      source_lines[source_index..].each_with_index do |line, index|
-        next unless line =~ /\s+#{tests_and_line_numbers[i][:test]}(?:\s|\()/
-
-        source_index += index
-        tests_and_line_numbers[i][:line_number] = source_index + 1
-        break
-      end
+    # determine line numbers and create tests to run: each test is looked for in
+    # the raw source from the line of the previous one, in one pass over the file
+    line_start = 0
+    line_index = 0
+    tests_and_line_numbers.each do |test|
+      found = source.index(/[ \t\r\f\v]+#{test[:test]}[ \t\r\f\v(]/, line_start)
+      next if found.nil?
+
+      found_line_start = (source.rindex("\n", found) || -1) + 1
+      line_index += source[line_start...found_line_start].count("\n")
+      line_start = found_line_start
+      test[:line_number] = line_index + 1
     end
 
     tests_and_line_numbers
@@ -234,6 +340,7 @@ class UnityTestRunnerGenerator
 
   def create_header(output, mocks, testfile_includes = [])
     output.puts('/* AUTOGENERATED FILE. DO NOT EDIT. */')
+    output.puts(@cache_stamp) if @cache_stamp
     output.puts("\n/*=======Automagically Detected Files To Include=====*/")
     output.puts('extern "C" {') if @options[:externcincludes]
     output.puts("#include \"#{@options[:framework]}.h\"")
@@ -271,6 +378,41 @@ class UnityTestRunnerGenerator
     output.puts('char* GlobalOrderError;')
   end
 
+  # The names every test file defines are renamed after the file before it is
+  # included, so that many suites can be linked together
+  def create_suite_header(output, input_file, output_file, tests)
+    output.puts('/* AUTOGENERATED FILE. DO NOT EDIT. */')
+    output.puts(@cache_stamp) if @cache_stamp
+    output.puts("\n/*=======Names Private To This Test File=====*/")
+    names = [@options[:setup_name], @options[:teardown_name], 'suiteSetUp', 'suiteTearDown',
+             @options[:test_reset_name], @options[:test_verify_name]]
+    (names + tests.map { |test| test[:test] }).uniq.each do |name|
+      output.puts("#define #{name} #{@suite}_#{name}")
+    end
+    if @options[:defines] && !@options[:defines].empty?
+      output.puts('/* injected defines for unity settings, etc */')
+      @options[:defines].each do |d|
+        def_only = d.match(/(\w+).*/)[1]
+        output.puts("#ifndef #{def_only}\n#define #{d}\n#endif /* #{def_only} */")
+      end
+    end
+
+    test_file = Pathname.new(File.expand_path(input_file)).relative_path_from(Pathname.new(File.expand_path(File.dirname(output_file))))
+    output.puts("\n/*=======Test File=====*/")
+    output.puts("#include \"#{test_file.to_s.tr('\\', '/')}\"")
+    @options[:includes].flatten.uniq.compact.each do |inc|
+      output.puts("#include #{inc.include?('<') ? inc : "\"#{inc}\""}")
+    end
+    output.puts('#include "CException.h"') if @options[:plugins].include?(:cexception)
+
+    return unless @options[:enforce_strict_ordering]
+
+    output.puts('')
+    output.puts('extern int GlobalExpectCount;')
+    output.puts('extern int GlobalVerifyOrder;')
+    output.puts('extern char* GlobalOrderError;')
+  end
+
   def create_externs(output, tests, _mocks)
     output.puts("\n/*=======External Functions This Runner Calls=====*/")
     output.puts("extern void #{@options[:setup_name]}(void);")
@@ -393,6 +535,62 @@ class UnityTestRunnerGenerator
     end
   end
 
+  # Every test the runner can run as [function, quoted name, line], parameterized tests expanded
+  def test_entries(tests)
+    tests.flat_map do |test|
+      if (!@options[:use_param_tests]) || test[:args].nil? || test[:args].empty?
+        [[test[:test], "\"#{test[:test]}\"", test[:line_number]]]
+      else
+        test[:args].each.with_index(1).map do |args, idx|
+          ["runner_args#{idx}_#{test[:test]}", "#{test[:test]}(#{args})".dump, test[:line_number]]
+        end
+      end
+    end
+  end
+
+  # Reads test durations in milliseconds from either "name ms" lines or the
+  # output of a runner built with UNITY_INCLUDE_EXEC_TIME ("file:line:name:PASS (ms)")
+  def load_shard_timings(path)
+    timings = {}
+    File.foreach(path) do |line|
+      case line
+      when /^\s*(\S+)\s+(\d+(?:\.\d+)?)\s*$/, /:\d+:(.+?):(?:PASS|FAIL|IGNORE).*\((\d+) ms\)\s*$/
+        timings[Regexp.last_match(1)] = Regexp.last_match(2).to_f
+      end
+    end
+    timings
+  end
+
+  # Position of each test from slowest to fastest, or -1 for all when no timings are given
+  def shard_ranks(names)
+    path = @options[:shard_timings]
+    return names.to_h { |name| [name, -1] } if path.nil? || path.to_s.empty?
+
+    timings = load_shard_timings(path)
+    known = names.map { |name| timings[name] }.compact
+    typical = known.empty? ? 0.0 : known.sum / known.size
+    ranked = names.sort_by { |name| [-(timings[name] || typical), name] }
+    ranked.each_with_index.to_h
+  end
+
+  def create_test_table(output, tests)
+    return unless @options[:cmdline_args] && !tests.empty?
+
+    entries = test_entries(tests)
+    ranks = shard_ranks(entries.map { |entry| entry[1].undump })
+
+    # Sorted by name so that a single test selected with -n is found by binary search
+    output.puts("\n/*=======Test Table=====*/")
+    output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
+    output.puts('static const UNITY_TEST_ENTRY_T UnityTestsByName[] =')
+    output.puts('{')
+    entries.sort_by { |entry| entry[1].undump.bytes }.each do |func, name, line|
+      output.puts("  { #{name}, #{func}, #{line}, #{ranks[name.undump]} },")
+    end
+    output.puts('};')
+    output.puts('#endif')
+  end
+
   def create_main(output, filename, tests, used_mocks)
     output.puts("\n/*=======MAIN=====*/")
     main_name = @options[:main_name].to_sym == :auto ? "main_#{filename.gsub('.c', '')}" : (@options[:main_name]).to_s
@@ -404,27 +602,20 @@ class UnityTestRunnerGenerator
       output.puts('{')
       output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
       output.puts('  int parse_status = UnityParseOptions(argc, argv);')
+      output.puts('  int test_index = -1;') unless tests.empty?
       output.puts('  if (parse_status != 0)')
       output.puts('  {')
       output.puts('    if (parse_status < 0)')
       output.puts('    {')
-      output.puts("      UnityPrint(\"#{filename.gsub('.c', '').gsub(/\\/, '\\\\\\')}.\");")
-      output.puts('      UNITY_PRINT_EOL();')
-      tests.each do |test|
-        if (!@options[:use_param_tests]) || test[:args].nil? || test[:args].empty?
-          output.puts("      UnityPrint(\"  #{test[:test]}\");")
-          output.puts('      UNITY_PRINT_EOL();')
-        else
-          test[:args].each do |args|
-            output.puts("      UnityPrint(\"  #{test[:test]}(#{args})\");")
-            output.puts('      UNITY_PRINT_EOL();')
-          end
-        end
-      end
+      create_test_list(output, filename, tests, '      ')
       output.puts('      return 0;')
       output.puts('    }')
       output.puts('    return parse_status;')
       output.puts('  }')
+      unless tests.empty?
+        output.puts("  UnitySetTestTable(UnityTestsByName, #{test_entries(tests).size});")
+        output.puts("  test_index = UnityFindTestByName(UnityTestsByName, #{test_entries(tests).size});")
+      end
       output.puts('#endif')
     else
       main_return = @options[:omit_begin_end] ? 'void' : 'int'
@@ -440,17 +631,7 @@ class UnityTestRunnerGenerator
     else
       output.puts("  UnityBegin(\"#{filename.gsub(/\\/, '\\\\\\')}\");")
     end
-    tests.each do |test|
-      if (!@options[:use_param_tests]) || test[:args].nil? || test[:args].empty?
-        output.puts("  run_test(#{test[:test]}, \"#{test[:test]}\", #{test[:line_number]});")
-      else
-        test[:args].each.with_index(1) do |args, idx|
-          wrapper = "runner_args#{idx}_#{test[:test]}"
-          testname = "#{test[:test]}(#{args})".dump
-          output.puts("  run_test(#{wrapper}, #{testname}, #{test[:line_number]});")
-        end
-      end
-    end
+    create_test_calls(output, tests)
     output.puts
     output.puts('  CMock_Guts_MemFreeFinal();') unless used_mocks.empty?
     if @options[:has_suite_teardown]
@@ -465,6 +646,149 @@ class UnityTestRunnerGenerator
     output.puts('}')
   end
 
+  def create_test_list(output, filename, tests, indent)
+    output.puts("#{indent}UnityPrint(\"#{filename.gsub('.c', '').gsub(/\\/, '\\\\\\')}.\");")
+    output.puts("#{indent}UNITY_PRINT_EOL();")
+    tests.each do |test|
+      if (!@options[:use_param_tests]) || test[:args].nil? || test[:args].empty?
+        output.puts("#{indent}UnityPrint(\"  #{test[:test]}\");")
+        output.puts("#{indent}UNITY_PRINT_EOL();")
+      else
+        test[:args].each do |args|
+          output.puts("#{indent}UnityPrint(\"  #{test[:test]}(#{args})\");")
+          output.puts("#{indent}UNITY_PRINT_EOL();")
+        end
+      end
+    end
+  end
+
+  def create_test_calls(output, tests)
+    if @options[:cmdline_args] && !tests.empty?
+      output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
+      output.puts('  if (test_index >= 0)')
+      output.puts('  {')
+      output.puts('    run_test(UnityTestsByName[test_index].Func, UnityTestsByName[test_index].Name, UnityTestsByName[test_index].Line);')
+      output.puts('  }')
+      output.puts('  else')
+      output.puts('#endif')
+      output.puts('  {')
+      test_entries(tests).each do |func, name, line|
+        output.puts("    run_test(#{func}, #{name}, #{line});")
+      end
+      output.puts('  }')
+    else
+      test_entries(tests).each do |func, name, line|
+        output.puts("  run_test(#{func}, #{name}, #{line});")
+      end
+    end
+  end
+
+  # A suite runs the tests of one file inside the run of an aggregated runner
+  def create_suite_main(output, filename, tests, used_mocks)
+    quoted_file = filename.gsub(/\\/, '\\\\\\')
+    output.puts("\n/*=======Suite=====*/")
+    if @options[:cmdline_args]
+      output.puts("void list_suite_#{@suite}(void);")
+      output.puts("void list_suite_#{@suite}(void)")
+      output.puts('{')
+      output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
+      output.puts("  if (UnityFileMatches(\"#{quoted_file}\"))")
+      output.puts('  {')
+      create_test_list(output, filename, tests, '    ')
+      output.puts('  }')
+      output.puts('#endif')
+      output.puts('}')
+    end
+    output.puts("int run_suite_#{@suite}(void);")
+    output.puts("int run_suite_#{@suite}(void)")
+    output.puts('{')
+    output.puts('  UNITY_COUNTER_TYPE failures_before = Unity.TestFailures;') if @options[:has_suite_teardown]
+    output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
+    output.puts('  int test_index = -1;') if @options[:cmdline_args] && !tests.empty?
+    output.puts("  if (!UnityFileMatches(\"#{quoted_file}\"))")
+    output.puts('  {')
+    output.puts('    return 0;')
+    output.puts('  }')
+    if @options[:cmdline_args] && !tests.empty?
+      output.puts("  UnitySetTestTable(UnityTestsByName, #{test_entries(tests).size});")
+      output.puts("  test_index = UnityFindTestByName(UnityTestsByName, #{test_entries(tests).size});")
+    end
+    output.puts('#endif')
+    output.puts("  UnitySetTestFile(\"#{quoted_file}\");")
+    output.puts('  suiteSetUp();') if @options[:has_suite_setup]
+    create_test_calls(output, tests)
+    output.puts
+    output.puts('  CMock_Guts_MemFreeFinal();') unless used_mocks.empty?
+    if @options[:has_suite_teardown]
+      output.puts('  return suiteTearDown((int)(Unity.TestFailures - failures_before));')
+    else
+      output.puts('  return 0;')
+    end
+    output.puts('}')
+  end
+
+  def create_aggregate_main(output, filename, suites)
+    output.puts('/* AUTOGENERATED FILE. DO NOT EDIT. */')
+    output.puts("\n/*=======Automagically Detected Files To Include=====*/")
+    output.puts("#include \"#{@options[:framework]}.h\"")
+    if @options[:enforce_strict_ordering]
+      output.puts('')
+      output.puts('int GlobalExpectCount;')
+      output.puts('int GlobalVerifyOrder;')
+      output.puts('char* GlobalOrderError;')
+    end
+
+    # Every setUp and tearDown was renamed, but unity.c still refers to them
+    # from UnityDefaultTestRun unless it is built with UNITY_SKIP_DEFAULT_RUNNER
+    output.puts("\n/*=======Setup and Teardown (stubs)=====*/")
+    output.puts('#ifndef UNITY_SKIP_DEFAULT_RUNNER')
+    output.puts("void #{@options[:setup_name]}(void) {}")
+    output.puts("void #{@options[:teardown_name]}(void) {}")
+    output.puts('#endif')
+
+    output.puts("\n/*=======Suites This Runner Calls=====*/")
+    suites.each do |suite|
+      output.puts("extern void list_suite_#{suite}(void);") if @options[:cmdline_args]
+      output.puts("extern int run_suite_#{suite}(void);")
+    end
+
+    output.puts("\n/*=======MAIN=====*/")
+    main_name = @options[:main_name].to_sym == :auto ? "main_#{File.basename(filename, '.*')}" : @options[:main_name].to_s
+    if @options[:cmdline_args]
+      output.puts("#{@options[:main_export_decl]} int #{main_name}(int argc, char** argv);") if main_name != 'main'
+      output.puts("#{@options[:main_export_decl]} int #{main_name}(int argc, char** argv)")
+    else
+      output.puts("#{@options[:main_export_decl]} int #{main_name}(void);") if main_name != 'main'
+      output.puts("int #{main_name}(void)")
+    end
+    output.puts('{')
+    output.puts('  int suite_status = 0;')
+    output.puts('  int failures;')
+    if @options[:cmdline_args]
+      output.puts('#ifdef UNITY_USE_COMMAND_LINE_ARGS')
+      output.puts('  int parse_status = UnityParseOptions(argc, argv);')
+      output.puts('  if (parse_status != 0)')
+      output.puts('  {')
+      output.puts('    if (parse_status < 0)')
+      output.puts('    {')
+      suites.each do |suite|
+        output.puts("      list_suite_#{suite}();")
+      end
+      output.puts('      return 0;')
+      output.puts('    }')
+      output.puts('    return parse_status;')
+      output.puts('  }')
+      output.puts('#endif')
+    end
+    output.puts("  UnityBegin(\"#{filename.gsub(/\\/, '\\\\\\')}\");")
+    suites.each do |suite|
+      output.puts("  suite_status |= run_suite_#{suite}();")
+    end
+    output.puts('  failures = UNITY_END();')
+    output.puts('  return (failures != 0) ? failures : suite_status;')
+    output.puts('}')
+  end
+
   def create_h_file(output, filename, tests, testfile_includes, used_mocks)
     filename = File.basename(filename).gsub(/[-\/\\.,\s]/, '_').upcase
     output.puts('/* AUTOGENERATED FILE. DO NOT EDIT. */')
@@ -492,6 +816,7 @@ end
 
 if $0 == __FILE__
   options = { includes: [] }
+  batch = false
 
   # parse out all the options first (these will all be removed as we go)
   ARGV.reject! do |arg|
@@ -502,6 +827,9 @@ if $0 == __FILE__
     when '-externcincludes'
       options[:externcincludes] = true
       true
+    when '-batch'
+      batch = true
+      true
     when /\.*\.ya?ml$/
       options = UnityTestRunnerGenerator.grab_config(arg)
       true
@@ -537,10 +865,27 @@ if $0 == __FILE__
           '    --suite_teardown=""   - code to execute for teardown of entire suite',
           '    --use_param_tests=1   - enable parameterized tests (disabled by default)',
           '    --omit_begin_end=1    - omit calls to UnityBegin and UNITY_END (disabled by default)',
-          '    --header_file=""      - path/name of test header file to generate too'].join("\n")
+          '    --header_file=""      - path/name of test header file to generate too',
+          '    --shard_timings=""    - test durations from a previous run to balance --shard',
+          '    --cache_runners=1     - skip runners already generated from the same file and options',
+          '    -batch                - generate a runner for each input_test_file given, in one process',
+          '    --runner_dir=""       - with -batch, put the runners here instead of next to the tests',
+          '    --aggregate=""        - generate this one runner for every input_test_file given'].join("\n")
     exit 1
   end
 
+  aggregate = options.delete(:aggregate)
+  if aggregate
+    UnityTestRunnerGenerator.new(options).run_aggregate(ARGV, aggregate)
+    exit 0
+  end
+
+  if batch
+    runner_dir = options.delete(:runner_dir)
+    UnityTestRunnerGenerator.run_batch(options, ARGV, runner_dir)
+    exit 0
+  end
+
   # create the default test runner name if not specified
   ARGV[1] = ARGV[0].gsub('.c', '_Runner.c') unless ARGV[1]
 
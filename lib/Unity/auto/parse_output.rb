@@ -22,17 +22,31 @@
 #    - fixture output with verbose flag set ("-v")
 #    - time output flag set (UNITY_INCLUDE_EXEC_TIME define enabled with milliseconds output)
 #
+#    The file is read one line at a time and the XML report is written as
+#    the results come in, so logs of any size are parsed in bounded memory.
+#    Every "N Tests N Failures N Ignored" summary line closes a test suite,
+#    so a log holding several runs (e.g. repeated or sharded executables)
+#    becomes one <testsuite> per run inside a <testsuites> element.
+#
 #    To use this parser use the following command
 #    ruby parseOutput.rb [options] [file]
 #        options: -xml  : produce a JUnit compatible XML file
 #                 -suiteRequiredSuiteName
 #                       : replace default test suite name to
 #                           "RequiredSuiteName" (can be any name)
+#                 -quiet: print only the summary, not every test
 #           file: file to scan for results
 #============================================================
 
+require 'tempfile'
+
 # Parser class for handling the input file
 class ParseOutput
+  SUITE_END = /^\s*\d+ Tests \d+ Failures \d+ Ignored/.freeze
+  XML_SPECIAL = /[&<>"']/.freeze
+  PLAIN_PASS = /\A([^:\\]*):\d+:([^:\\]+):PASS(?: \((\d+) ms\))?\r?\n?\z/.freeze
+  TEST_TIME = /\((-?\d+.?\d*) ms\)\s*$/.freeze
+
   def initialize
     # internal data
     @class_name_idx = 0
@@ -41,17 +55,26 @@ class ParseOutput
 
     # xml output related
     @xml_out = false
-    @array_list = false
+    @xml_file_name = 'report.xml'
+    @xml_file = nil
+    @suite_cases = nil
+    @xml_times = {}
+    @quiet = false
 
     # current suite name and statistics
     ## testsuite name
     @real_test_suite_name = 'Unity'
     ## classname for testcase
     @test_suite = nil
+    @test_suite_path = nil
+    @test_suite_xml = nil
     @total_tests = 0
     @test_passed = 0
     @test_failed = 0
     @test_ignored = 0
+
+    # statistics when the suite being written began
+    @suite_start = [0, 0, 0]
   end
 
   # Set the flag to indicate if there will be an XML output file or not
@@ -59,6 +82,16 @@ class ParseOutput
     @xml_out = true
   end
 
+  # Set the name of the XML file, report.xml by default
+  def xml_file_name=(file_name)
+    @xml_file_name = file_name
+  end
+
+  # Set the flag to print only the summary
+  def set_quiet
+    @quiet = true
+  end
+
   # Set the flag to indicate if there will be an XML output file or not
   def test_suite_name=(cli_arg)
     @real_test_suite_name = cli_arg
@@ -66,49 +99,95 @@ class ParseOutput
   end
 
   def xml_encode_s(str)
+    # Names rarely need escaping, and checking is much cheaper than encoding
+    return "\"#{str}\"" unless XML_SPECIAL.match?(str)
+
     str.encode(:xml => :attr)
   end
 
-  # If write our output to XML
-  def write_xml_output
-    output = File.open('report.xml', 'w')
-    output << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
-    @array_list.each do |item|
-      output << item << "\n"
+  def xml_encode_text(str)
+    str.encode(:xml => :text)
+  end
+
+  # Opens the XML file. The suites are written into it as they end
+  def open_xml_output
+    @xml_file = File.open(@xml_file_name, 'wb')
+    @xml_file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    @xml_file << "<testsuites>\n"
+  end
+
+  # Closes the last suite and the XML file
+  def close_xml_output
+    end_xml_output_suite
+    @xml_file << "</testsuites>\n"
+    @xml_file.close
+    @xml_file = nil
+  end
+
+  # The totals of a suite are only known at its end, but belong in its opening
+  # tag. Its test cases are therefore kept in a temporary file until then.
+  def push_xml_output(line)
+    if @suite_cases.nil?
+      # The first test of a suite is pushed before it is counted
+      @suite_start = [@test_passed, @test_failed, @test_ignored]
+      @suite_cases = Tempfile.create('unity_suite', binmode: true)
     end
+    @suite_cases.write(line, "\n")
   end
 
-  # Pushes the suite info as xml to the array list, which will be written later
-  def push_xml_output_suite_info
-    # Insert opening tag at front
-    heading = "<testsuite name=#{xml_encode_s(@real_test_suite_name)} tests=\"#{@total_tests}\" failures=\"#{@test_failed}\" skips=\"#{@test_ignored}\">"
-    @array_list.insert(0, heading)
-    # Push back the closing tag
-    @array_list.push '</testsuite>'
+  # Test times repeat a lot, so the attributes of the first ones seen are kept
+  def xml_time(execution_time)
+    time = @xml_times[execution_time]
+    return time unless time.nil?
+
+    time = xml_encode_s((execution_time / 1000.0).to_s)
+    @xml_times[execution_time] = time if @xml_times.size < 1024
+    time
   end
 
-  # Pushes xml output data to the array list, which will be written later
+  # Writes the suite info and its test cases to the XML file
+  def end_xml_output_suite
+    return if @suite_cases.nil?
+
+    failed = @test_failed - @suite_start[1]
+    ignored = @test_ignored - @suite_start[2]
+    tests = @test_passed - @suite_start[0] + failed + ignored
+    @xml_file << "  <testsuite name=#{xml_encode_s(@real_test_suite_name)} tests=\"#{tests}\" failures=\"#{failed}\" skips=\"#{ignored}\">\n"
+    @suite_cases.rewind
+    IO.copy_stream(@suite_cases, @xml_file)
+    @suite_cases.close
+    File.unlink(@suite_cases.path)
+    @suite_cases = nil
+    @xml_file << "  </testsuite>\n"
+  end
+
+  # Pushes xml output data for a passed test
   def push_xml_output_passed(test_name, execution_time = 0)
-    @array_list.push "    <testcase classname=#{xml_encode_s(@test_suite)} name=#{xml_encode_s(test_name)} time=#{xml_encode_s((execution_time / 1000.0).to_s)} />"
+    push_xml_output "    <testcase classname=#{@test_suite_xml} name=#{xml_encode_s(test_name)} time=#{xml_time(execution_time)} />"
   end
 
-  # Pushes xml output data to the array list, which will be written later
+  # Pushes xml output data for a failed test
   def push_xml_output_failed(test_name, reason, execution_time = 0)
-    @array_list.push "    <testcase classname=#{xml_encode_s(@test_suite)} name=#{xml_encode_s(test_name)} time=#{xml_encode_s((execution_time / 1000.0).to_s)} >"
-    @array_list.push "        <failure type=\"ASSERT FAILED\">#{reason}</failure>"
-    @array_list.push '    </testcase>'
+    push_xml_output "    <testcase classname=#{@test_suite_xml} name=#{xml_encode_s(test_name)} time=#{xml_time(execution_time)} >"
+    push_xml_output "        <failure type=\"ASSERT FAILED\">#{xml_encode_text(reason)}</failure>"
+    push_xml_output '    </testcase>'
   end
 
-  # Pushes xml output data to the array list, which will be written later
+  # Pushes xml output data for an ignored test
   def push_xml_output_ignored(test_name, reason, execution_time = 0)
-    @array_list.push "    <testcase classname=#{xml_encode_s(@test_suite)} name=#{xml_encode_s(test_name)} time=#{xml_encode_s((execution_time / 1000.0).to_s)} >"
-    @array_list.push "        <skipped type=\"TEST IGNORED\">#{reason}</skipped>"
-    @array_list.push '    </testcase>'
+    push_xml_output "    <testcase classname=#{@test_suite_xml} name=#{xml_encode_s(test_name)} time=#{xml_time(execution_time)} >"
+    push_xml_output "        <skipped type=\"TEST IGNORED\">#{xml_encode_text(reason)}</skipped>"
+    push_xml_output '    </testcase>'
   end
 
   # This function will try and determine when the suite is changed. This is
   # is the name that gets added to the classname parameter.
   def test_suite_verify(test_suite_name)
+    # Consecutive results nearly always come from the same file
+    return if test_suite_name == @test_suite_path
+
+    @test_suite_path = test_suite_name
+
     # Split the path name
     test_name = test_suite_name.split(@path_delim)
 
@@ -119,7 +198,13 @@ class ParseOutput
     return unless base_name.to_s != @test_suite.to_s
 
     @test_suite = base_name
-    printf "New Test: %s\n", @test_suite
+    @test_suite_xml = xml_encode_s(@test_suite.to_s)
+    report "New Test: %s\n", @test_suite
+  end
+
+  # Prints the result of a test unless quiet
+  def report(format, *args)
+    printf(format, *args) unless @quiet
   end
 
   # Prepares the line for verbose fixture output ("-v")
@@ -138,7 +223,7 @@ class ParseOutput
     class_name = array[0]
     test_name  = array[1]
     test_suite_verify(class_name)
-    printf "%-40s PASS\n", test_name
+    report "%-40s PASS\n", test_name
 
     push_xml_output_passed(test_name) if @xml_out
   end
@@ -152,7 +237,7 @@ class ParseOutput
     reason_array = array[2].split(':')
     reason = "#{reason_array[-1].lstrip.chomp} at line: #{reason_array[-4]}"
 
-    printf "%-40s FAILED\n", test_name
+    report "%-40s FAILED\n", test_name
 
     push_xml_output_failed(test_name, reason) if @xml_out
   end
@@ -169,7 +254,7 @@ class ParseOutput
       reason = tmp_reason == 'IGNORE' ? 'No reason given' : tmp_reason
     end
     test_suite_verify(class_name)
-    printf "%-40s IGNORED\n", test_name
+    report "%-40s IGNORED\n", test_name
 
     push_xml_output_ignored(test_name, reason) if @xml_out
   end
@@ -177,16 +262,10 @@ class ParseOutput
   # Test was flagged as having passed so format the output
   def test_passed(array)
     # ':' symbol will be valid in function args now
-    real_method_name = array[@result_usual_idx - 1..-2].join(':')
-    array = array[0..@result_usual_idx - 2] + [real_method_name] + [array[-1]]
-
-    last_item = array.length - 1
-    test_time = get_test_time(array[last_item])
-    test_name = array[last_item - 1]
+    test_name = array[@result_usual_idx - 1..-2].join(':')
+    test_time = get_test_time(array[-1])
     test_suite_verify(array[@class_name_idx])
-    printf "%-40s PASS %10d ms\n", test_name, test_time
-
-    return unless @xml_out
+    report "%-40s PASS %10d ms\n", test_name, test_time
 
     push_xml_output_passed(test_name, test_time) if @xml_out
   end
@@ -214,7 +293,7 @@ class ParseOutput
     end
 
     test_suite_verify(class_name)
-    printf "%-40s FAILED %10d ms\n", test_name, test_time
+    report "%-40s FAILED %10d ms\n", test_name, test_time
 
     push_xml_output_failed(test_name, reason, test_time) if @xml_out
   end
@@ -242,18 +321,17 @@ class ParseOutput
     end
 
     test_suite_verify(class_name)
-    printf "%-40s IGNORED %10d ms\n", test_name, test_time
+    report "%-40s IGNORED %10d ms\n", test_name, test_time
 
     push_xml_output_ignored(test_name, reason, test_time) if @xml_out
   end
 
   # Test time will be in ms
   def get_test_time(value_with_time)
-    test_time_array = value_with_time.scan(/\((-?\d+.?\d*) ms\)\s*$/).flatten.map do |arg_value_str|
-      arg_value_str.include?('.') ? arg_value_str.to_f : arg_value_str.to_i
-    end
+    match = TEST_TIME.match(value_with_time.to_s)
+    return 0 if match.nil?
 
-    test_time_array.any? ? test_time_array[0] : 0
+    match[1].include?('.') ? match[1].to_f : match[1].to_i
   end
 
   # Adjusts the os specific members according to the current path style
@@ -272,118 +350,144 @@ class ParseOutput
 
   # Main function used to parse the file that was captured.
   def process(file_name)
-    @array_list = []
-
     puts "Parsing file: #{file_name}"
 
     @test_passed = 0
     @test_failed = 0
     @test_ignored = 0
+    @total_tests = 0
+    open_xml_output if @xml_out
     puts ''
     puts '=================== RESULTS ====================='
     puts ''
     # Apply binary encoding. Bad symbols will be unchanged
-    File.open(file_name, 'rb').each do |line|
-      # Typical test lines look like these:
-      # ----------------------------------------------------
-      # 1. normal output:
-      # <path>/<test_file>.c:36:test_tc1000_opsys:FAIL: Expected 1 Was 0
-      # <path>/<test_file>.c:112:test_tc5004_initCanChannel:IGNORE: Not Yet Implemented
-      # <path>/<test_file>.c:115:test_tc5100_initCanVoidPtrs:PASS
-      #
-      # 2. fixture output
-      # <path>/<test_file>.c:63:TEST(<test_group>, <test_function>):FAIL: Expected 0x00001234 Was 0x00005A5A
-      # <path>/<test_file>.c:36:TEST(<test_group>, <test_function>):IGNORE
-      # Note: "PASS" information won't be generated in this mode
-      #
-      # 3. fixture output with verbose information ("-v")
-      # TEST(<test_group, <test_file>)<path>/<test_file>:168::FAIL: Expected 0x8D Was 0x8C
-      # TEST(<test_group>, <test_file>)<path>/<test_file>:22::IGNORE: This Test Was Ignored On Purpose
-      # IGNORE_TEST(<test_group, <test_file>)
-      # TEST(<test_group, <test_file>) PASS
-      #
-      # Note: Where path is different on Unix vs Windows devices (Windows leads with a drive letter)!
-      detect_os_specifics(line)
-      line_array = line.split(':')
-
-      # If we were able to split the line then we can look to see if any of our target words
-      # were found. Case is important.
-      next unless (line_array.size >= 4) || (line.start_with? 'TEST(') || (line.start_with? 'IGNORE_TEST(')
-
-      # check if the output is fixture output (with verbose flag "-v")
-      if (line.start_with? 'TEST(') || (line.start_with? 'IGNORE_TEST(')
-        line_array = prepare_fixture_line(line)
-        if line.include? ' PASS'
-          test_passed_unity_fixture(line_array)
-          @test_passed += 1
-        elsif line.include? 'FAIL'
-          test_failed_unity_fixture(line_array)
-          @test_failed += 1
-        elsif line.include? 'IGNORE'
-          test_ignored_unity_fixture(line_array)
-          @test_ignored += 1
-        end
-      # normal output / fixture output (without verbose "-v")
-      elsif line.include? ':PASS'
+    File.open(file_name, 'rb') do |file|
+      file.each_line { |line| process_line(line) }
+    end
+    puts ''
+    puts '=================== SUMMARY ====================='
+    puts ''
+    puts "Tests Passed  : #{@test_passed}"
+    puts "Tests Failed  : #{@test_failed}"
+    puts "Tests Ignored : #{@test_ignored}"
+
+    close_xml_output if @xml_out
+  end
+
+  # Parses one line of the captured file
+  def process_line(line)
+    # Typical test lines look like these:
+    # ----------------------------------------------------
+    # 1. normal output:
+    # <path>/<test_file>.c:36:test_tc1000_opsys:FAIL: Expected 1 Was 0
+    # <path>/<test_file>.c:112:test_tc5004_initCanChannel:IGNORE: Not Yet Implemented
+    # <path>/<test_file>.c:115:test_tc5100_initCanVoidPtrs:PASS
+    #
+    # 2. fixture output
+    # <path>/<test_file>.c:63:TEST(<test_group>, <test_function>):FAIL: Expected 0x00001234 Was 0x00005A5A
+    # <path>/<test_file>.c:36:TEST(<test_group>, <test_function>):IGNORE
+    # Note: "PASS" information won't be generated in this mode
+    #
+    # 3. fixture output with verbose information ("-v")
+    # TEST(<test_group, <test_file>)<path>/<test_file>:168::FAIL: Expected 0x8D Was 0x8C
+    # TEST(<test_group>, <test_file>)<path>/<test_file>:22::IGNORE: This Test Was Ignored On Purpose
+    # IGNORE_TEST(<test_group, <test_file>)
+    # TEST(<test_group, <test_file>) PASS
+    #
+    # Note: Where path is different on Unix vs Windows devices (Windows leads with a drive letter)!
+    # Most lines of a long log are not results, so reject them before splitting.
+    # A result has at least three ':', which the suite summary line has not.
+    unless (line.count(':') >= 3) || (line.start_with? 'TEST(') || (line.start_with? 'IGNORE_TEST(')
+      end_xml_output_suite if @xml_out && SUITE_END.match?(line)
+      return
+    end
+
+    # Plain passing tests make up most of a long log. Matching them whole is
+    # several times faster than the general handling below, with the same result.
+    pass = PLAIN_PASS.match(line)
+    unless pass.nil?
+      @path_delim = '/'
+      @class_name_idx = 0
+      test_time = pass[3].to_i
+      test_suite_verify(pass[1])
+      report "%-40s PASS %10d ms\n", pass[2], test_time
+      push_xml_output_passed(pass[2], test_time) if @xml_out
+      @test_passed += 1
+      @total_tests += 1
+      return
+    end
+
+    detect_os_specifics(line)
+    line_array = line.split(':')
+
+    # If we were able to split the line then we can look to see if any of our target words
+    # were found. Case is important.
+    return unless (line_array.size >= 4) || (line.start_with? 'TEST(') || (line.start_with? 'IGNORE_TEST(')
+
+    # check if the output is fixture output (with verbose flag "-v")
+    if (line.start_with? 'TEST(') || (line.start_with? 'IGNORE_TEST(')
+      line_array = prepare_fixture_line(line)
+      if line.include? ' PASS'
+        test_passed_unity_fixture(line_array)
+        @test_passed += 1
+      elsif line.include? 'FAIL'
+        test_failed_unity_fixture(line_array)
+        @test_failed += 1
+      elsif line.include? 'IGNORE'
+        test_ignored_unity_fixture(line_array)
+        @test_ignored += 1
+      end
+    # normal output / fixture output (without verbose "-v")
+    elsif line.include? ':PASS'
+      test_passed(line_array)
+      @test_passed += 1
+    elsif line.include? ':FAIL'
+      test_failed(line_array)
+      @test_failed += 1
+    elsif line.include? ':IGNORE:'
+      test_ignored(line_array)
+      @test_ignored += 1
+    elsif line.include? ':IGNORE'
+      line_array.push('No reason given')
+      test_ignored(line_array)
+      @test_ignored += 1
+    elsif line_array.size >= 4
+      # We will check output from color compilation
+      if line_array[@result_usual_idx..].any? { |l| l.include? 'PASS' }
         test_passed(line_array)
         @test_passed += 1
-      elsif line.include? ':FAIL'
+      elsif line_array[@result_usual_idx..].any? { |l| l.include? 'FAIL' }
         test_failed(line_array)
         @test_failed += 1
-      elsif line.include? ':IGNORE:'
+      elsif line_array[@result_usual_idx..-2].any? { |l| l.include? 'IGNORE' }
         test_ignored(line_array)
         @test_ignored += 1
-      elsif line.include? ':IGNORE'
-        line_array.push('No reason given')
+      elsif line_array[@result_usual_idx..].any? { |l| l.include? 'IGNORE' }
+        line_array.push("No reason given (#{get_test_time(line_array[@result_usual_idx..])} ms)")
         test_ignored(line_array)
         @test_ignored += 1
-      elsif line_array.size >= 4
-        # We will check output from color compilation
-        if line_array[@result_usual_idx..].any? { |l| l.include? 'PASS' }
-          test_passed(line_array)
-          @test_passed += 1
-        elsif line_array[@result_usual_idx..].any? { |l| l.include? 'FAIL' }
-          test_failed(line_array)
-          @test_failed += 1
-        elsif line_array[@result_usual_idx..-2].any? { |l| l.include? 'IGNORE' }
-          test_ignored(line_array)
-          @test_ignored += 1
-        elsif line_array[@result_usual_idx..].any? { |l| l.include? 'IGNORE' }
-          line_array.push("No reason given (#{get_test_time(line_array[@result_usual_idx..])} ms)")
-          test_ignored(line_array)
-          @test_ignored += 1
-        end
       end
-      @total_tests = @test_passed + @test_failed + @test_ignored
     end
-    puts ''
-    puts '=================== SUMMARY ====================='
-    puts ''
-    puts "Tests Passed  : #{@test_passed}"
-    puts "Tests Failed  : #{@test_failed}"
-    puts "Tests Ignored : #{@test_ignored}"
-
-    return unless @xml_out
-
-    # push information about the suite
-    push_xml_output_suite_info
-    # write xml output file
-    write_xml_output
+    @total_tests = @test_passed + @test_failed + @test_ignored
   end
 end
 
-# If the command line has no values in, used a default value of Output.txt
-parse_my_file = ParseOutput.new
-
-if ARGV.size >= 1
-  ARGV.each do |arg|
-    if arg == '-xml'
-      parse_my_file.set_xml_output
-    elsif arg.start_with?('-suite')
-      parse_my_file.test_suite_name = arg.delete_prefix('-suite')
-    else
-      parse_my_file.process(arg)
-      break
+if $0 == __FILE__
+  # If the command line has no values in, used a default value of Output.txt
+  parse_my_file = ParseOutput.new
+
+  if ARGV.size >= 1
+    ARGV.each do |arg|
+      if arg == '-xml'
+        parse_my_file.set_xml_output
+      elsif arg == '-quiet'
+        parse_my_file.set_quiet
+      elsif arg.start_with?('-suite')
+        parse_my_file.test_suite_name = arg.delete_prefix('-suite')
+      else
+        parse_my_file.process(arg)
+        break
+      end
     end
   end
 end
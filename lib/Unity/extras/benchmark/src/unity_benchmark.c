@@ -0,0 +1,475 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_benchmark.h"
+#include <string.h>
+
+#ifndef UNITY_BENCHMARK_EXCLUDE_FILE_IO
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+/* Define UNITY_BENCHMARK_CLOCK_NS as the name of a function returning a
+ * monotonic timestamp in nanoseconds to replace UnityClockNs. */
+#ifdef UNITY_BENCHMARK_CLOCK_NS
+double UNITY_BENCHMARK_CLOCK_NS(void);
+#define UnityBenchmarkClockNs() UNITY_BENCHMARK_CLOCK_NS()
+#else
+#define UnityBenchmarkClockNs() UnityClockNs()
+#endif
+
+#define BENCH_CALIBRATING 0
+#define BENCH_SAMPLING    1
+#define BENCH_DONE        2
+
+#define BENCH_MESSAGE_LENGTH (160 + (2 * UNITY_BENCHMARK_NAME_LENGTH))
+
+volatile UNITY_UINT UnityBenchmarkSink;
+
+static struct
+{
+    const char* Name;
+    UNITY_LINE_TYPE Line;
+    int State;
+    UNITY_UINT32 Iterations;
+    UNITY_UINT32 Count;
+    double Start;
+    double Samples[UNITY_BENCHMARK_SAMPLES];
+} Bench;
+
+static UNITY_BENCHMARK_RESULT_T results[UNITY_BENCHMARK_MAX_RESULTS];
+static int resultPending[UNITY_BENCHMARK_MAX_RESULTS];
+static int resultCount = 0;
+static int lastResult = -1;
+
+static char baselineNames[UNITY_BENCHMARK_MAX_RESULTS][UNITY_BENCHMARK_NAME_LENGTH];
+static double baselineNs[UNITY_BENCHMARK_MAX_RESULTS];
+static int baselineCount = 0;
+
+static char message[BENCH_MESSAGE_LENGTH];
+static size_t messageLength;
+
+/*-------------------------------------------------------- */
+/* Small helpers */
+
+static void BenchCopyName(char* dest, const char* src)
+{
+    strncpy(dest, src, UNITY_BENCHMARK_NAME_LENGTH - 1);
+    dest[UNITY_BENCHMARK_NAME_LENGTH - 1] = '\0';
+}
+
+static UNITY_UINT BenchTenths(double ns)
+{
+    return (ns > 0.0) ? (UNITY_UINT)((ns * 10.0) + 0.5) : 0;
+}
+
+static void BenchPrintNs(double ns)
+{
+    UNITY_UINT tenths = BenchTenths(ns);
+    UnityPrintNumberUnsigned(tenths / 10);
+    UnityPrint(".");
+    UnityPrintNumberUnsigned(tenths % 10);
+}
+
+static void MessageAppend(const char* str)
+{
+    while ((*str != '\0') && (messageLength < (BENCH_MESSAGE_LENGTH - 1)))
+        message[messageLength++] = *str++;
+    message[messageLength] = '\0';
+}
+
+static void MessageAppendUnsigned(UNITY_UINT number)
+{
+    char digits[24];
+    int i = (int)sizeof(digits) - 1;
+    digits[i] = '\0';
+    do
+    {
+        digits[--i] = (char)('0' + (number % 10));
+        number /= 10;
+    } while ((number > 0) && (i > 0));
+    MessageAppend(&digits[i]);
+}
+
+static void MessageAppendNs(double ns)
+{
+    UNITY_UINT tenths = BenchTenths(ns);
+    MessageAppendUnsigned(tenths / 10);
+    MessageAppend(".");
+    MessageAppendUnsigned(tenths % 10);
+}
+
+static void MessageStart(const UNITY_BENCHMARK_RESULT_T* result)
+{
+    messageLength = 0;
+    message[0] = '\0';
+    MessageAppend("Benchmark '");
+    MessageAppend(result->Name);
+    MessageAppend("'");
+}
+
+static void MessageFail(const char* msg, const UNITY_LINE_TYPE line)
+{
+    if (msg != NULL)
+    {
+        MessageAppend(". ");
+        MessageAppend(msg);
+    }
+    UnityFail(message, line);
+}
+
+static int FindResult(const char* name)
+{
+    int i;
+    for (i = 0; i < resultCount; i++)
+    {
+        if (strncmp(results[i].Name, name, UNITY_BENCHMARK_NAME_LENGTH - 1) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static int FindBaseline(const char* name)
+{
+    int i;
+    for (i = 0; i < baselineCount; i++)
+    {
+        if (strncmp(baselineNames[i], name, UNITY_BENCHMARK_NAME_LENGTH - 1) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*-------------------------------------------------------- */
+/* Measurement */
+
+void UnityBenchmarkBegin(const char* name, const UNITY_LINE_TYPE line)
+{
+    Bench.Name = (name != NULL) ? name : Unity.CurrentTestName;
+    if (Bench.Name == NULL)
+        Bench.Name = "benchmark";
+    Bench.Line = line;
+    Bench.State = BENCH_CALIBRATING;
+    Bench.Iterations = 1;
+    Bench.Count = 0;
+}
+
+int UnityBenchmarkNextSample(void)
+{
+    if (Bench.State == BENCH_DONE)
+        return 0;
+    Bench.Start = UnityBenchmarkClockNs();
+    return 1;
+}
+
+UNITY_UINT32 UnityBenchmarkIterations(void)
+{
+    return Bench.Iterations;
+}
+
+void UnityBenchmarkEndSample(void)
+{
+    double elapsed = UnityBenchmarkClockNs() - Bench.Start;
+
+    if (Bench.State == BENCH_CALIBRATING)
+    {
+        /* The sample that reaches the target duration is a warm-up and is discarded */
+        if ((elapsed >= UNITY_BENCHMARK_MIN_SAMPLE_NS) ||
+            (Bench.Iterations >= (UNITY_UINT32)UNITY_BENCHMARK_MAX_ITERATIONS))
+        {
+            Bench.State = BENCH_SAMPLING;
+        }
+        else
+        {
+            Bench.Iterations *= 2;
+        }
+    }
+    else if (Bench.State == BENCH_SAMPLING)
+    {
+        Bench.Samples[Bench.Count++] = elapsed / (double)Bench.Iterations;
+        if (Bench.Count >= UNITY_BENCHMARK_SAMPLES)
+            Bench.State = BENCH_DONE;
+    }
+}
+
+void UnityBenchmarkEnd(void)
+{
+    double sorted[UNITY_BENCHMARK_SAMPLES];
+    double sum = 0.0;
+    double variance = 0.0;
+    UNITY_BENCHMARK_RESULT_T* result;
+    UNITY_UINT32 i;
+    UNITY_UINT32 j;
+    int slot;
+
+    if (Bench.Count == 0)
+        return;
+
+    slot = FindResult(Bench.Name);
+    if (slot < 0)
+    {
+        if (resultCount >= UNITY_BENCHMARK_MAX_RESULTS)
+        {
+            UNITY_TEST_FAIL(Bench.Line, "Too many benchmarks, increase UNITY_BENCHMARK_MAX_RESULTS");
+            return;
+        }
+        slot = resultCount++;
+    }
+    result = &results[slot];
+    BenchCopyName(result->Name, Bench.Name);
+
+    /* Insertion sort is plenty for the handful of samples we take */
+    for (i = 0; i < Bench.Count; i++)
+    {
+        double value = Bench.Samples[i];
+        sum += value;
+        for (j = i; (j > 0) && (sorted[j - 1] > value); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = value;
+    }
+
+    result->Iterations = Bench.Iterations;
+    result->Samples = Bench.Count;
+    result->MeanNs = sum / (double)Bench.Count;
+    result->MinNs = sorted[0];
+    if ((Bench.Count % 2) == 0)
+        result->MedianNs = (sorted[(Bench.Count / 2) - 1] + sorted[Bench.Count / 2]) / 2.0;
+    else
+        result->MedianNs = sorted[Bench.Count / 2];
+    for (i = 0; i < Bench.Count; i++)
+    {
+        double diff = Bench.Samples[i] - result->MeanNs;
+        variance += diff * diff;
+    }
+    result->StdDevNs = (Bench.Count > 1) ? UnitySqrt(variance / (double)(Bench.Count - 1)) : 0.0;
+
+    resultPending[slot] = 1;
+    lastResult = slot;
+}
+
+const UNITY_BENCHMARK_RESULT_T* UnityBenchmarkLastResult(void)
+{
+    return (lastResult >= 0) ? &results[lastResult] : NULL;
+}
+
+const UNITY_BENCHMARK_RESULT_T* UnityBenchmarkFindResult(const char* name)
+{
+    int slot = FindResult(name);
+    return (slot >= 0) ? &results[slot] : NULL;
+}
+
+void UnityBenchmarkClearResults(void)
+{
+    resultCount = 0;
+    lastResult = -1;
+    memset(resultPending, 0, sizeof(resultPending));
+}
+
+/*-------------------------------------------------------- */
+/* Reporting */
+
+void UnityBenchmarkConcludeTest(void)
+{
+    int i;
+    int print = !Unity.CurrentTestFailed && !Unity.CurrentTestIgnored;
+
+    for (i = 0; i < resultCount; i++)
+    {
+        if (resultPending[i] && print)
+        {
+            UnityPrint(" [");
+            UnityPrint(results[i].Name);
+            UnityPrint(": median ");
+            BenchPrintNs(results[i].MedianNs);
+            UnityPrint(" ns/op, mean ");
+            BenchPrintNs(results[i].MeanNs);
+            UnityPrint(", stddev ");
+            BenchPrintNs(results[i].StdDevNs);
+            UnityPrint(", ");
+            UnityPrintNumberUnsigned(results[i].Samples);
+            UnityPrint("x");
+            UnityPrintNumberUnsigned(results[i].Iterations);
+            UnityPrint("]");
+        }
+        resultPending[i] = 0;
+    }
+}
+
+/*-------------------------------------------------------- */
+/* Baselines */
+
+int UnityBenchmarkSetBaseline(const char* name, const double median_ns)
+{
+    int slot = FindBaseline(name);
+    if (slot < 0)
+    {
+        if (baselineCount >= UNITY_BENCHMARK_MAX_RESULTS)
+            return 0;
+        slot = baselineCount++;
+        BenchCopyName(baselineNames[slot], name);
+    }
+    baselineNs[slot] = median_ns;
+    return 1;
+}
+
+void UnityBenchmarkClearBaseline(void)
+{
+    baselineCount = 0;
+}
+
+double UnityBenchmarkGetBaseline(const char* name)
+{
+    int slot = FindBaseline(name);
+    return (slot >= 0) ? baselineNs[slot] : -1.0;
+}
+
+#ifndef UNITY_BENCHMARK_EXCLUDE_FILE_IO
+int UnityBenchmarkLoadBaseline(const char* path)
+{
+    char line[UNITY_BENCHMARK_NAME_LENGTH + 64];
+    int loaded = 0;
+    FILE* file = fopen(path, "r");
+
+    if (file == NULL)
+        return -1;
+    baselineCount = 0;
+    while (fgets(line, (int)sizeof(line), file) != NULL)
+    {
+        char* value = line;
+        char* end;
+        double ns;
+
+        while ((*value != '\0') && (*value != ' ') && (*value != '\t'))
+            value++;
+        if ((value == line) || (*value == '\0'))
+            continue;
+        *value++ = '\0';
+        ns = strtod(value, &end);
+        if (end != value)
+            loaded += UnityBenchmarkSetBaseline(line, ns);
+    }
+    fclose(file);
+    return loaded;
+}
+
+int UnityBenchmarkSaveBaseline(const char* path)
+{
+    int i;
+    int saved = 0;
+    FILE* file;
+
+    /* Merge, so a filtered run does not drop baselines for tests it skipped */
+    for (i = 0; i < resultCount; i++)
+        UnityBenchmarkSetBaseline(results[i].Name, results[i].MedianNs);
+
+    file = fopen(path, "w");
+    if (file == NULL)
+        return -1;
+    for (i = 0; i < baselineCount; i++)
+    {
+        if (fprintf(file, "%s %.3f\n", baselineNames[i], baselineNs[i]) > 0)
+            saved++;
+    }
+    fclose(file);
+    return saved;
+}
+#endif
+
+/*-------------------------------------------------------- */
+/* Assertions */
+
+static const UNITY_BENCHMARK_RESULT_T* LastOrFail(const UNITY_LINE_TYPE line)
+{
+    if (lastResult < 0)
+    {
+        UNITY_TEST_FAIL(line, "No Benchmark Has Been Run");
+        return NULL;
+    }
+    return &results[lastResult];
+}
+
+void UnityAssertBenchmarkLessThan(const double threshold_ns,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE line)
+{
+    const UNITY_BENCHMARK_RESULT_T* result = LastOrFail(line);
+
+    if ((result == NULL) || (result->MedianNs < threshold_ns))
+        return;
+
+    MessageStart(result);
+    MessageAppend(" Expected Less Than ");
+    MessageAppendNs(threshold_ns);
+    MessageAppend(" ns/op Was ");
+    MessageAppendNs(result->MedianNs);
+    MessageAppend(" ns/op");
+    MessageFail(msg, line);
+}
+
+void UnityAssertBenchmarkFasterThan(const char* other,
+                                    const char* msg,
+                                    const UNITY_LINE_TYPE line)
+{
+    const UNITY_BENCHMARK_RESULT_T* result = LastOrFail(line);
+    const UNITY_BENCHMARK_RESULT_T* reference = UnityBenchmarkFindResult(other);
+
+    if (result == NULL)
+        return;
+    if (reference == NULL)
+    {
+        MessageStart(result);
+        MessageAppend(" Cannot Compare To Unknown Benchmark '");
+        MessageAppend(other);
+        MessageAppend("'");
+        MessageFail(msg, line);
+        return;
+    }
+    if (result->MedianNs < reference->MedianNs)
+        return;
+
+    MessageStart(result);
+    MessageAppend(" Expected Faster Than '");
+    MessageAppend(reference->Name);
+    MessageAppend("' (");
+    MessageAppendNs(reference->MedianNs);
+    MessageAppend(" ns/op) Was ");
+    MessageAppendNs(result->MedianNs);
+    MessageAppend(" ns/op");
+    MessageFail(msg, line);
+}
+
+void UnityAssertBenchmarkWithinBaseline(const double tolerance_percent,
+                                        const char* msg,
+                                        const UNITY_LINE_TYPE line)
+{
+    const UNITY_BENCHMARK_RESULT_T* result = LastOrFail(line);
+    double baseline;
+    double limit;
+
+    if (result == NULL)
+        return;
+
+    /* Nothing recorded yet: the first run establishes the baseline */
+    baseline = UnityBenchmarkGetBaseline(result->Name);
+    if (baseline < 0.0)
+        return;
+
+    limit = baseline * (1.0 + (tolerance_percent / 100.0));
+    if (result->MedianNs <= limit)
+        return;
+
+    MessageStart(result);
+    MessageAppend(" Expected Within ");
+    MessageAppendNs(tolerance_percent);
+    MessageAppend("% Of Baseline ");
+    MessageAppendNs(baseline);
+    MessageAppend(" ns/op Was ");
+    MessageAppendNs(result->MedianNs);
+    MessageAppend(" ns/op");
+    MessageFail(msg, line);
+}
@@ -0,0 +1,134 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#ifndef UNITY_BENCHMARK_H_
+#define UNITY_BENCHMARK_H_
+
+#include "unity.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Number of timed samples taken once the iteration count is calibrated.
+ * Mean, median and standard deviation are computed over these samples. */
+#ifndef UNITY_BENCHMARK_SAMPLES
+#define UNITY_BENCHMARK_SAMPLES 15
+#endif
+
+/* Calibration doubles the iterations per sample until one sample takes at
+ * least this long, so that clock resolution does not dominate the result. */
+#ifndef UNITY_BENCHMARK_MIN_SAMPLE_NS
+#define UNITY_BENCHMARK_MIN_SAMPLE_NS 1000000.0
+#endif
+
+#ifndef UNITY_BENCHMARK_MAX_ITERATIONS
+#define UNITY_BENCHMARK_MAX_ITERATIONS 0x40000000UL
+#endif
+
+/* Results are remembered by name for TEST_ASSERT_FASTER_THAN and for saving
+ * a baseline file at the end of the run. */
+#ifndef UNITY_BENCHMARK_MAX_RESULTS
+#define UNITY_BENCHMARK_MAX_RESULTS 32
+#endif
+
+#ifndef UNITY_BENCHMARK_NAME_LENGTH
+#define UNITY_BENCHMARK_NAME_LENGTH 48
+#endif
+
+typedef struct UNITY_BENCHMARK_RESULT_T
+{
+    char Name[UNITY_BENCHMARK_NAME_LENGTH];
+    UNITY_UINT32 Iterations; /* per sample */
+    UNITY_UINT32 Samples;
+    double MeanNs;           /* all values are nanoseconds per iteration */
+    double MedianNs;
+    double StdDevNs;
+    double MinNs;
+} UNITY_BENCHMARK_RESULT_T;
+
+/* Code under test can store a result here so the optimizer keeps it */
+extern volatile UNITY_UINT UnityBenchmarkSink;
+#define UNITY_BENCHMARK_KEEP(value) (UnityBenchmarkSink = (UNITY_UINT)(value))
+
+void UnityBenchmarkBegin(const char* name, const UNITY_LINE_TYPE line);
+int  UnityBenchmarkNextSample(void);
+UNITY_UINT32 UnityBenchmarkIterations(void);
+void UnityBenchmarkEndSample(void);
+void UnityBenchmarkEnd(void);
+
+const UNITY_BENCHMARK_RESULT_T* UnityBenchmarkLastResult(void);
+const UNITY_BENCHMARK_RESULT_T* UnityBenchmarkFindResult(const char* name);
+void UnityBenchmarkClearResults(void);
+
+/* Baseline files hold one "name median_ns" pair per line */
+#ifndef UNITY_BENCHMARK_EXCLUDE_FILE_IO
+int UnityBenchmarkLoadBaseline(const char* path);
+int UnityBenchmarkSaveBaseline(const char* path);
+#endif
+int UnityBenchmarkSetBaseline(const char* name, const double median_ns);
+double UnityBenchmarkGetBaseline(const char* name);
+void UnityBenchmarkClearBaseline(void);
+
+/* Called from UnityConcludeTest when built with UNITY_INCLUDE_BENCHMARK */
+void UnityBenchmarkConcludeTest(void);
+
+void UnityAssertBenchmarkLessThan(const double threshold_ns,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE line);
+void UnityAssertBenchmarkFasterThan(const char* other,
+                                    const char* msg,
+                                    const UNITY_LINE_TYPE line);
+void UnityAssertBenchmarkWithinBaseline(const double tolerance_percent,
+                                        const char* msg,
+                                        const UNITY_LINE_TYPE line);
+
+/*-------------------------------------------------------
+ * Benchmark Blocks
+ *-------------------------------------------------------
+ * The code between BEGIN and END is run repeatedly: first to calibrate the
+ * iteration count, then UNITY_BENCHMARK_SAMPLES more times while timing. */
+
+#define TEST_BENCHMARK_BEGIN(name)                                       \
+    {                                                                    \
+        UNITY_UINT32 UnityBenchmarkCountdown;                            \
+        UnityBenchmarkBegin((name), __LINE__);                           \
+        while (UnityBenchmarkNextSample())                               \
+        {                                                                \
+            for (UnityBenchmarkCountdown = UnityBenchmarkIterations();   \
+                 UnityBenchmarkCountdown > 0;                            \
+                 UnityBenchmarkCountdown--)                              \
+            {
+
+#define TEST_BENCHMARK_END()                                             \
+            }                                                            \
+            UnityBenchmarkEndSample();                                   \
+        }                                                                \
+        UnityBenchmarkEnd();                                             \
+    }
+
+#ifdef UNITY_SUPPORT_VARIADIC_MACROS
+#define TEST_BENCHMARK(name, ...) TEST_BENCHMARK_BEGIN(name) __VA_ARGS__; TEST_BENCHMARK_END()
+#endif
+
+/*-------------------------------------------------------
+ * Benchmark Asserts (all apply to the most recent benchmark and compare medians)
+ *-------------------------------------------------------*/
+
+#define TEST_ASSERT_NS_PER_OP_LESS_THAN(threshold)                       UnityAssertBenchmarkLessThan((double)(threshold), NULL, __LINE__)
+#define TEST_ASSERT_NS_PER_OP_LESS_THAN_MESSAGE(threshold, message)      UnityAssertBenchmarkLessThan((double)(threshold), (message), __LINE__)
+#define TEST_ASSERT_FASTER_THAN(other)                                   UnityAssertBenchmarkFasterThan((other), NULL, __LINE__)
+#define TEST_ASSERT_FASTER_THAN_MESSAGE(other, message)                  UnityAssertBenchmarkFasterThan((other), (message), __LINE__)
+#define TEST_ASSERT_WITHIN_BASELINE(percent)                             UnityAssertBenchmarkWithinBaseline((double)(percent), NULL, __LINE__)
+#define TEST_ASSERT_WITHIN_BASELINE_MESSAGE(percent, message)            UnityAssertBenchmarkWithinBaseline((double)(percent), (message), __LINE__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UNITY_BENCHMARK_H_ */
@@ -0,0 +1,276 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_output_Spy.h"
+#include <string.h>
+
+/* Where the baseline file is written, relative to the directory the tests run from */
+#ifndef BENCHMARK_BASELINE_PATH
+#define BENCHMARK_BASELINE_PATH "../build/benchmark_baseline.txt"
+#endif
+
+/* This test module includes the following tests: */
+
+void test_MeasuresNanosecondsPerIteration(void);
+void test_CalibrationReachesMinimumSampleDuration(void);
+void test_ResultsAreFoundByName(void);
+void test_NsPerOpLessThanPassesWhenFaster(void);
+void test_NsPerOpLessThanFailsWhenSlower(void);
+void test_NoBenchmarkRunFails(void);
+void test_FasterThanComparesNamedBenchmarks(void);
+void test_FasterThanFailsWhenSlower(void);
+void test_FasterThanUnknownBenchmarkFails(void);
+void test_WithinBaselinePassesWithoutBaseline(void);
+void test_WithinBaselineFailsWhenRegressed(void);
+void test_BaselineRoundTripsThroughFile(void);
+void test_ConcludeAppendsStatisticsToPassLine(void);
+void test_StructuredOutputRecordsStatisticsOnce(void);
+
+/* It makes use of the following features */
+void setUp(void);
+void tearDown(void);
+double FakeClockNs(void);
+
+/* The fake clock only moves when the benchmarked code says so, which makes
+ * the measured ns/op exact and independent of the machine running the tests */
+static double fakeNow;
+
+double FakeClockNs(void)
+{
+    return fakeNow;
+}
+
+/* Let's Go! */
+void setUp(void)
+{
+    fakeNow = 0.0;
+    UnityOutputCharSpy_Create(1000);
+    UnityBenchmarkClearResults();
+    UnityBenchmarkClearBaseline();
+}
+
+void tearDown(void)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+#define EXPECT_ABORT_BEGIN \
+  { \
+    jmp_buf TestAbortFrame;   \
+    UNITY_COUNTER_TYPE failed; \
+    memcpy(TestAbortFrame, Unity.AbortFrame, sizeof(jmp_buf)); \
+    UnityOutputCharSpy_Enable(1); \
+    if (TEST_PROTECT()) \
+    {
+
+#define EXPECT_ABORT_END \
+    } \
+    UnityOutputCharSpy_Enable(0); \
+    memcpy(Unity.AbortFrame, TestAbortFrame, sizeof(jmp_buf)); \
+    failed = Unity.CurrentTestFailed; \
+    Unity.CurrentTestFailed = 0; \
+    TEST_ASSERT_EQUAL_MESSAGE(1, failed, "Expected the assertion to fail"); \
+  }
+
+static void runBenchmark(const char* name, double nsPerOp)
+{
+    TEST_BENCHMARK_BEGIN(name)
+        fakeNow += nsPerOp;
+    TEST_BENCHMARK_END();
+}
+
+void test_MeasuresNanosecondsPerIteration(void)
+{
+    const UNITY_BENCHMARK_RESULT_T* result;
+
+    runBenchmark("seven", 7.0);
+    result = UnityBenchmarkLastResult();
+
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL_STRING("seven", result->Name);
+    TEST_ASSERT_EQUAL(UNITY_BENCHMARK_SAMPLES, result->Samples);
+    TEST_ASSERT_TRUE(result->MedianNs == 7.0);
+    TEST_ASSERT_TRUE(result->MeanNs == 7.0);
+    TEST_ASSERT_TRUE(result->MinNs == 7.0);
+    TEST_ASSERT_TRUE(result->StdDevNs == 0.0);
+}
+
+void test_CalibrationReachesMinimumSampleDuration(void)
+{
+    const UNITY_BENCHMARK_RESULT_T* result;
+
+    runBenchmark("calibrated", 3.0);
+    result = UnityBenchmarkLastResult();
+
+    TEST_ASSERT_TRUE((double)result->Iterations * 3.0 >= UNITY_BENCHMARK_MIN_SAMPLE_NS);
+    TEST_ASSERT_TRUE((double)(result->Iterations / 2) * 3.0 < UNITY_BENCHMARK_MIN_SAMPLE_NS);
+}
+
+void test_ResultsAreFoundByName(void)
+{
+    runBenchmark("first", 4.0);
+    runBenchmark("second", 6.0);
+
+    TEST_ASSERT_NOT_NULL(UnityBenchmarkFindResult("first"));
+    TEST_ASSERT_TRUE(UnityBenchmarkFindResult("first")->MedianNs == 4.0);
+    TEST_ASSERT_TRUE(UnityBenchmarkFindResult("second")->MedianNs == 6.0);
+    TEST_ASSERT_NULL(UnityBenchmarkFindResult("third"));
+}
+
+void test_NsPerOpLessThanPassesWhenFaster(void)
+{
+    runBenchmark("fast", 2.0);
+    TEST_ASSERT_NS_PER_OP_LESS_THAN(2.5);
+}
+
+void test_NsPerOpLessThanFailsWhenSlower(void)
+{
+    runBenchmark("slow", 7.0);
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_NS_PER_OP_LESS_THAN(5);
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "Benchmark 'slow' Expected Less Than 5.0 ns/op Was 7.0 ns/op"));
+}
+
+void test_NoBenchmarkRunFails(void)
+{
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_NS_PER_OP_LESS_THAN(5);
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "No Benchmark Has Been Run"));
+}
+
+void test_FasterThanComparesNamedBenchmarks(void)
+{
+    runBenchmark("reference", 9.0);
+    runBenchmark("optimized", 3.0);
+    TEST_ASSERT_FASTER_THAN("reference");
+}
+
+void test_FasterThanFailsWhenSlower(void)
+{
+    runBenchmark("reference", 3.0);
+    runBenchmark("pessimized", 9.0);
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_FASTER_THAN_MESSAGE("reference", "mask path");
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "Benchmark 'pessimized' Expected Faster Than 'reference' (3.0 ns/op) Was 9.0 ns/op. mask path"));
+}
+
+void test_FasterThanUnknownBenchmarkFails(void)
+{
+    runBenchmark("lonely", 3.0);
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_FASTER_THAN("missing");
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "Cannot Compare To Unknown Benchmark 'missing'"));
+}
+
+void test_WithinBaselinePassesWithoutBaseline(void)
+{
+    runBenchmark("never_recorded", 100.0);
+    TEST_ASSERT_WITHIN_BASELINE(0);
+}
+
+void test_WithinBaselineFailsWhenRegressed(void)
+{
+    UnityBenchmarkSetBaseline("regressed", 10.0);
+
+    runBenchmark("regressed", 10.5);
+    TEST_ASSERT_WITHIN_BASELINE(10);
+
+    runBenchmark("regressed", 12.0);
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_WITHIN_BASELINE(10);
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "Expected Within 10.0% Of Baseline 10.0 ns/op Was 12.0 ns/op"));
+}
+
+void test_BaselineRoundTripsThroughFile(void)
+{
+    const char* path = BENCHMARK_BASELINE_PATH;
+
+    UnityBenchmarkSetBaseline("kept_from_before", 42.0);
+    runBenchmark("saved", 5.0);
+    TEST_ASSERT_EQUAL(2, UnityBenchmarkSaveBaseline(path));
+
+    UnityBenchmarkSetBaseline("saved", 999.0);
+    TEST_ASSERT_EQUAL(2, UnityBenchmarkLoadBaseline(path));
+    TEST_ASSERT_TRUE(UnityBenchmarkGetBaseline("saved") == 5.0);
+    TEST_ASSERT_TRUE(UnityBenchmarkGetBaseline("kept_from_before") == 42.0);
+    TEST_ASSERT_TRUE(UnityBenchmarkGetBaseline("unknown") < 0.0);
+}
+
+void test_ConcludeAppendsStatisticsToPassLine(void)
+{
+    const char* first;
+    const char* last;
+
+    runBenchmark("reported", 3.0);
+
+    UnityOutputCharSpy_Enable(1);
+    UnityBenchmarkConcludeTest();
+    UnityBenchmarkConcludeTest(); /* results are only reported once */
+    UnityOutputCharSpy_Enable(0);
+
+    TEST_ASSERT_EQUAL_STRING_LEN(" [reported: median 3.0 ns/op, mean 3.0, stddev 0.0, 15x",
+                                 UnityOutputCharSpy_Get(), 55);
+    first = strchr(UnityOutputCharSpy_Get(), ']');
+    last = strrchr(UnityOutputCharSpy_Get(), ']');
+    TEST_ASSERT_EQUAL_PTR(first, last);
+}
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+/* Runs a suite of one passing benchmark in the given format, then puts back
+ * the state of the suite running us */
+static void runStructuredBenchmark(const UNITY_OUTPUT_FORMAT_T format)
+{
+    struct UNITY_STORAGE_T savedUnity = Unity;
+
+    UnitySetOutputFormat(format);
+    UnityOutputCharSpy_Enable(1);
+    UnityBegin("a.c");
+    Unity.CurrentTestName = "t";
+    Unity.CurrentTestLineNumber = 7;
+    Unity.NumberOfTests++;
+    runBenchmark("inner", 3.0);
+    UnityConcludeTest();
+    UnityEnd();
+    UnityOutputCharSpy_Enable(0);
+    UnitySetOutputFormat(UNITY_OUTPUT_FORMAT_TEXT);
+    Unity = savedUnity;
+}
+#endif
+
+void test_StructuredOutputRecordsStatisticsOnce(void)
+{
+#ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    TEST_IGNORE();
+#else
+    runStructuredBenchmark(UNITY_OUTPUT_FORMAT_JSON_LINES);
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "\"status\":\"PASS\",\"benchmark\":\"[inner: median 3.0 ns/op, mean 3.0, stddev 0.0, 15x"));
+
+    UnityOutputCharSpy_Destroy();
+    UnityOutputCharSpy_Create(1000);
+    UnityOutputCharSpy_Enable(1);
+    UnityBenchmarkConcludeTest(); /* already reported by the record */
+    UnityOutputCharSpy_Enable(0);
+    TEST_ASSERT_EQUAL_STRING("", UnityOutputCharSpy_Get());
+
+    runStructuredBenchmark(UNITY_OUTPUT_FORMAT_JUNIT_XML);
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "<testcase classname=\"a.c\" name=\"t\" file=\"a.c\" line=\"7\">\n"
+        "    <system-out>[inner: median 3.0 ns/op"));
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "]</system-out>\n  </testcase>\n"));
+#endif
+}
@@ -0,0 +1,44 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_benchmark.h"
+
+extern void test_MeasuresNanosecondsPerIteration(void);
+extern void test_CalibrationReachesMinimumSampleDuration(void);
+extern void test_ResultsAreFoundByName(void);
+extern void test_NsPerOpLessThanPassesWhenFaster(void);
+extern void test_NsPerOpLessThanFailsWhenSlower(void);
+extern void test_NoBenchmarkRunFails(void);
+extern void test_FasterThanComparesNamedBenchmarks(void);
+extern void test_FasterThanFailsWhenSlower(void);
+extern void test_FasterThanUnknownBenchmarkFails(void);
+extern void test_WithinBaselinePassesWithoutBaseline(void);
+extern void test_WithinBaselineFailsWhenRegressed(void);
+extern void test_BaselineRoundTripsThroughFile(void);
+extern void test_ConcludeAppendsStatisticsToPassLine(void);
+extern void test_StructuredOutputRecordsStatisticsOnce(void);
+
+int main(void)
+{
+    UnityBegin("unity_benchmark_Test.c");
+    RUN_TEST(test_MeasuresNanosecondsPerIteration);
+    RUN_TEST(test_CalibrationReachesMinimumSampleDuration);
+    RUN_TEST(test_ResultsAreFoundByName);
+    RUN_TEST(test_NsPerOpLessThanPassesWhenFaster);
+    RUN_TEST(test_NsPerOpLessThanFailsWhenSlower);
+    RUN_TEST(test_NoBenchmarkRunFails);
+    RUN_TEST(test_FasterThanComparesNamedBenchmarks);
+    RUN_TEST(test_FasterThanFailsWhenSlower);
+    RUN_TEST(test_FasterThanUnknownBenchmarkFails);
+    RUN_TEST(test_WithinBaselinePassesWithoutBaseline);
+    RUN_TEST(test_WithinBaselineFailsWhenRegressed);
+    RUN_TEST(test_BaselineRoundTripsThroughFile);
+    RUN_TEST(test_ConcludeAppendsStatisticsToPassLine);
+    RUN_TEST(test_StructuredOutputRecordsStatisticsOnce);
+    return UnityEnd();
+}
@@ -9,6 +9,16 @@
 #include "unity_internals.h"
 #include <string.h>
 
+/* Define UNITY_FIXTURE_CLOCK_US as the name of a function returning a
+ * monotonic timestamp in microseconds to time tests in soak mode with
+ * another clock than UnityClockNs. */
+#ifdef UNITY_FIXTURE_CLOCK_US
+double UNITY_FIXTURE_CLOCK_US(void);
+#define UnityFixtureClockUs() UNITY_FIXTURE_CLOCK_US()
+#else
+#define UnityFixtureClockUs() (UnityClockNs() / 1e3)
+#endif
+
 struct UNITY_FIXTURE_T UnityFixture;
 
 /* If you decide to use the function pointer approach.
@@ -18,13 +28,244 @@ struct UNITY_FIXTURE_T UnityFixture;
 void setUp(void)    { /*does nothing*/ }
 void tearDown(void) { /*does nothing*/ }
 
-static void announceTestRun(unsigned int runNumber)
+static void announceTestRun(unsigned int runNumber, unsigned int runCount, int shuffle, unsigned int seed)
 {
     UnityPrint("Unity test run ");
     UnityPrintNumberUnsigned(runNumber+1);
     UnityPrint(" of ");
-    UnityPrintNumberUnsigned(UnityFixture.RepeatCount);
+    UnityPrintNumberUnsigned(runCount);
+    if (shuffle)
+    {
+        UnityPrint(" (seed ");
+        UnityPrintNumberUnsigned(seed);
+        UnityPrint(")");
+    }
+    UNITY_PRINT_EOL();
+}
+
+/*-------------------------------------------------------- */
+/* Soak mode: when repeating or shuffling, the selected tests are collected
+ * once into a table. Every run then walks the table in its own order and the
+ * outcome and duration of each test are accumulated for a final report. */
+struct SoakTest
+{
+    unityfunction* setup;
+    unityfunction* testBody; /* NULL for IGNORE_TEST */
+    unityfunction* teardown;
+    const char* printableName;
+    const char* group;
+    const char* name;
+    const char* file;
+    unsigned int line;
+    unsigned int passes;
+    unsigned int failures;
+    unsigned int ignores;
+    double minUs;
+    double maxUs;
+    double meanUs;    /* running mean and sum of squared deviations, */
+    double squaresUs; /* updated with Welford's method */
+};
+
+static struct SoakTest soak_tests[UNITY_FIXTURE_MAX_SOAK_TESTS];
+static unsigned int soak_order[UNITY_FIXTURE_MAX_SOAK_TESTS];
+static unsigned int soak_count = 0;
+static int soak_collecting = 0;
+static int soak_overflow = 0;
+static struct SoakTest* soak_current = 0;
+
+static void collectTest(unityfunction* setup,
+                        unityfunction* testBody,
+                        unityfunction* teardown,
+                        const char* printableName,
+                        const char* group,
+                        const char* name,
+                        const char* file,
+                        unsigned int line)
+{
+    struct SoakTest* test;
+    if (soak_count >= UNITY_FIXTURE_MAX_SOAK_TESTS)
+    {
+        soak_overflow = 1;
+        return;
+    }
+    test = &soak_tests[soak_count++];
+    memset(test, 0, sizeof(*test));
+    test->setup = setup;
+    test->testBody = testBody;
+    test->teardown = teardown;
+    test->printableName = printableName;
+    test->group = group;
+    test->name = name;
+    test->file = file;
+    test->line = line;
+}
+
+static void recordSoakResult(struct SoakTest* test, UNITY_UINT failed, UNITY_UINT ignored, double elapsedUs)
+{
+    unsigned int timed = test->passes + test->failures;
+    double delta;
+    if (ignored)
+    {
+        test->ignores++;
+        return;
+    }
+    if (failed)
+        test->failures++;
+    else
+        test->passes++;
+    if ((timed == 0) || (elapsedUs < test->minUs))
+        test->minUs = elapsedUs;
+    if ((timed == 0) || (elapsedUs > test->maxUs))
+        test->maxUs = elapsedUs;
+    delta = elapsedUs - test->meanUs;
+    test->meanUs += delta / (double)(timed + 1);
+    test->squaresUs += delta * (elapsedUs - test->meanUs);
+}
+
+static void runSoakTest(struct SoakTest* test)
+{
+    soak_current = test;
+    if (test->testBody)
+    {
+        UnityTestRunner(test->setup, test->testBody, test->teardown,
+                        test->printableName, test->group, test->name,
+                        test->file, test->line);
+    }
+    else
+    {
+        UnityIgnoreTest(test->printableName, test->group, test->name);
+    }
+    soak_current = 0;
+}
+
+void UnityShuffleTestOrder(unsigned int* order, unsigned int count, unsigned int seed)
+{
+    UNITY_UINT32 state = (UNITY_UINT32)seed;
+    unsigned int i;
+
+    /* Mix the seed so that consecutive seeds give unrelated orders */
+    state ^= state >> 16;
+    state = (UNITY_UINT32)(state * 0x7FEB352DUL);
+    state ^= state >> 15;
+    state = (UNITY_UINT32)(state * 0x846CA68BUL);
+    state ^= state >> 16;
+    if (state == 0)
+        state = 0x9E3779B9UL;
+
+    /* Fisher-Yates with an xorshift32 generator */
+    for (i = count; i > 1; i--)
+    {
+        unsigned int j;
+        unsigned int swap;
+        state ^= (UNITY_UINT32)(state << 13);
+        state ^= state >> 17;
+        state ^= (UNITY_UINT32)(state << 5);
+        j = (unsigned int)(state % i);
+        swap = order[i - 1];
+        order[i - 1] = order[j];
+        order[j] = swap;
+    }
+}
+
+static UNITY_UINT roundUs(double us)
+{
+    return (UNITY_UINT)(us + 0.5);
+}
+
+static void printSoakTest(const struct SoakTest* test)
+{
+    unsigned int timed = test->passes + test->failures;
+    UnityPrint(test->printableName);
+    UnityPrint(" passed ");
+    UnityPrintNumberUnsigned(test->passes);
+    UnityPrint(", failed ");
+    UnityPrintNumberUnsigned(test->failures);
+    if (test->ignores)
+    {
+        UnityPrint(", ignored ");
+        UnityPrintNumberUnsigned(test->ignores);
+    }
+    if (timed)
+    {
+        UnityPrint(" [min ");
+        UnityPrintNumberUnsigned(roundUs(test->minUs));
+        UnityPrint(" us, mean ");
+        UnityPrintNumberUnsigned(roundUs(test->meanUs));
+        UnityPrint(" us, max ");
+        UnityPrintNumberUnsigned(roundUs(test->maxUs));
+        UnityPrint(" us, stddev ");
+        UnityPrintNumberUnsigned(roundUs(UnitySqrt(test->squaresUs / (double)timed)));
+        UnityPrint(" us]");
+    }
+    if (test->failures && test->passes)
+        UnityPrint(" FLAKY");
+    else if (test->failures)
+        UnityPrint(" FAILING");
+    UNITY_PRINT_EOL();
+}
+
+/* Returns the number of tests that failed at least once */
+static int printSoakReport(unsigned int runCount, int verbose)
+{
+    unsigned int i;
+    unsigned int flaky = 0;
+    unsigned int failing = 0;
+
+    UNITY_PRINT_EOL();
+    UnityPrint("Soak report for ");
+    UnityPrintNumberUnsigned(runCount);
+    UnityPrint(" runs");
+    UNITY_PRINT_EOL();
+    for (i = 0; i < soak_count; i++)
+    {
+        const struct SoakTest* test = &soak_tests[i];
+        if (test->failures && test->passes)
+            flaky++;
+        else if (test->failures)
+            failing++;
+        if (verbose || test->failures)
+            printSoakTest(test);
+    }
+    UnityPrint("-----------------------");
+    UNITY_PRINT_EOL();
+    UnityPrintNumberUnsigned(soak_count);
+    UnityPrint(" Tests ");
+    UnityPrintNumberUnsigned(flaky);
+    UnityPrint(" Flaky ");
+    UnityPrintNumberUnsigned(failing);
+    UnityPrint(" Failing");
     UNITY_PRINT_EOL();
+    UNITY_FLUSH_CALL();
+    return (int)(flaky + failing);
+}
+
+static int runSoak(const char* testFile)
+{
+    /* Tests may change the options, so the ones given on the command line are kept here */
+    const unsigned int runCount = UnityFixture.RepeatCount;
+    const int shuffle = UnityFixture.Shuffle;
+    const unsigned int seed = UnityFixture.Seed;
+    const int verbose = UnityFixture.Verbose;
+    unsigned int r;
+    unsigned int i;
+
+    for (r = 0; r < runCount; r++)
+    {
+        UnityBegin(testFile);
+        announceTestRun(r, runCount, shuffle, seed + r);
+        for (i = 0; i < soak_count; i++)
+            soak_order[i] = i;
+        if (shuffle)
+            UnityShuffleTestOrder(soak_order, soak_count, seed + r);
+        for (i = 0; i < soak_count; i++)
+            runSoakTest(&soak_tests[soak_order[i]]);
+        if (!verbose) UNITY_PRINT_EOL();
+        UnityEnd();
+    }
+
+    if (runCount > 1)
+        return printSoakReport(runCount, verbose);
+    return (int)Unity.TestFailures;
 }
 
 int UnityMain(int argc, const char* argv[], void (*runAllTests)(void))
@@ -34,10 +275,30 @@ int UnityMain(int argc, const char* argv[], void (*runAllTests)(void))
     if (result != 0)
         return result;
 
+    if (UnityFixture.List)
+    {
+        runAllTests();
+        UNITY_FLUSH_CALL();
+        return 0;
+    }
+
+    if ((UnityFixture.RepeatCount > 1) || UnityFixture.Shuffle)
+    {
+        soak_count = 0;
+        soak_overflow = 0;
+        soak_collecting = 1;
+        runAllTests();
+        soak_collecting = 0;
+        if (!soak_overflow)
+            return runSoak(argv[0]);
+        UnityPrint("Too many tests for soak mode, increase UNITY_FIXTURE_MAX_SOAK_TESTS");
+        UNITY_PRINT_EOL();
+    }
+
     for (r = 0; r < UnityFixture.RepeatCount; r++)
     {
         UnityBegin(argv[0]);
-        announceTestRun(r);
+        announceTestRun(r, UnityFixture.RepeatCount, 0, 0);
         runAllTests();
         if (!UnityFixture.Verbose) UNITY_PRINT_EOL();
         UnityEnd();
@@ -46,21 +307,64 @@ int UnityMain(int argc, const char* argv[], void (*runAllTests)(void))
     return (int)Unity.TestFailures;
 }
 
-static int selected(const char* filter, const char* name)
+/* Filters with * or ? and all filters given with --exact must match the whole
+ * name, any other filter only has to appear somewhere in it */
+static int nameMatches(const char* filter, const char* name)
 {
-    if (filter == 0)
-        return 1;
+    if (UnityFixture.ExactMatch || strchr(filter, '*') || strchr(filter, '?'))
+        return UnityGlobMatch(filter, name);
     return strstr(name, filter) ? 1 : 0;
 }
 
+/* A NameFilter or GroupFilter set directly, as before filters could be
+ * repeated, counts as one more filter */
+static int selected(const char* legacy, const char* const* filters, unsigned int count, const char* name)
+{
+    unsigned int i;
+    if (count == 0 && legacy == 0)
+        return 1;
+    if (legacy != 0 && nameMatches(legacy, name))
+        return 1;
+    for (i = 0; i < count; i++)
+    {
+        if (nameMatches(filters[i], name))
+            return 1;
+    }
+    return 0;
+}
+
 static int testSelected(const char* test)
 {
-    return selected(UnityFixture.NameFilter, test);
+    return selected(UnityFixture.NameFilter, UnityFixture.NameFilters, UnityFixture.NameFilterCount, test) &&
+           !(UnityFixture.ExcludeFilterCount &&
+             selected(0, UnityFixture.ExcludeFilters, UnityFixture.ExcludeFilterCount, test));
 }
 
 static int groupSelected(const char* group)
 {
-    return selected(UnityFixture.GroupFilter, group);
+    return selected(UnityFixture.GroupFilter, UnityFixture.GroupFilters, UnityFixture.GroupFilterCount, group);
+}
+
+/* Shards by a hash of the group and test names, so a test stays in its shard
+ * when other tests are added or removed */
+static int shardSelected(const char* group, const char* name)
+{
+    UNITY_UINT32 hash;
+    if (UnityFixture.ShardCount <= 1)
+        return 1;
+    hash = UnityHashString(UnityHashString(UNITY_HASH_INIT, group), name);
+    return (hash % UnityFixture.ShardCount) == UnityFixture.ShardIndex;
+}
+
+static int isSelected(const char* group, const char* name)
+{
+    return testSelected(name) && groupSelected(group) && shardSelected(group, name);
+}
+
+static void listTest(const char* printableName)
+{
+    UnityPrint(printableName);
+    UNITY_PRINT_EOL();
 }
 
 void UnityTestRunner(unityfunction* setup,
@@ -72,8 +376,20 @@ void UnityTestRunner(unityfunction* setup,
                      const char* file,
                      unsigned int line)
 {
-    if (testSelected(name) && groupSelected(group))
+    if (isSelected(group, name) && UnityFixture.List)
+    {
+        listTest(printableName);
+    }
+    else if (isSelected(group, name) && soak_collecting)
+    {
+        collectTest(setup, testBody, teardown, printableName, group, name, file, line);
+    }
+    else if (isSelected(group, name))
     {
+        /* Taken here so that runners called from within a test are not recorded */
+        struct SoakTest* soakTest = soak_current;
+        double startUs = 0.0;
+        soak_current = 0;
         Unity.TestFile = file;
         Unity.CurrentTestName = printableName;
         Unity.CurrentTestLineNumber = line;
@@ -97,6 +413,8 @@ void UnityTestRunner(unityfunction* setup,
         UnityPointer_Init();
 
         UNITY_EXEC_TIME_START();
+        if (soakTest)
+            startUs = UnityFixtureClockUs();
 
         if (TEST_PROTECT())
         {
@@ -111,14 +429,29 @@ void UnityTestRunner(unityfunction* setup,
         {
             UnityPointer_UndoAllSets();
         }
+        if (soakTest)
+        {
+            recordSoakResult(soakTest, Unity.CurrentTestFailed, Unity.CurrentTestIgnored,
+                             UnityFixtureClockUs() - startUs);
+        }
         UnityConcludeFixtureTest();
     }
 }
 
 void UnityIgnoreTest(const char* printableName, const char* group, const char* name)
 {
-    if (testSelected(name) && groupSelected(group))
+    if (isSelected(group, name) && UnityFixture.List)
+    {
+        listTest(printableName);
+    }
+    else if (isSelected(group, name) && soak_collecting)
     {
+        collectTest(0, 0, 0, printableName, group, name, 0, 0);
+    }
+    else if (isSelected(group, name))
+    {
+        if (soak_current)
+            recordSoakResult(soak_current, 0, 1, 0.0);
         Unity.NumberOfTests++;
         Unity.TestIgnores++;
         if (UnityFixture.Verbose)
@@ -178,14 +511,77 @@ void UnityPointer_UndoAllSets(void)
     }
 }
 
+static int addFilter(const char** filters, unsigned int* count, const char* filter)
+{
+    if (*count >= UNITY_FIXTURE_MAX_FILTERS)
+    {
+        UnityPrint("Too many filters, increase UNITY_FIXTURE_MAX_FILTERS");
+        UNITY_PRINT_EOL();
+        return 0;
+    }
+    filters[(*count)++] = filter;
+    return 1;
+}
+
+static int isNumber(const char* arg)
+{
+    return (*arg >= '0' && *arg <= '9');
+}
+
+static unsigned int parseNumber(const char* arg)
+{
+    unsigned int digit = 0;
+    unsigned int number = 0;
+    while (arg[digit] >= '0' && arg[digit] <= '9')
+    {
+        number *= 10;
+        number += (unsigned int)arg[digit++] - '0';
+    }
+    return number;
+}
+
+/* Reads INDEX/COUNT with INDEX counted from 1 */
+static int parseShard(const char* arg)
+{
+    const char* slash = strchr(arg, '/');
+    unsigned int index;
+    unsigned int count;
+    if (!isNumber(arg) || slash == 0 || !isNumber(slash + 1))
+        return 0;
+    index = parseNumber(arg);
+    count = parseNumber(slash + 1);
+    if (index < 1 || index > count)
+        return 0;
+    UnityFixture.ShardIndex = index - 1;
+    UnityFixture.ShardCount = count;
+    return 1;
+}
+
+/* Without a seed on the command line the clock picks one, printed with each run */
+static unsigned int defaultSeed(void)
+{
+    double now = UnityFixtureClockUs();
+    double high = (double)(unsigned long)(now / 4294967296.0);
+    return (unsigned int)(unsigned long)(now - (high * 4294967296.0));
+}
+
 int UnityGetCommandLineOptions(int argc, const char* argv[])
 {
     int i;
     UnityFixture.Verbose = 0;
     UnityFixture.Silent = 0;
+    UnityFixture.List = 0;
+    UnityFixture.ExactMatch = 0;
     UnityFixture.GroupFilter = 0;
     UnityFixture.NameFilter = 0;
+    UnityFixture.GroupFilterCount = 0;
+    UnityFixture.NameFilterCount = 0;
+    UnityFixture.ExcludeFilterCount = 0;
     UnityFixture.RepeatCount = 1;
+    UnityFixture.Shuffle = 0;
+    UnityFixture.Seed = 0;
+    UnityFixture.ShardIndex = 0;
+    UnityFixture.ShardCount = 1;
 
     if (argc == 1)
         return 0;
@@ -211,7 +607,23 @@ int UnityGetCommandLineOptions(int argc, const char* argv[])
             UNITY_PRINT_EOL();
             UnityPrint("  -n NAME     Only run tests whose name contains the string NAME");
             UNITY_PRINT_EOL();
-            UnityPrint("  -r NUMBER   Repeatedly run all tests NUMBER times");
+            UnityPrint("  -x NAME     Do not run tests whose name contains the string NAME");
+            UNITY_PRINT_EOL();
+            UnityPrint("              -g, -n and -x may be repeated, NAME may use * and ? wildcards");
+            UNITY_PRINT_EOL();
+            UnityPrint("  --exact     Group and test names must match NAME exactly");
+            UNITY_PRINT_EOL();
+            UnityPrint("  -l, --list  List the selected tests without running them");
+            UNITY_PRINT_EOL();
+            UnityPrint("  --shard INDEX/COUNT");
+            UNITY_PRINT_EOL();
+            UnityPrint("              Only run shard INDEX (from 1) of COUNT shards of the tests");
+            UNITY_PRINT_EOL();
+            UnityPrint("  -r NUMBER   Repeatedly run all tests NUMBER times and report flaky tests");
+            UNITY_PRINT_EOL();
+            UnityPrint("  --shuffle [SEED]");
+            UNITY_PRINT_EOL();
+            UnityPrint("              Run tests in a random order, SEED repeats the order of a past run");
             UNITY_PRINT_EOL();
             UnityPrint("  -h, --help  Display this help message");
             UNITY_PRINT_EOL();
@@ -237,10 +649,20 @@ int UnityGetCommandLineOptions(int argc, const char* argv[])
             UnityFixture.Silent = 1;
             i++;
         }
+        else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--list") == 0)
+        {
+            UnityFixture.List = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--exact") == 0)
+        {
+            UnityFixture.ExactMatch = 1;
+            i++;
+        }
         else if (strcmp(argv[i], "-g") == 0)
         {
             i++;
-            if (i >= argc)
+            if (i >= argc || !addFilter(UnityFixture.GroupFilters, &UnityFixture.GroupFilterCount, argv[i]))
                 return 1;
             UnityFixture.GroupFilter = argv[i];
             i++;
@@ -248,28 +670,44 @@ int UnityGetCommandLineOptions(int argc, const char* argv[])
         else if (strcmp(argv[i], "-n") == 0)
         {
             i++;
-            if (i >= argc)
+            if (i >= argc || !addFilter(UnityFixture.NameFilters, &UnityFixture.NameFilterCount, argv[i]))
                 return 1;
             UnityFixture.NameFilter = argv[i];
             i++;
         }
+        else if (strcmp(argv[i], "-x") == 0)
+        {
+            i++;
+            if (i >= argc || !addFilter(UnityFixture.ExcludeFilters, &UnityFixture.ExcludeFilterCount, argv[i]))
+                return 1;
+            i++;
+        }
         else if (strcmp(argv[i], "-r") == 0)
         {
             UnityFixture.RepeatCount = 2;
             i++;
-            if (i < argc)
+            if (i < argc && isNumber(argv[i]))
+            {
+                UnityFixture.RepeatCount = parseNumber(argv[i]);
+                i++;
+            }
+        }
+        else if (strcmp(argv[i], "--shard") == 0)
+        {
+            i++;
+            if (i >= argc || !parseShard(argv[i]))
+                return 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--shuffle") == 0)
+        {
+            UnityFixture.Shuffle = 1;
+            UnityFixture.Seed = defaultSeed();
+            i++;
+            if (i < argc && isNumber(argv[i]))
             {
-                if (*(argv[i]) >= '0' && *(argv[i]) <= '9')
-                {
-                    unsigned int digit = 0;
-                    UnityFixture.RepeatCount = 0;
-                    while (argv[i][digit] >= '0' && argv[i][digit] <= '9')
-                    {
-                        UnityFixture.RepeatCount *= 10;
-                        UnityFixture.RepeatCount += (unsigned int)argv[i][digit++] - '0';
-                    }
-                    i++;
-                }
+                UnityFixture.Seed = parseNumber(argv[i]);
+                i++;
             }
         }
         else
@@ -294,6 +732,7 @@ void UnityConcludeFixtureTest(void)
         {
             UnityPrint(" ");
             UnityPrint(UnityStrPass);
+            UNITY_PRINT_BENCHMARK();
             UNITY_EXEC_TIME_STOP();
             UNITY_PRINT_EXEC_TIME();
             UNITY_PRINT_EOL();
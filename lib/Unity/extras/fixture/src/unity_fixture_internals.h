@@ -14,13 +14,30 @@ extern "C"
 {
 #endif
 
+/* Upper bound on each of the -g, -n and -x filters given on the command line */
+#ifndef UNITY_FIXTURE_MAX_FILTERS
+#define UNITY_FIXTURE_MAX_FILTERS 8
+#endif
+
 struct UNITY_FIXTURE_T
 {
     int Verbose;
     int Silent;
+    int List;
+    int ExactMatch;
     unsigned int RepeatCount;
-    const char* NameFilter;
-    const char* GroupFilter;
+    int Shuffle;
+    unsigned int Seed;
+    unsigned int ShardIndex; /* counted from 0 */
+    unsigned int ShardCount;
+    const char* NameFilter;  /* the last -n given, or a filter set directly */
+    const char* GroupFilter; /* the last -g given, or a filter set directly */
+    const char* NameFilters[UNITY_FIXTURE_MAX_FILTERS];
+    const char* GroupFilters[UNITY_FIXTURE_MAX_FILTERS];
+    const char* ExcludeFilters[UNITY_FIXTURE_MAX_FILTERS];
+    unsigned int NameFilterCount;
+    unsigned int GroupFilterCount;
+    unsigned int ExcludeFilterCount;
 };
 extern struct UNITY_FIXTURE_T UnityFixture;
 
@@ -35,6 +52,7 @@ void UnityTestRunner(unityfunction* setup,
 
 void UnityIgnoreTest(const char* printableName, const char* group, const char* name);
 int UnityGetCommandLineOptions(int argc, const char* argv[]);
+void UnityShuffleTestOrder(unsigned int* order, unsigned int count, unsigned int seed);
 void UnityConcludeFixtureTest(void);
 
 void UnityPointer_Set(void** pointer, void* newValue, UNITY_LINE_TYPE line);
@@ -44,6 +62,11 @@ void UnityPointer_Init(void);
 #define UNITY_MAX_POINTERS 5
 #endif
 
+/* Upper bound on the tests tracked when running repeatedly or shuffled */
+#ifndef UNITY_FIXTURE_MAX_SOAK_TESTS
+#define UNITY_FIXTURE_MAX_SOAK_TESTS 256
+#endif
+
 #ifdef __cplusplus
 }
 #endif
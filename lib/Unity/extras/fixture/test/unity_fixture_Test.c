@@ -89,25 +89,16 @@ TEST(UnityFixture, ConcludeTestIncrementsFailCount)
 
 TEST_GROUP(UnityCommandOptions);
 
-static int savedVerbose;
-static unsigned int savedRepeat;
-static const char* savedName;
-static const char* savedGroup;
+static struct UNITY_FIXTURE_T savedOptions;
 
 TEST_SETUP(UnityCommandOptions)
 {
-    savedVerbose = UnityFixture.Verbose;
-    savedRepeat = UnityFixture.RepeatCount;
-    savedName = UnityFixture.NameFilter;
-    savedGroup = UnityFixture.GroupFilter;
+    savedOptions = UnityFixture;
 }
 
 TEST_TEAR_DOWN(UnityCommandOptions)
 {
-    UnityFixture.Verbose = savedVerbose;
-    UnityFixture.RepeatCount= savedRepeat;
-    UnityFixture.NameFilter = savedName;
-    UnityFixture.GroupFilter = savedGroup;
+    UnityFixture = savedOptions;
 }
 
 
@@ -122,6 +113,7 @@ TEST(UnityCommandOptions, DefaultOptions)
     TEST_ASSERT_POINTERS_EQUAL(0, UnityFixture.GroupFilter);
     TEST_ASSERT_POINTERS_EQUAL(0, UnityFixture.NameFilter);
     TEST_ASSERT_EQUAL(1, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityFixture.Shuffle);
 }
 
 static const char* verbose[] = {
@@ -225,6 +217,181 @@ TEST(UnityCommandOptions, UnknownCommandIsIgnored)
     TEST_ASSERT_EQUAL(98, UnityFixture.RepeatCount);
 }
 
+static const char* shuffle[] = {
+        "testrunner.exe",
+        "--shuffle", "1234",
+        "-r", "5"
+};
+
+TEST(UnityCommandOptions, OptionShuffleWithSeed)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(5, shuffle));
+    TEST_ASSERT_EQUAL(1, UnityFixture.Shuffle);
+    TEST_ASSERT_EQUAL(1234, UnityFixture.Seed);
+    TEST_ASSERT_EQUAL(5, UnityFixture.RepeatCount);
+}
+
+TEST(UnityCommandOptions, OptionShuffleWithoutSeed)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, shuffle));
+    TEST_ASSERT_EQUAL(1, UnityFixture.Shuffle);
+    TEST_ASSERT_EQUAL(1, UnityFixture.RepeatCount);
+}
+
+TEST(UnityCommandOptions, ShuffleIsAReproduciblePermutation)
+{
+    unsigned int first[20];
+    unsigned int again[20];
+    unsigned int other[20];
+    unsigned int seen = 0;
+    int moved = 0;
+    unsigned int i;
+    for (i = 0; i < 20; i++)
+    {
+        first[i] = i;
+        again[i] = i;
+        other[i] = i;
+    }
+    UnityShuffleTestOrder(first, 20, 42);
+    UnityShuffleTestOrder(again, 20, 42);
+    UnityShuffleTestOrder(other, 20, 43);
+    TEST_ASSERT_EQUAL_UINT_ARRAY(first, again, 20);
+    for (i = 0; i < 20; i++)
+    {
+        seen |= 1u << first[i];
+        if (first[i] != other[i])
+            moved = 1;
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFF, seen);
+    TEST_ASSERT_TRUE(moved);
+}
+
+static const char* filters[] = {
+        "testrunner.exe",
+        "-n", "one",
+        "-g", "grp",
+        "-n", "two",
+        "-x", "three",
+        "--exact",
+        "--list"
+};
+
+TEST(UnityCommandOptions, FiltersCanBeRepeated)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(11, filters));
+    TEST_ASSERT_EQUAL(2, UnityFixture.NameFilterCount);
+    STRCMP_EQUAL("one", UnityFixture.NameFilters[0]);
+    STRCMP_EQUAL("two", UnityFixture.NameFilters[1]);
+    STRCMP_EQUAL("two", UnityFixture.NameFilter);
+    TEST_ASSERT_EQUAL(1, UnityFixture.GroupFilterCount);
+    STRCMP_EQUAL("grp", UnityFixture.GroupFilter);
+    TEST_ASSERT_EQUAL(1, UnityFixture.ExcludeFilterCount);
+    STRCMP_EQUAL("three", UnityFixture.ExcludeFilters[0]);
+    TEST_ASSERT_EQUAL(1, UnityFixture.ExactMatch);
+    TEST_ASSERT_EQUAL(1, UnityFixture.List);
+}
+
+static int isSelected(const char* groupName, const char* testName)
+{
+    UNITY_UINT savedTests = Unity.NumberOfTests;
+    UNITY_UINT savedIgnores = Unity.TestIgnores;
+    int wasSelected;
+    UnityFixture.Silent = 1;
+    UnityIgnoreTest("", groupName, testName);
+    wasSelected = (Unity.NumberOfTests != savedTests);
+    Unity.NumberOfTests = savedTests;
+    Unity.TestIgnores = savedIgnores;
+    return wasSelected;
+}
+
+static const char* globs[] = {
+        "testrunner.exe",
+        "-n", "Opt*Name",
+        "-n", "Multiple?ptions",
+        "-x", "*Group*"
+};
+
+TEST(UnityCommandOptions, GlobFiltersMatchWholeName)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(7, globs));
+    CHECK(isSelected("UnityCommandOptions", "OptionSelectTestByName"));
+    CHECK(isSelected("UnityCommandOptions", "MultipleOptions"));
+    CHECK(!isSelected("UnityCommandOptions", "MultipleOptionsDashRNotLastAndNoValueSpecified"));
+    CHECK(!isSelected("UnityCommandOptions", "OptionSelectTestByNameOrGroup"));
+    CHECK(!isSelected("UnityCommandOptions", "OptionSelectTestByGroupName"));
+}
+
+static const char* exact[] = {
+        "testrunner.exe",
+        "--exact",
+        "-g", "UnityCommand",
+        "-g", "UnityCommandOptions",
+        "-n", "MultipleOptions"
+};
+
+TEST(UnityCommandOptions, ExactFiltersDoNotMatchParts)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(8, exact));
+    CHECK(isSelected("UnityCommandOptions", "MultipleOptions"));
+    CHECK(!isSelected("UnityCommandOptions", "MultipleOptionsDashRNotLastAndNoValueSpecified"));
+    CHECK(!isSelected("UnityCommandOptionsExtra", "MultipleOptions"));
+}
+
+TEST(UnityCommandOptions, FiltersSetDirectlyStillFilter)
+{
+    UnityGetCommandLineOptions(1, noOptions);
+    UnityFixture.GroupFilter = "UnityCommandOptions";
+    UnityFixture.NameFilter = "MultipleOptions";
+    CHECK(isSelected("UnityCommandOptions", "MultipleOptions"));
+    CHECK(isSelected("UnityCommandOptions", "MultipleOptionsDashRNotLastAndNoValueSpecified"));
+    CHECK(!isSelected("UnityCommandOptions", "OptionSelectTestByName"));
+    CHECK(!isSelected("UnityFixture", "MultipleOptions"));
+}
+
+static const char* shard[] = {
+        "testrunner.exe",
+        "--shard", "2/3"
+};
+
+TEST(UnityCommandOptions, OptionShard)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, shard));
+    TEST_ASSERT_EQUAL(1, UnityFixture.ShardIndex);
+    TEST_ASSERT_EQUAL(3, UnityFixture.ShardCount);
+}
+
+TEST(UnityCommandOptions, OptionShardOutOfRangeFails)
+{
+    const char* args[] = { "testrunner.exe", "--shard", "0/3" };
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, args));
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(3, args));
+    args[2] = "4/3";
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(3, args));
+    args[2] = "3";
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(3, args));
+}
+
+TEST(UnityCommandOptions, EveryTestRunsInExactlyOneShard)
+{
+    static const char* const names[] = {
+        "PointerSetting", "PointerSet", "FreeNULLSafety", "DefaultOptions",
+        "OptionVerbose", "OptionShard", "MultipleOptions", "UnknownCommandIsIgnored"
+    };
+    unsigned int i;
+    unsigned int s;
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        int shards = 0;
+        for (s = 0; s < 3; s++)
+        {
+            UnityFixture.ShardIndex = s;
+            UnityFixture.ShardCount = 3;
+            shards += isSelected("UnityCommandOptions", names[i]);
+        }
+        TEST_ASSERT_EQUAL(1, shards);
+    }
+}
+
 TEST(UnityCommandOptions, GroupOrNameFilterWithoutStringFails)
 {
     TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(3, unknownCommand));
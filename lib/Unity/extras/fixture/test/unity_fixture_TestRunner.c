@@ -27,6 +27,16 @@ TEST_GROUP_RUNNER(UnityCommandOptions)
     RUN_TEST_CASE(UnityCommandOptions, MultipleOptions);
     RUN_TEST_CASE(UnityCommandOptions, MultipleOptionsDashRNotLastAndNoValueSpecified);
     RUN_TEST_CASE(UnityCommandOptions, UnknownCommandIsIgnored);
+    RUN_TEST_CASE(UnityCommandOptions, OptionShuffleWithSeed);
+    RUN_TEST_CASE(UnityCommandOptions, OptionShuffleWithoutSeed);
+    RUN_TEST_CASE(UnityCommandOptions, ShuffleIsAReproduciblePermutation);
+    RUN_TEST_CASE(UnityCommandOptions, FiltersCanBeRepeated);
+    RUN_TEST_CASE(UnityCommandOptions, GlobFiltersMatchWholeName);
+    RUN_TEST_CASE(UnityCommandOptions, ExactFiltersDoNotMatchParts);
+    RUN_TEST_CASE(UnityCommandOptions, FiltersSetDirectlyStillFilter);
+    RUN_TEST_CASE(UnityCommandOptions, OptionShard);
+    RUN_TEST_CASE(UnityCommandOptions, OptionShardOutOfRangeFails);
+    RUN_TEST_CASE(UnityCommandOptions, EveryTestRunsInExactlyOneShard);
     RUN_TEST_CASE(UnityCommandOptions, GroupOrNameFilterWithoutStringFails);
     RUN_TEST_CASE(UnityCommandOptions, GroupFilterReallyFilters);
     RUN_TEST_CASE(UnityCommandOptions, TestShouldBeIgnored);
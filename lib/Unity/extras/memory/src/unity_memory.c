@@ -65,6 +65,78 @@ static size_t unity_size_round_up(size_t size)
     return rounded_size;
 }
 
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+/* Small blocks are rounded up to a power-of-two size class. Each class keeps
+ * a free list threaded through its released blocks, so a block is reused no
+ * matter in which order it was freed. Blocks are carved from unity_heap the
+ * first time a class runs dry, and bigger blocks fall back to the LIFO rules. */
+#define UNITY_POOL_MIN_BLOCK  (2 * sizeof(Guard))
+#define UNITY_POOL_CLASSES    16
+
+typedef struct PoolBlockLink
+{
+    struct PoolBlockLink* next;
+} PoolBlock;
+
+static PoolBlock* pool_free_list[UNITY_POOL_CLASSES];
+static int pool_blocks_in_use; /* unlike malloc_count, not reset per test */
+
+static int unity_pool_class(size_t total_size)
+{
+    size_t class_size = UNITY_POOL_MIN_BLOCK;
+    int pool;
+
+    for (pool = 0; pool < UNITY_POOL_CLASSES; pool++)
+    {
+        if (class_size > UNITY_INTERNAL_HEAP_POOL_MAX_BYTES) break;
+        if (total_size <= class_size) return pool;
+        class_size <<= 1;
+    }
+    return -1;
+}
+
+static size_t unity_pool_block_size(int pool)
+{
+    return UNITY_POOL_MIN_BLOCK << pool;
+}
+#endif
+
+#ifdef UNITY_EXCLUDE_STDLIB_MALLOC
+static Guard* unity_heap_alloc(size_t total_size)
+{
+    Guard* guard;
+
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    int pool = unity_pool_class(total_size);
+
+    if (pool >= 0)
+    {
+        if (pool_free_list[pool] != NULL)
+        {
+            /* We know we can get away with this cast because the block was a Guard before */
+            guard = (Guard*)(void*)pool_free_list[pool];
+            pool_free_list[pool] = pool_free_list[pool]->next;
+            pool_blocks_in_use++;
+            return guard;
+        }
+        total_size = unity_pool_block_size(pool);
+    }
+#endif
+    if (heap_index + total_size > UNITY_INTERNAL_HEAP_SIZE_BYTES)
+    {
+        return NULL;
+    }
+
+    /* We know we can get away with this cast because we aligned memory already */
+    guard = (Guard*)(void*)(&unity_heap[heap_index]);
+    heap_index += total_size;
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    pool_blocks_in_use++;
+#endif
+    return guard;
+}
+#endif
+
 void* unity_malloc(size_t size)
 {
     char* mem;
@@ -82,16 +154,7 @@ void* unity_malloc(size_t size)
 
     if (size == 0) return NULL;
 #ifdef UNITY_EXCLUDE_STDLIB_MALLOC
-    if (heap_index + total_size > UNITY_INTERNAL_HEAP_SIZE_BYTES)
-    {
-        guard = NULL;
-    }
-    else
-    {
-        /* We know we can get away with this cast because we aligned memory already */
-        guard = (Guard*)(void*)(&unity_heap[heap_index]);
-        heap_index += total_size;
-    }
+    guard = unity_heap_alloc(total_size);
 #else
     guard = (Guard*)UNITY_MALLOC(total_size);
 #endif
@@ -126,6 +189,26 @@ static void release_memory(void* mem)
 
         block_size = unity_size_round_up(guard->size + sizeof(end));
 
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+        if (--pool_blocks_in_use == 0)
+        {
+            /* Nothing is outstanding, so the whole heap can be handed out again */
+            memset(pool_free_list, 0, sizeof(pool_free_list));
+            heap_index = 0;
+            return;
+        }
+        {
+            int pool = unity_pool_class(sizeof(Guard) + block_size);
+
+            if (pool >= 0)
+            {
+                PoolBlock* block = (PoolBlock*)(void*)guard;
+                block->next = pool_free_list[pool];
+                pool_free_list[pool] = block;
+                return;
+            }
+        }
+#endif
         if (mem == unity_heap + heap_index - block_size)
         {
             heap_index -= (sizeof(Guard) + block_size);
@@ -183,7 +266,31 @@ void* unity_realloc(void* oldMem, size_t size)
 
     if (guard->size >= size) return oldMem;
 
-#ifdef UNITY_EXCLUDE_STDLIB_MALLOC /* Optimization if memory is expandable */
+#if defined(UNITY_INTERNAL_HEAP_POOLS) /* Optimization if memory is expandable */
+    {
+        size_t old_total_size = unity_size_round_up(guard->size + sizeof(end));
+        size_t new_total_size = unity_size_round_up(size + sizeof(end));
+        int pool = unity_pool_class(sizeof(Guard) + old_total_size);
+        int expandable;
+
+        if (pool >= 0) /* Pooled blocks can grow up to their size class */
+        {
+            expandable = (sizeof(Guard) + new_total_size <= unity_pool_block_size(pool));
+        }
+        else /* Other blocks can grow when they are on top of the heap */
+        {
+            expandable = (oldMem == unity_heap + heap_index - old_total_size) &&
+                         (heap_index - old_total_size + new_total_size <= UNITY_INTERNAL_HEAP_SIZE_BYTES);
+            if (expandable) heap_index = heap_index - old_total_size + new_total_size;
+        }
+        if (expandable)
+        {
+            guard->size = size;
+            memcpy(&((char*)oldMem)[size], end, sizeof(end));
+            return oldMem;
+        }
+    }
+#elif defined(UNITY_EXCLUDE_STDLIB_MALLOC) /* Optimization if memory is expandable */
     {
         size_t old_total_size = unity_size_round_up(guard->size + sizeof(end));
 
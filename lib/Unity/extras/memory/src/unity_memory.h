@@ -24,6 +24,16 @@ extern "C"
     #ifndef UNITY_INTERNAL_HEAP_SIZE_BYTES
     #define UNITY_INTERNAL_HEAP_SIZE_BYTES 256
     #endif
+
+/* Define UNITY_INTERNAL_HEAP_POOLS as well to serve blocks of up to
+ * UNITY_INTERNAL_HEAP_POOL_MAX_BYTES (guard included) from power-of-two size
+ * class pools instead. Freed blocks are reused in any order in O(1), and the
+ * whole heap is recycled whenever every block has been freed. */
+    #ifdef UNITY_INTERNAL_HEAP_POOLS
+    #ifndef UNITY_INTERNAL_HEAP_POOL_MAX_BYTES
+    #define UNITY_INTERNAL_HEAP_POOL_MAX_BYTES (UNITY_INTERNAL_HEAP_SIZE_BYTES / 8)
+    #endif
+    #endif
 #endif
 
 /* These functions are used by Unity to allocate and release memory
@@ -0,0 +1,89 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+/* Times the allocation pattern of allocation-heavy tests. Build it once per
+ * allocator (stdlib, internal heap, internal heap with size class pools) and
+ * compare the ns/op on the PASS lines; see the benchmark target of ../Makefile */
+
+#include "unity.h"
+#include "unity_memory.h"
+#include "unity_benchmark.h"
+
+#define BLOCKS 8
+
+static const size_t block_sizes[BLOCKS] = { 8, 24, 40, 16, 64, 12, 100, 32 };
+
+void setUp(void);
+void tearDown(void);
+void test_BenchmarkMallocFreeLifoOrder(void);
+void test_BenchmarkMallocFreeFifoOrder(void);
+
+void setUp(void)
+{
+    UnityMalloc_StartTest();
+}
+
+void tearDown(void)
+{
+    UnityMalloc_EndTest();
+}
+
+static int churn(int free_in_allocation_order)
+{
+    void* blocks[BLOCKS];
+    int failed = 0;
+    int i;
+
+    for (i = 0; i < BLOCKS; i++)
+    {
+        blocks[i] = malloc(block_sizes[i]);
+        if (blocks[i] == NULL) failed++;
+    }
+    for (i = 0; i < BLOCKS; i++)
+    {
+        free(blocks[free_in_allocation_order ? i : BLOCKS - 1 - i]);
+    }
+    return failed;
+}
+
+void test_BenchmarkMallocFreeLifoOrder(void)
+{
+    void* keep = malloc(10); /* an outstanding block, as in most real tests */
+    int failed = 0;
+
+    TEST_BENCHMARK_BEGIN("lifo churn")
+        failed += churn(0);
+    TEST_BENCHMARK_END();
+    free(keep);
+    TEST_ASSERT_EQUAL_INT(0, failed);
+}
+
+void test_BenchmarkMallocFreeFifoOrder(void)
+{
+    void* keep = malloc(10);
+    int failed = 0;
+
+    TEST_BENCHMARK_BEGIN("fifo churn")
+        failed += churn(1);
+    TEST_BENCHMARK_END();
+    free(keep);
+#if defined(UNITY_EXCLUDE_STDLIB_MALLOC) && !defined(UNITY_INTERNAL_HEAP_POOLS)
+    if (failed != 0)
+    {
+        TEST_IGNORE_MESSAGE("The internal heap strands blocks not freed in LIFO order");
+    }
+#endif
+    TEST_ASSERT_EQUAL_INT(0, failed);
+}
+
+int main(void)
+{
+    UnityBegin("unity_memory_Benchmark.c");
+    RUN_TEST(test_BenchmarkMallocFreeLifoOrder);
+    RUN_TEST(test_BenchmarkMallocFreeFifoOrder);
+    return UnityEnd();
+}
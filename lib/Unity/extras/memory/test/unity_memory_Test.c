@@ -30,6 +30,11 @@ void test_MallocPastBufferFails(void);
 void test_CallocPastBufferFails(void);
 void test_MallocThenReallocGrowsMemoryInPlace(void);
 void test_ReallocFailDoesNotFreeMem(void);
+void test_PoolReusesBlocksFreedOutOfOrder(void);
+void test_PoolSurvivesManyOutOfOrderFrees(void);
+void test_PoolReallocGrowsInPlaceWithinSizeClass(void);
+void test_PoolReallocGrowsLargeBlockOnTopInPlace(void);
+void test_PoolBufferOverrunFoundInReusedBlock(void);
 
 /* It makes use of the following features */
 void setUp(void);
@@ -324,3 +329,109 @@ void test_ReallocFailDoesNotFreeMem(void)
     TEST_IGNORE_MESSAGE("Enable UNITY_EXCLUDE_STDLIB_MALLOC to Run This Test");
 #endif
 }
+
+/*------------------------------------------------------------ */
+
+void test_PoolReusesBlocksFreedOutOfOrder(void)
+{
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    void* keep = malloc(10);
+    void* first = malloc(10);
+    void* second = malloc(10);
+    void* reused;
+
+    free(first);
+    reused = malloc(12);
+    free(second);
+    free(reused);
+    free(keep);
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL_PTR(first, reused);
+#else
+    TEST_IGNORE_MESSAGE("Enable UNITY_INTERNAL_HEAP_POOLS to Run This Test");
+#endif
+}
+
+void test_PoolSurvivesManyOutOfOrderFrees(void)
+{
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    void* keep = malloc(10);
+    int i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        void* a = malloc(10);
+        void* b = malloc(20);
+        free(a);
+        a = malloc(5);
+        free(b);
+        free(a);
+        TEST_ASSERT_NOT_NULL(a);
+        TEST_ASSERT_NOT_NULL(b);
+    }
+    free(keep);
+#else
+    TEST_IGNORE_MESSAGE("Enable UNITY_INTERNAL_HEAP_POOLS to Run This Test");
+#endif
+}
+
+void test_PoolReallocGrowsInPlaceWithinSizeClass(void)
+{
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    void* m = malloc(1);
+    void* other = malloc(1);
+    void* n = realloc(m, 2);
+
+    free(other);
+    free(n);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL_PTR(m, n);
+#else
+    TEST_IGNORE_MESSAGE("Enable UNITY_INTERNAL_HEAP_POOLS to Run This Test");
+#endif
+}
+
+void test_PoolReallocGrowsLargeBlockOnTopInPlace(void)
+{
+#ifdef UNITY_INTERNAL_HEAP_POOLS
+    void* small = malloc(1);
+    char* m = (char*)malloc(UNITY_INTERNAL_HEAP_POOL_MAX_BYTES);
+    char* n;
+
+    TEST_ASSERT_NOT_NULL(m);
+    strcpy(m, "123456789");
+    free(small);
+    n = (char*)realloc(m, UNITY_INTERNAL_HEAP_POOL_MAX_BYTES + 8);
+    free(n);
+    TEST_ASSERT_EQUAL_PTR(m, n);
+    TEST_ASSERT_EQUAL_STRING("123456789", n);
+#else
+    TEST_IGNORE_MESSAGE("Enable UNITY_INTERNAL_HEAP_POOLS to Run This Test");
+#endif
+}
+
+void test_PoolBufferOverrunFoundInReusedBlock(void)
+{
+#if defined(UNITY_INTERNAL_HEAP_POOLS) && defined(USING_OUTPUT_SPY)
+    void* keep = malloc(10);
+    void* m = malloc(10);
+    char* s;
+
+    free(m);
+    m = malloc(10);
+    s = (char*)m;
+    TEST_ASSERT_NOT_NULL(m);
+    s[10] = (char)0xFF;
+    UnityOutputCharSpy_Enable(1);
+    EXPECT_ABORT_BEGIN
+    free(m);
+    EXPECT_ABORT_END
+    UnityOutputCharSpy_Enable(0);
+    free(keep);
+    Unity.CurrentTestFailed = 0;
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "Buffer overrun detected during free()"));
+#else
+    TEST_IGNORE_MESSAGE("Enable UNITY_INTERNAL_HEAP_POOLS and USING_OUTPUT_SPY To Run This Test");
+#endif
+}
@@ -25,6 +25,11 @@ extern void test_MallocPastBufferFails(void);
 extern void test_CallocPastBufferFails(void);
 extern void test_MallocThenReallocGrowsMemoryInPlace(void);
 extern void test_ReallocFailDoesNotFreeMem(void);
+extern void test_PoolReusesBlocksFreedOutOfOrder(void);
+extern void test_PoolSurvivesManyOutOfOrderFrees(void);
+extern void test_PoolReallocGrowsInPlaceWithinSizeClass(void);
+extern void test_PoolReallocGrowsLargeBlockOnTopInPlace(void);
+extern void test_PoolBufferOverrunFoundInReusedBlock(void);
 
 int main(void)
 {
@@ -46,5 +51,10 @@ int main(void)
     RUN_TEST(test_CallocPastBufferFails);
     RUN_TEST(test_MallocThenReallocGrowsMemoryInPlace);
     RUN_TEST(test_ReallocFailDoesNotFreeMem);
+    RUN_TEST(test_PoolReusesBlocksFreedOutOfOrder);
+    RUN_TEST(test_PoolSurvivesManyOutOfOrderFrees);
+    RUN_TEST(test_PoolReallocGrowsInPlaceWithinSizeClass);
+    RUN_TEST(test_PoolReallocGrowsLargeBlockOnTopInPlace);
+    RUN_TEST(test_PoolBufferOverrunFoundInReusedBlock);
     return UnityEnd();
 }
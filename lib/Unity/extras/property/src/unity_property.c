@@ -0,0 +1,352 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+/* A property is run many times on values drawn from a seeded xoshiro128**
+ * generator. Each draw is recorded as a choice, so a failing case is just a
+ * list of numbers: it is shrunk by deleting choices and making them smaller,
+ * replaying the property each time, until no smaller list still fails. */
+
+#include "unity.h"
+#include "unity_property.h"
+#include <string.h>
+
+static UNITY_UINT32 seed = UNITY_PROPERTY_DEFAULT_SEED;
+static UNITY_UINT32 rng[4];
+
+static UNITY_UINT32 choices[UNITY_PROPERTY_MAX_CHOICES];
+static int choiceCount;   /* choices available to a replay */
+static int cursor;        /* choices drawn so far by the current run */
+static int replaying;
+static int noting;
+
+static UNITY_UINT32 candidate[UNITY_PROPERTY_MAX_CHOICES];
+static UNITY_PROPERTY_RESULT_T result;
+
+static char message[UNITY_PROPERTY_MESSAGE_LENGTH];
+static size_t messageLength;
+
+/*-----------------------------------------------*/
+
+static UNITY_UINT32 Rotl(const UNITY_UINT32 x, const int k)
+{
+    return (UNITY_UINT32)((x << k) | (x >> (32 - k)));
+}
+
+static UNITY_UINT32 SplitMix(UNITY_UINT32* state)
+{
+    UNITY_UINT32 z;
+    *state = (UNITY_UINT32)(*state + 0x9E3779B9UL);
+    z = *state;
+    z = (UNITY_UINT32)((z ^ (z >> 16)) * 0x85EBCA6BUL);
+    z = (UNITY_UINT32)((z ^ (z >> 13)) * 0xC2B2AE35UL);
+    return (UNITY_UINT32)(z ^ (z >> 16));
+}
+
+static void Reseed(void)
+{
+    UNITY_UINT32 state = seed;
+    int i;
+    for (i = 0; i < 4; i++)
+        rng[i] = SplitMix(&state);
+}
+
+UNITY_UINT32 UnityPropertyRandom(void)
+{
+    const UNITY_UINT32 value = (UNITY_UINT32)(Rotl((UNITY_UINT32)(rng[1] * 5UL), 7) * 9UL);
+    const UNITY_UINT32 t = (UNITY_UINT32)(rng[1] << 9);
+
+    rng[2] ^= rng[0];
+    rng[3] ^= rng[1];
+    rng[1] ^= rng[2];
+    rng[0] ^= rng[3];
+    rng[2] ^= t;
+    rng[3] = Rotl(rng[3], 11);
+    return value;
+}
+
+void UnityPropertySetSeed(const UNITY_UINT32 newSeed)
+{
+    seed = newSeed;
+}
+
+UNITY_UINT32 UnityPropertySeed(void)
+{
+    return seed;
+}
+
+/*-----------------------------------------------*/
+
+UNITY_UINT32 UnityPropertyChoose(const UNITY_UINT32 count)
+{
+    UNITY_UINT32 value;
+
+    if (count == 1)
+        return 0;
+    if (cursor >= UNITY_PROPERTY_MAX_CHOICES)
+        return 0;
+    if (replaying)
+    {
+        value = (cursor < choiceCount) ? choices[cursor] : 0;
+        if (count != 0)
+            value %= count;
+    }
+    else
+    {
+        value = UnityPropertyRandom();
+        if (count != 0)
+            value %= count;
+    }
+    choices[cursor++] = value;
+    return value;
+}
+
+int UnityPropertyIntBetween(const int min, const int max)
+{
+    if (max <= min)
+        return min;
+    return (int)((UNITY_UINT32)min +
+                 UnityPropertyChoose((UNITY_UINT32)((UNITY_UINT32)max - (UNITY_UINT32)min + 1UL)));
+}
+
+int UnityPropertyOneIn(const UNITY_UINT32 count)
+{
+    if (count <= 1)
+        return 1;
+    return UnityPropertyChoose(count) == (count - 1);
+}
+
+/*-----------------------------------------------*/
+
+static void MessageAppend(const char* str)
+{
+    while ((*str != '\0') && (messageLength < (UNITY_PROPERTY_MESSAGE_LENGTH - 1)))
+        message[messageLength++] = *str++;
+    message[messageLength] = '\0';
+}
+
+static void MessageAppendUnsigned(UNITY_UINT32 number)
+{
+    char digits[12];
+    int i = (int)sizeof(digits) - 1;
+    digits[i] = '\0';
+    do
+    {
+        digits[--i] = (char)('0' + (number % 10));
+        number /= 10;
+    } while ((number > 0) && (i > 0));
+    MessageAppend(&digits[i]);
+}
+
+void UnityPropertyNote(const char* note)
+{
+    if (noting && (note != NULL))
+        MessageAppend(note);
+}
+
+void UnityPropertyNoteInt(const int number)
+{
+    if (!noting)
+        return;
+    if (number < 0)
+    {
+        MessageAppend("-");
+        MessageAppendUnsigned((UNITY_UINT32)0 - (UNITY_UINT32)number);
+    }
+    else
+    {
+        MessageAppendUnsigned((UNITY_UINT32)number);
+    }
+}
+
+/*-----------------------------------------------*/
+
+/* Runs the property on the given choices and, when it still fails, keeps
+ * the choices it actually drew as the new smallest case */
+static int FailsWith(UnityPropertyFunction property, const UNITY_UINT32* values, const int count)
+{
+    int used;
+
+    if (result.ShrinkRuns >= UNITY_PROPERTY_MAX_SHRINK_RUNS)
+        return 0;
+    result.ShrinkRuns++;
+
+    memcpy(choices, values, (size_t)count * sizeof(UNITY_UINT32));
+    choiceCount = count;
+    cursor = 0;
+    replaying = 1;
+    if (property())
+        return 0;
+
+    used = (cursor < count) ? cursor : count;
+    memcpy(result.Choices, choices, (size_t)used * sizeof(UNITY_UINT32));
+    result.ChoiceCount = used;
+    return 1;
+}
+
+static int DeleteChunks(UnityPropertyFunction property)
+{
+    int improved = 0;
+    int size;
+    int i;
+
+    for (size = 8; size > 0; size /= 2)
+    {
+        for (i = result.ChoiceCount - size; i >= 0; i--)
+        {
+            if (i + size > result.ChoiceCount)
+                continue;
+            memcpy(candidate, result.Choices, (size_t)i * sizeof(UNITY_UINT32));
+            memcpy(&candidate[i], &result.Choices[i + size],
+                   (size_t)(result.ChoiceCount - i - size) * sizeof(UNITY_UINT32));
+            if (FailsWith(property, candidate, result.ChoiceCount - size))
+                improved = 1;
+        }
+    }
+    return improved;
+}
+
+static int MinimizeChoices(UnityPropertyFunction property)
+{
+    int improved = 0;
+    int i;
+
+    for (i = 0; i < result.ChoiceCount; i++)
+    {
+        UNITY_UINT32 low = 0;
+        UNITY_UINT32 high = result.Choices[i];
+
+        /* Bisect for the smallest value that still fails; everything from
+         * high up is known to fail, so only the values below are tried */
+        while ((low < high) && (i < result.ChoiceCount))
+        {
+            const UNITY_UINT32 mid = (low == 0) ? 0 : low + (high - low) / 2;
+            memcpy(candidate, result.Choices, (size_t)result.ChoiceCount * sizeof(UNITY_UINT32));
+            candidate[i] = mid;
+            if (FailsWith(property, candidate, result.ChoiceCount))
+            {
+                high = mid;
+                improved = 1;
+            }
+            else
+            {
+                low = mid + 1;
+            }
+        }
+    }
+    return improved;
+}
+
+static void Shrink(UnityPropertyFunction property)
+{
+    int improved = 1;
+
+    while (improved && (result.ShrinkRuns < UNITY_PROPERTY_MAX_SHRINK_RUNS))
+    {
+        improved = DeleteChunks(property);
+        improved |= MinimizeChoices(property);
+    }
+}
+
+/*-----------------------------------------------*/
+
+int UnityPropertyCheck(UnityPropertyFunction property, const UNITY_UINT32 runs)
+{
+    UNITY_UINT32 run;
+
+    memset(&result, 0, sizeof(result));
+    Reseed();
+    noting = 0;
+
+    for (run = 1; run <= runs; run++)
+    {
+        cursor = 0;
+        replaying = 0;
+        if (!property())
+        {
+            result.Runs = run;
+            result.Failed = 1;
+            result.ChoiceCount = cursor;
+            memcpy(result.Choices, choices, (size_t)cursor * sizeof(UNITY_UINT32));
+            Shrink(property);
+            replaying = 0;
+            return 0;
+        }
+    }
+    result.Runs = runs;
+    replaying = 0;
+    return 1;
+}
+
+int UnityPropertyReplay(UnityPropertyFunction property, const UNITY_UINT32* values, const int count)
+{
+    int holds;
+
+    memcpy(choices, values, (size_t)count * sizeof(UNITY_UINT32));
+    choiceCount = count;
+    cursor = 0;
+    replaying = 1;
+    holds = property();
+    replaying = 0;
+    return holds;
+}
+
+const UNITY_PROPERTY_RESULT_T* UnityPropertyLastResult(void)
+{
+    return &result;
+}
+
+/*-----------------------------------------------*/
+
+void UnityAssertProperty(UnityPropertyFunction property,
+                         const char* name,
+                         const UNITY_UINT32 runs,
+                         const char* msg,
+                         const UNITY_LINE_TYPE line)
+{
+    size_t notesStart;
+    int i;
+
+    if (Unity.CurrentTestFailed || Unity.CurrentTestIgnored)
+        return;
+    if (UnityPropertyCheck(property, runs))
+        return;
+
+    messageLength = 0;
+    message[0] = '\0';
+    MessageAppend("Property '");
+    MessageAppend(name);
+    MessageAppend("' Failed On Run ");
+    MessageAppendUnsigned(result.Runs);
+    MessageAppend(" Of ");
+    MessageAppendUnsigned(runs);
+    MessageAppend(" With Seed ");
+    MessageAppendUnsigned(seed);
+    MessageAppend(". Smallest Case: ");
+
+    /* Run the smallest case once more so the property can describe it */
+    notesStart = messageLength;
+    memcpy(candidate, result.Choices, (size_t)result.ChoiceCount * sizeof(UNITY_UINT32));
+    noting = 1;
+    (void)UnityPropertyReplay(property, candidate, result.ChoiceCount);
+    noting = 0;
+    if (messageLength == notesStart)
+    {
+        MessageAppend("choices");
+        for (i = 0; i < result.ChoiceCount; i++)
+        {
+            MessageAppend(" ");
+            MessageAppendUnsigned(result.Choices[i]);
+        }
+    }
+
+    if (msg != NULL)
+    {
+        MessageAppend(". ");
+        MessageAppend(msg);
+    }
+    UnityFail(message, line);
+}
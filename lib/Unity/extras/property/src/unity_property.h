@@ -0,0 +1,86 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#ifndef UNITY_PROPERTY_H_
+#define UNITY_PROPERTY_H_
+
+#include "unity.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Every value a property draws is recorded, so that a failing case can be
+ * replayed and shrunk. Draws past this many return the smallest value. */
+#ifndef UNITY_PROPERTY_MAX_CHOICES
+#define UNITY_PROPERTY_MAX_CHOICES 256
+#endif
+
+/* How many times a failing property may be run while looking for a
+ * smaller case that still fails */
+#ifndef UNITY_PROPERTY_MAX_SHRINK_RUNS
+#define UNITY_PROPERTY_MAX_SHRINK_RUNS 20000
+#endif
+
+#ifndef UNITY_PROPERTY_MESSAGE_LENGTH
+#define UNITY_PROPERTY_MESSAGE_LENGTH 512
+#endif
+
+#ifndef UNITY_PROPERTY_DEFAULT_SEED
+#define UNITY_PROPERTY_DEFAULT_SEED 0x2545F491UL
+#endif
+
+/* A property returns nonzero when it holds for the values it drew. It must
+ * not use TEST_ASSERT, which would end the test before the case is shrunk,
+ * and it must set up whatever state it checks on every run. */
+typedef int (*UnityPropertyFunction)(void);
+
+typedef struct UNITY_PROPERTY_RESULT_T
+{
+    UNITY_UINT32 Runs;        /* cases tried, including the failing one */
+    UNITY_UINT32 ShrinkRuns;  /* replays spent shrinking */
+    int Failed;
+    int ChoiceCount;          /* of the smallest failing case */
+    UNITY_UINT32 Choices[UNITY_PROPERTY_MAX_CHOICES];
+} UNITY_PROPERTY_RESULT_T;
+
+void UnityPropertySetSeed(const UNITY_UINT32 seed);
+UNITY_UINT32 UnityPropertySeed(void);
+
+/* Generators, all drawing from the case being run */
+UNITY_UINT32 UnityPropertyRandom(void);                      /* not recorded, so never shrunk */
+UNITY_UINT32 UnityPropertyChoose(const UNITY_UINT32 count);  /* 0 .. count - 1 (any value for 0), shrinks towards 0 */
+int UnityPropertyIntBetween(const int min, const int max);   /* shrinks towards min */
+int UnityPropertyOneIn(const UNITY_UINT32 count);            /* true once in count, shrinks to false */
+
+/* Text added to the failure message when the smallest case is run again */
+void UnityPropertyNote(const char* note);
+void UnityPropertyNoteInt(const int number);
+
+int UnityPropertyCheck(UnityPropertyFunction property, const UNITY_UINT32 runs);
+int UnityPropertyReplay(UnityPropertyFunction property, const UNITY_UINT32* choices, const int count);
+const UNITY_PROPERTY_RESULT_T* UnityPropertyLastResult(void);
+
+void UnityAssertProperty(UnityPropertyFunction property,
+                         const char* name,
+                         const UNITY_UINT32 runs,
+                         const char* msg,
+                         const UNITY_LINE_TYPE line);
+
+/*-------------------------------------------------------
+ * Property Asserts
+ *-------------------------------------------------------*/
+
+#define TEST_ASSERT_PROPERTY(property, runs)                      UnityAssertProperty((property), #property, (runs), NULL, __LINE__)
+#define TEST_ASSERT_PROPERTY_MESSAGE(property, runs, message)     UnityAssertProperty((property), #property, (runs), (message), __LINE__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UNITY_PROPERTY_H_ */
@@ -0,0 +1,225 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_property.h"
+#include "unity_output_Spy.h"
+#include <string.h>
+
+/* This test module includes the following tests: */
+
+void test_PassingPropertyRunsEveryCase(void);
+void test_SameSeedDrawsSameValues(void);
+void test_DrawsStayInRange(void);
+void test_FailingCaseIsShrunkToTheSmallest(void);
+void test_ShrinkingDeletesUnneededDraws(void);
+void test_AssertPropertyReportsTheSmallestCase(void);
+void test_AssertPropertyListsChoicesWithoutNotes(void);
+void test_ReplayRunsTheGivenChoices(void);
+
+/* It makes use of the following features */
+void setUp(void);
+void tearDown(void);
+
+static int propertyRuns;
+
+/* Let's Go! */
+void setUp(void)
+{
+    propertyRuns = 0;
+    UnityPropertySetSeed(UNITY_PROPERTY_DEFAULT_SEED);
+    UnityOutputCharSpy_Create(1000);
+}
+
+void tearDown(void)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+#define EXPECT_ABORT_BEGIN \
+  { \
+    jmp_buf TestAbortFrame;   \
+    UNITY_COUNTER_TYPE failed; \
+    memcpy(TestAbortFrame, Unity.AbortFrame, sizeof(jmp_buf)); \
+    UnityOutputCharSpy_Enable(1); \
+    if (TEST_PROTECT()) \
+    {
+
+#define EXPECT_ABORT_END \
+    } \
+    UnityOutputCharSpy_Enable(0); \
+    memcpy(Unity.AbortFrame, TestAbortFrame, sizeof(jmp_buf)); \
+    failed = Unity.CurrentTestFailed; \
+    Unity.CurrentTestFailed = 0; \
+    TEST_ASSERT_EQUAL_MESSAGE(1, failed, "Expected the assertion to fail"); \
+  }
+
+/* Properties used by the tests */
+
+static int alwaysHolds(void)
+{
+    propertyRuns++;
+    (void)UnityPropertyChoose(10);
+    return 1;
+}
+
+/* Fails when a list of up to 20 numbers holds one above 500; the smallest
+ * failing case is a list of one element, 501 */
+static int noElementAbove500(void)
+{
+    const int length = UnityPropertyIntBetween(0, 20);
+    int i;
+
+    for (i = 0; i < length; i++)
+    {
+        const int element = UnityPropertyIntBetween(-1000, 1000);
+        if (element > 500)
+        {
+            UnityPropertyNote("[");
+            UnityPropertyNoteInt(length);
+            UnityPropertyNote(" elements, ");
+            UnityPropertyNoteInt(element);
+            UnityPropertyNote("]");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Fails once a coin shows heads three times in a row */
+static int neverThreeHeads(void)
+{
+    int heads = 0;
+    int i;
+
+    for (i = 0; i < 30; i++)
+    {
+        heads = UnityPropertyOneIn(2) ? heads + 1 : 0;
+        if (heads == 3)
+            return 0;
+    }
+    return 1;
+}
+
+static int smallSums(void)
+{
+    const UNITY_UINT32 a = UnityPropertyChoose(100);
+    const UNITY_UINT32 b = UnityPropertyChoose(100);
+    return (a + b) < 150;
+}
+
+/* The tests */
+
+void test_PassingPropertyRunsEveryCase(void)
+{
+    TEST_ASSERT_TRUE(UnityPropertyCheck(alwaysHolds, 500));
+    TEST_ASSERT_EQUAL_INT(500, propertyRuns);
+    TEST_ASSERT_EQUAL_UINT32(500, UnityPropertyLastResult()->Runs);
+    TEST_ASSERT_FALSE(UnityPropertyLastResult()->Failed);
+
+    TEST_ASSERT_PROPERTY(alwaysHolds, 10);
+    TEST_ASSERT_EQUAL_INT(510, propertyRuns);
+}
+
+void test_SameSeedDrawsSameValues(void)
+{
+    UNITY_UINT32 first[8];
+    UNITY_UINT32 second[8];
+    int i;
+
+    UnityPropertySetSeed(42);
+    TEST_ASSERT_FALSE(UnityPropertyCheck(smallSums, 1000));
+    memcpy(first, UnityPropertyLastResult()->Choices, sizeof(first[0]) * 2);
+    first[2] = UnityPropertyLastResult()->Runs;
+
+    UnityPropertySetSeed(42);
+    TEST_ASSERT_FALSE(UnityPropertyCheck(smallSums, 1000));
+    memcpy(second, UnityPropertyLastResult()->Choices, sizeof(second[0]) * 2);
+    second[2] = UnityPropertyLastResult()->Runs;
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(first, second, 3);
+
+    UnityPropertySetSeed(43);
+    for (i = 0; i < 8; i++)
+        first[i] = UnityPropertyRandom();
+    UnityPropertySetSeed(44);
+    for (i = 0; i < 8; i++)
+        second[i] = UnityPropertyRandom();
+    TEST_ASSERT_FALSE(memcmp(first, second, sizeof(first)) == 0);
+}
+
+static int drawsInRange(void)
+{
+    const int value = UnityPropertyIntBetween(-3, 3);
+    const UNITY_UINT32 choice = UnityPropertyChoose(7);
+    return (value >= -3) && (value <= 3) && (choice < 7) &&
+           (UnityPropertyIntBetween(5, 5) == 5) && (UnityPropertyChoose(1) == 0);
+}
+
+void test_DrawsStayInRange(void)
+{
+    TEST_ASSERT_PROPERTY(drawsInRange, 10000);
+}
+
+void test_FailingCaseIsShrunkToTheSmallest(void)
+{
+    const UNITY_PROPERTY_RESULT_T* result;
+
+    TEST_ASSERT_FALSE(UnityPropertyCheck(noElementAbove500, 1000));
+    result = UnityPropertyLastResult();
+
+    TEST_ASSERT_TRUE(result->Failed);
+    TEST_ASSERT_TRUE(result->ShrinkRuns > 0);
+    TEST_ASSERT_EQUAL_INT(2, result->ChoiceCount);
+    TEST_ASSERT_EQUAL_UINT32(1, result->Choices[0]);          /* length 1 */
+    TEST_ASSERT_EQUAL_UINT32(1000 + 501, result->Choices[1]); /* element 501 */
+
+    TEST_ASSERT_FALSE(UnityPropertyCheck(smallSums, 1000));
+    result = UnityPropertyLastResult();
+    TEST_ASSERT_EQUAL_INT(2, result->ChoiceCount);
+    TEST_ASSERT_EQUAL_UINT32(150, result->Choices[0] + result->Choices[1]);
+}
+
+void test_ShrinkingDeletesUnneededDraws(void)
+{
+    static const UNITY_UINT32 threeHeads[3] = { 1, 1, 1 };
+
+    TEST_ASSERT_FALSE(UnityPropertyCheck(neverThreeHeads, 1000));
+    TEST_ASSERT_EQUAL_INT(3, UnityPropertyLastResult()->ChoiceCount);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(threeHeads, UnityPropertyLastResult()->Choices, 3);
+}
+
+void test_AssertPropertyReportsTheSmallestCase(void)
+{
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_PROPERTY_MESSAGE(noElementAbove500, 1000, "bounded lists");
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        "Property 'noElementAbove500' Failed On Run "));
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(),
+        " Of 1000 With Seed 625341585. Smallest Case: [1 elements, 501]. bounded lists"));
+}
+
+void test_AssertPropertyListsChoicesWithoutNotes(void)
+{
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_PROPERTY(neverThreeHeads, 1000);
+    EXPECT_ABORT_END
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "Smallest Case: choices 1 1 1"));
+}
+
+void test_ReplayRunsTheGivenChoices(void)
+{
+    static const UNITY_UINT32 passing[4] = { 3, 0, 1000, 1500 };
+    static const UNITY_UINT32 failing[2] = { 1, 1700 };
+    static const UNITY_UINT32 tooShort[1] = { 5 };
+
+    TEST_ASSERT_TRUE(UnityPropertyReplay(noElementAbove500, passing, 4));
+    TEST_ASSERT_FALSE(UnityPropertyReplay(noElementAbove500, failing, 2));
+    /* Draws past the given choices are the smallest value, -1000 here */
+    TEST_ASSERT_TRUE(UnityPropertyReplay(noElementAbove500, tooShort, 1));
+}
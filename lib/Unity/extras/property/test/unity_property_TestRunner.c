@@ -0,0 +1,32 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_property.h"
+
+extern void test_PassingPropertyRunsEveryCase(void);
+extern void test_SameSeedDrawsSameValues(void);
+extern void test_DrawsStayInRange(void);
+extern void test_FailingCaseIsShrunkToTheSmallest(void);
+extern void test_ShrinkingDeletesUnneededDraws(void);
+extern void test_AssertPropertyReportsTheSmallestCase(void);
+extern void test_AssertPropertyListsChoicesWithoutNotes(void);
+extern void test_ReplayRunsTheGivenChoices(void);
+
+int main(void)
+{
+    UnityBegin("unity_property_Test.c");
+    RUN_TEST(test_PassingPropertyRunsEveryCase);
+    RUN_TEST(test_SameSeedDrawsSameValues);
+    RUN_TEST(test_DrawsStayInRange);
+    RUN_TEST(test_FailingCaseIsShrunkToTheSmallest);
+    RUN_TEST(test_ShrinkingDeletesUnneededDraws);
+    RUN_TEST(test_AssertPropertyReportsTheSmallestCase);
+    RUN_TEST(test_AssertPropertyListsChoicesWithoutNotes);
+    RUN_TEST(test_ReplayRunsTheGivenChoices);
+    return UnityEnd();
+}
@@ -0,0 +1,185 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_registry.h"
+#include <string.h>
+
+#ifdef UNITY_REGISTRY_USE_SECTION
+
+/* The linker defines these around the section. They are weak so that a
+ * program without any registered test still links, with an empty table. */
+extern const UNITY_REGISTERED_TEST_T* __start_unity_registry[] __attribute__((weak));
+extern const UNITY_REGISTERED_TEST_T* __stop_unity_registry[] __attribute__((weak));
+
+#define RegisteredTests __start_unity_registry
+#define RegisteredCount ((int)(__stop_unity_registry - __start_unity_registry))
+
+#else
+
+static const UNITY_REGISTERED_TEST_T* RegisteredTests[UNITY_REGISTRY_MAX_TESTS];
+static int RegisteredCount = 0;
+static int RegistryOverflow = 0;
+
+/* Reported as a failing test, since the tests that did not fit are not run */
+static void RegistryOverflowed(void)
+{
+    TEST_FAIL_MESSAGE("More tests than UNITY_REGISTRY_MAX_TESTS were registered");
+}
+
+void UnityRegistryAdd(const UNITY_REGISTERED_TEST_T* test)
+{
+    if (RegisteredCount < UNITY_REGISTRY_MAX_TESTS)
+    {
+        RegisteredTests[RegisteredCount++] = test;
+    }
+    else
+    {
+        RegistryOverflow = 1;
+    }
+}
+
+#endif
+
+static int RegistrySorted = 0;
+
+/*-----------------------------------------------*/
+/* The tests of one file are next to each other in the table, but optimizing
+ * compilers often emit them backwards. Put each file back in source order:
+ * reverse the files that came out backwards, then an insertion sort only
+ * has the odd misplaced test left to move. */
+static void RegistrySortFiles(const UNITY_REGISTERED_TEST_T** tests, const int count)
+{
+    int first = 0;
+
+    while (first < count)
+    {
+        int last = first + 1;
+        int i;
+        while ((last < count) && (strcmp(tests[last]->File, tests[first]->File) == 0))
+        {
+            last++;
+        }
+
+        if ((last - first > 1) && (tests[first]->Line > tests[last - 1]->Line))
+        {
+            for (i = 0; i < (last - first) / 2; i++)
+            {
+                const UNITY_REGISTERED_TEST_T* swap = tests[first + i];
+                tests[first + i] = tests[last - 1 - i];
+                tests[last - 1 - i] = swap;
+            }
+        }
+        for (i = first + 1; i < last; i++)
+        {
+            const UNITY_REGISTERED_TEST_T* test = tests[i];
+            int j = i;
+            while ((j > first) && (tests[j - 1]->Line > test->Line))
+            {
+                tests[j] = tests[j - 1];
+                j--;
+            }
+            tests[j] = test;
+        }
+        first = last;
+    }
+}
+
+/*-----------------------------------------------*/
+int UnityRegistryCount(void)
+{
+    if (!RegistrySorted)
+    {
+        RegistrySortFiles(RegisteredTests, RegisteredCount);
+        RegistrySorted = 1;
+    }
+    return RegisteredCount;
+}
+
+/*-----------------------------------------------*/
+const UNITY_REGISTERED_TEST_T* UnityRegistryTest(const int index)
+{
+    return (index < UnityRegistryCount()) ? RegisteredTests[index] : NULL;
+}
+
+/*-----------------------------------------------*/
+void UnityRegistryRun(const int index)
+{
+    const UNITY_REGISTERED_TEST_T* test = UnityRegistryTest(index);
+
+    if (test == NULL)
+    {
+        return;
+    }
+    UnitySetTestFile(test->File);
+#ifdef UNITY_USE_COMMAND_LINE_ARGS
+    Unity.CurrentTestName = test->Name;
+    Unity.CurrentTestLineNumber = test->Line;
+    if (!UnityTestMatches())
+    {
+        return;
+    }
+#endif
+    UnityDefaultTestRun(test->Func, test->Name, (int)test->Line);
+}
+
+/*-----------------------------------------------*/
+/* Lists the tests as generated runners do, under the name of their file */
+void UnityRegistryList(void)
+{
+    const char* file = NULL;
+    int i;
+
+    for (i = 0; i < UnityRegistryCount(); i++)
+    {
+        const UNITY_REGISTERED_TEST_T* test = UnityRegistryTest(i);
+        if (test->File != file)
+        {
+            file = test->File;
+            UnityPrint(file);
+            UnityPrint(".");
+            UNITY_PRINT_EOL();
+        }
+        UnityPrint("  ");
+        UnityPrint(test->Name);
+        UNITY_PRINT_EOL();
+    }
+}
+
+/*-----------------------------------------------*/
+int UnityRegistryMain(int argc, char** argv)
+{
+    int i;
+#ifdef UNITY_USE_COMMAND_LINE_ARGS
+    int parse_status = UnityParseOptions(argc, argv);
+    if (parse_status != 0)
+    {
+        if (parse_status < 0)
+        {
+            UnityRegistryList();
+            return 0;
+        }
+        return parse_status;
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    UnityBegin((UnityRegistryCount() > 0) ? UnityRegistryTest(0)->File : "");
+#ifdef UNITY_REGISTRY_USE_CONSTRUCTORS
+    if (RegistryOverflow)
+    {
+        UnityDefaultTestRun(RegistryOverflowed, "UnityRegistryMain", __LINE__);
+    }
+#endif
+    for (i = 0; i < UnityRegistryCount(); i++)
+    {
+        UnityRegistryRun(i);
+    }
+    return UnityEnd();
+}
@@ -0,0 +1,87 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#ifndef UNITY_REGISTRY_H_
+#define UNITY_REGISTRY_H_
+
+#include "unity.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct UNITY_REGISTERED_TEST_T
+{
+    const char* Name;
+    UnityTestFunction Func;
+    const char* File;
+    UNITY_LINE_TYPE Line;
+} UNITY_REGISTERED_TEST_T;
+
+/* ELF targets collect a pointer to every registered test in one linker
+ * section, so the table exists before main() without running any code.
+ * Elsewhere each test adds itself to a fixed table from a constructor. */
+#if !defined(UNITY_REGISTRY_USE_SECTION) && !defined(UNITY_REGISTRY_USE_CONSTRUCTORS)
+#if defined(__GNUC__) && defined(__ELF__)
+#define UNITY_REGISTRY_USE_SECTION
+#elif defined(__GNUC__)
+#define UNITY_REGISTRY_USE_CONSTRUCTORS
+#else
+#error "unity_registry needs GCC or clang; list the tests with RUN_TEST or generate_test_runner.rb instead"
+#endif
+#endif
+
+/* The most tests a program can register through constructors */
+#ifndef UNITY_REGISTRY_MAX_TESTS
+#define UNITY_REGISTRY_MAX_TESTS 512
+#endif
+
+int UnityRegistryCount(void);
+const UNITY_REGISTERED_TEST_T* UnityRegistryTest(const int index);
+void UnityRegistryRun(const int index);
+void UnityRegistryList(void);
+int UnityRegistryMain(int argc, char** argv);
+
+#ifdef UNITY_REGISTRY_USE_CONSTRUCTORS
+void UnityRegistryAdd(const UNITY_REGISTERED_TEST_T* test);
+#endif
+
+/*-------------------------------------------------------
+ * Registering Tests
+ *-------------------------------------------------------
+ * Use REGISTER_TEST(name) in place of "void name(void)" when defining a test:
+ *
+ *     REGISTER_TEST(test_turn_on_one_led)
+ *     {
+ *         ...
+ *     }
+ *
+ * and let main() return UnityRegistryMain(argc, argv). */
+
+#ifdef UNITY_REGISTRY_USE_SECTION
+#define UNITY_REGISTRY_ENTRY(entry)                                                  \
+    static const UNITY_REGISTERED_TEST_T* entry##_Pointer                           \
+        __attribute__((used, section("unity_registry"))) = &entry;
+#else
+#define UNITY_REGISTRY_ENTRY(entry)                                                  \
+    static void entry##_Register(void) __attribute__((constructor));                 \
+    static void entry##_Register(void) { UnityRegistryAdd(&entry); }
+#endif
+
+#define REGISTER_TEST(name)                                                          \
+    void name(void);                                                                 \
+    static const UNITY_REGISTERED_TEST_T UnityRegistered_##name =                   \
+        { #name, name, __FILE__, (UNITY_LINE_TYPE)__LINE__ };                        \
+    UNITY_REGISTRY_ENTRY(UnityRegistered_##name)                                     \
+    void name(void)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UNITY_REGISTRY_H_ */
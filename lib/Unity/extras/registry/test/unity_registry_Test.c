@@ -0,0 +1,115 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_registry.h"
+#include "unity_output_Spy.h"
+#include <string.h>
+
+/* Every test is registered, including one in unity_registry_TestInAnotherFile.c,
+ * and unity_registry_TestRunner.c runs them through UnityRegistryMain */
+#define REGISTERED_TEST_COUNT 7
+
+void setUp(void);
+void tearDown(void);
+
+static int setUpRan;
+
+void setUp(void)
+{
+    setUpRan = 1;
+    UnityOutputCharSpy_Create(1000);
+}
+
+void tearDown(void)
+{
+    setUpRan = 0;
+    UnityOutputCharSpy_Destroy();
+}
+
+static const UNITY_REGISTERED_TEST_T* findTest(const char* name)
+{
+    int i;
+    for (i = 0; i < UnityRegistryCount(); i++)
+    {
+        if (strcmp(UnityRegistryTest(i)->Name, name) == 0)
+        {
+            return UnityRegistryTest(i);
+        }
+    }
+    return NULL;
+}
+
+static int endsWith(const char* string, const char* suffix)
+{
+    const size_t length = strlen(string);
+    const size_t suffix_length = strlen(suffix);
+    return (length >= suffix_length) && (strcmp(string + length - suffix_length, suffix) == 0);
+}
+
+REGISTER_TEST(test_EveryRegisteredTestIsInTheTableOnce)
+{
+    TEST_ASSERT_EQUAL_INT(REGISTERED_TEST_COUNT, UnityRegistryCount());
+    TEST_ASSERT_NOT_NULL(findTest("test_EveryRegisteredTestIsInTheTableOnce"));
+    TEST_ASSERT_NOT_NULL(findTest("test_EntriesKnowTheirFunctionFileAndLine"));
+    TEST_ASSERT_NOT_NULL(findTest("test_SetUpRunsBeforeRegisteredTests"));
+    TEST_ASSERT_NOT_NULL(findTest("test_TestsOfOtherFilesAreRegistered"));
+    TEST_ASSERT_NOT_NULL(findTest("test_ListShowsEveryTestUnderItsFile"));
+    TEST_ASSERT_NOT_NULL(findTest("test_TestsOfAFileAreInSourceOrder"));
+    TEST_ASSERT_NULL(findTest("test_NotRegistered"));
+}
+
+REGISTER_TEST(test_EntriesKnowTheirFunctionFileAndLine)
+{
+    const UNITY_REGISTERED_TEST_T* test = findTest("test_EntriesKnowTheirFunctionFileAndLine");
+
+    TEST_ASSERT_NOT_NULL(test);
+    TEST_ASSERT_TRUE(test->Func == test_EntriesKnowTheirFunctionFileAndLine);
+    TEST_ASSERT_TRUE(endsWith(test->File, "unity_registry_Test.c"));
+    TEST_ASSERT_EQUAL_INT(__LINE__ - 7, test->Line);
+}
+
+REGISTER_TEST(test_SetUpRunsBeforeRegisteredTests)
+{
+    TEST_ASSERT_EQUAL_INT(1, setUpRan);
+}
+
+REGISTER_TEST(test_TestsOfOtherFilesAreRegistered)
+{
+    const UNITY_REGISTERED_TEST_T* test = findTest("test_RegisteredInAnotherFile");
+
+    TEST_ASSERT_NOT_NULL(test);
+    TEST_ASSERT_TRUE(endsWith(test->File, "unity_registry_TestInAnotherFile.c"));
+}
+
+REGISTER_TEST(test_ListShowsEveryTestUnderItsFile)
+{
+    UnityOutputCharSpy_Enable(1);
+    UnityRegistryList();
+    UnityOutputCharSpy_Enable(0);
+
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "unity_registry_Test.c.\n"));
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "\n  test_ListShowsEveryTestUnderItsFile\n"));
+    TEST_ASSERT_NOT_NULL(strstr(UnityOutputCharSpy_Get(), "unity_registry_TestInAnotherFile.c.\n  test_RegisteredInAnotherFile\n"));
+}
+
+REGISTER_TEST(test_TestsOfAFileAreInSourceOrder)
+{
+    int i;
+    int previous = -1;
+
+    for (i = 0; i < UnityRegistryCount(); i++)
+    {
+        const UNITY_REGISTERED_TEST_T* test = UnityRegistryTest(i);
+        if (endsWith(test->File, "unity_registry_Test.c"))
+        {
+            TEST_ASSERT_GREATER_THAN_INT(previous, (int)test->Line);
+            previous = (int)test->Line;
+        }
+    }
+    TEST_ASSERT_NULL(UnityRegistryTest(UnityRegistryCount()));
+}
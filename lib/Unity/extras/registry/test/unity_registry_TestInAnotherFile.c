@@ -0,0 +1,14 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_registry.h"
+
+REGISTER_TEST(test_RegisteredInAnotherFile)
+{
+    TEST_ASSERT_EQUAL_STRING("test_RegisteredInAnotherFile", Unity.CurrentTestName);
+}
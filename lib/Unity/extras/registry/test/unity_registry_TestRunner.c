@@ -0,0 +1,15 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+#include "unity.h"
+#include "unity_registry.h"
+
+/* No RUN_TEST list to keep up to date: the tests registered themselves */
+int main(int argc, char** argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
@@ -5,6 +5,12 @@
     SPDX-License-Identifier: MIT
 ========================================================================= */
 
+/* clock_gettime() and CLOCK_MONOTONIC are POSIX, hidden by strict -std=cXX */
+#if !defined(UNITY_CLOCK_NS) && !defined(UNITY_EXCLUDE_TIME_H) && \
+    (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "unity.h"
 
 #ifndef UNITY_PROGMEM
@@ -17,12 +23,40 @@ void UNITY_OUTPUT_CHAR(int);
 #endif
 
 /* Helpful macros for us to use here in Assert functions */
-#define UNITY_FAIL_AND_BAIL         do { Unity.CurrentTestFailed  = 1; UNITY_OUTPUT_FLUSH(); TEST_ABORT(); } while (0)
-#define UNITY_IGNORE_AND_BAIL       do { Unity.CurrentTestIgnored = 1; UNITY_OUTPUT_FLUSH(); TEST_ABORT(); } while (0)
+#define UNITY_FAIL_AND_BAIL         do { Unity.CurrentTestFailed  = 1; UNITY_RESULT_END(); UNITY_OUTPUT_FLUSH(); TEST_ABORT(); } while (0)
+#define UNITY_IGNORE_AND_BAIL       do { Unity.CurrentTestIgnored = 1; UNITY_RESULT_END(); UNITY_OUTPUT_FLUSH(); TEST_ABORT(); } while (0)
 #define RETURN_IF_FAIL_OR_IGNORE    do { if (Unity.CurrentTestFailed || Unity.CurrentTestIgnored) { TEST_ABORT(); } } while (0)
 
 struct UNITY_STORAGE_T Unity;
 
+#if defined(UNITY_INCLUDE_STRUCTURED_OUTPUT) || defined(UNITY_INCLUDE_PRINT_FORMATTED)
+/* Everything below prints through UnityOutputChar, which can capture what is
+ * printed into a buffer instead of passing it on to UNITY_OUTPUT_CHAR. */
+static void UnityRawChar(const int c)
+{
+    UNITY_OUTPUT_CHAR(c);
+}
+static void UnityOutputChar(const int c);
+#undef UNITY_OUTPUT_CHAR
+#define UNITY_OUTPUT_CHAR(a) UnityOutputChar((int)(a))
+#endif
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+/* Outside text format the message of a failure or ignore is kept from its
+ * status until it bails out, and written in the record of the test; any
+ * other line printed becomes an output record. */
+static void UnityStructuredOutputChar(const int c);
+static int UnityStructuredIsActive(void);
+static void UnityStructuredResultBegin(const UNITY_LINE_TYPE line);
+static void UnityStructuredResultEnd(void);
+static void UnityStructuredConcludeTest(void);
+static void UnityStructuredSuiteBegin(void);
+static void UnityStructuredSuiteEnd(void);
+#define UNITY_RESULT_END() UnityStructuredResultEnd()
+#else
+#define UNITY_RESULT_END() do { /* nothing*/ } while (0)
+#endif
+
 #ifdef UNITY_OUTPUT_COLOR
 const char UNITY_PROGMEM UnityStrOk[]                            = "\033[42mOK\033[0m";
 const char UNITY_PROGMEM UnityStrPass[]                          = "\033[42mPASS\033[0m";
@@ -535,16 +569,37 @@ static void UnityTestResultsBegin(const char* file, const UNITY_LINE_TYPE line)
 }
 
 /*-----------------------------------------------*/
-static void UnityTestResultsFailBegin(const UNITY_LINE_TYPE line)
+/* Begins a failure or ignore line up to its status */
+static void UnityTestResultsStatusBegin(const UNITY_LINE_TYPE line, const char* status)
 {
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    if (UnityStructuredIsActive())
+    {
+        UnityStructuredResultBegin(line); /* the status goes in the record of the test */
+        return;
+    }
+#endif
     UnityTestResultsBegin(Unity.TestFile, line);
-    UnityPrint(UnityStrFail);
+    UnityPrint(status);
+}
+
+/*-----------------------------------------------*/
+static void UnityTestResultsFailBegin(const UNITY_LINE_TYPE line)
+{
+    UnityTestResultsStatusBegin(line, UnityStrFail);
     UNITY_OUTPUT_CHAR(':');
 }
 
 /*-----------------------------------------------*/
 void UnityConcludeTest(void)
 {
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    if (UnityStructuredIsActive())
+    {
+        UnityStructuredConcludeTest();
+        return;
+    }
+#endif
     if (Unity.CurrentTestIgnored)
     {
         Unity.TestIgnores++;
@@ -559,6 +614,7 @@ void UnityConcludeTest(void)
         Unity.TestFailures++;
     }
 
+    UNITY_PRINT_BENCHMARK();
     Unity.CurrentTestFailed = 0;
     Unity.CurrentTestIgnored = 0;
     UNITY_PRINT_EXEC_TIME();
@@ -566,6 +622,523 @@ void UnityConcludeTest(void)
     UNITY_FLUSH_CALL();
 }
 
+#if defined(UNITY_INCLUDE_STRUCTURED_OUTPUT) || defined(UNITY_INCLUDE_PRINT_FORMATTED)
+/* While a capture buffer is set, printed characters are appended to it and
+ * dropped once it is full, leaving room for the terminating NUL. */
+static char* UnityCaptureBuffer;
+static UNITY_UINT32 UnityCaptureSize;
+static UNITY_UINT32 UnityCaptureLength;
+static int UnityCaptureDropped;
+
+/* Captures after the first length characters already in the buffer */
+static void UnityCaptureBegin(char* buffer, const UNITY_UINT32 size, const UNITY_UINT32 length)
+{
+    UnityCaptureBuffer = buffer;
+    UnityCaptureSize = size;
+    UnityCaptureLength = length;
+    UnityCaptureDropped = 0;
+    buffer[length] = '\0';
+}
+
+static void UnityCaptureEnd(void)
+{
+    UnityCaptureBuffer = NULL;
+}
+
+static void UnityOutputChar(const int c)
+{
+    if (UnityCaptureBuffer != NULL)
+    {
+        if ((UnityCaptureLength + 1) < UnityCaptureSize)
+        {
+            UnityCaptureBuffer[UnityCaptureLength++] = (char)c;
+            UnityCaptureBuffer[UnityCaptureLength] = '\0';
+        }
+        else
+        {
+            UnityCaptureDropped = 1;
+        }
+        return;
+    }
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    UnityStructuredOutputChar(c);
+#else
+    UnityRawChar(c);
+#endif
+}
+#endif
+
+/*-----------------------------------------------
+ * Structured Output
+ *-----------------------------------------------*/
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+#if defined(UNITY_OUTPUT_FOR_JUNIT_XML)
+static UNITY_OUTPUT_FORMAT_T UnityOutputFormat = UNITY_OUTPUT_FORMAT_JUNIT_XML;
+#elif defined(UNITY_OUTPUT_FOR_JSON_LINES)
+static UNITY_OUTPUT_FORMAT_T UnityOutputFormat = UNITY_OUTPUT_FORMAT_JSON_LINES;
+#else
+static UNITY_OUTPUT_FORMAT_T UnityOutputFormat = UNITY_OUTPUT_FORMAT_TEXT;
+#endif
+
+static int UnityStructuredActive;
+static int UnityOutputLineOpen;
+static char UnityResultMessage[UNITY_STRUCTURED_MESSAGE_LENGTH];
+static UNITY_UINT32 UnityResultLength;
+static UNITY_UINT32 UnityResultStart;  /* where the message being captured begins */
+static int UnityResultKept;            /* the test has failed or been ignored at least once */
+static UNITY_LINE_TYPE UnityResultLine;
+static char UnityInfoMessage[UNITY_STRUCTURED_MESSAGE_LENGTH];
+#ifdef UNITY_INCLUDE_BENCHMARK
+static char UnityBenchmarkMessage[UNITY_STRUCTURED_MESSAGE_LENGTH];
+#endif
+/* The JUnit records wait here until UnityEnd knows the totals of the <testsuite> */
+static char UnityJUnitRecords[UNITY_JUNIT_BUFFER_LENGTH];
+static UNITY_UINT32 UnityJUnitLength;
+static int UnityJUnitHeld;
+
+static void UnityJUnitRelease(const int totals);
+
+/*-----------------------------------------------*/
+void UnitySetOutputFormat(const UNITY_OUTPUT_FORMAT_T format)
+{
+    UnityOutputFormat = format;
+}
+
+/*-----------------------------------------------*/
+static int UnityStructuredIsActive(void)
+{
+    return UnityStructuredActive && (UnityOutputFormat != UNITY_OUTPUT_FORMAT_TEXT);
+}
+
+/*-----------------------------------------------*/
+static int UnityIsJson(void)
+{
+    return UnityOutputFormat == UNITY_OUTPUT_FORMAT_JSON_LINES;
+}
+
+/*-----------------------------------------------*/
+/* Every character of the records goes through here */
+static void UnityRecordChar(const int c)
+{
+    if (UnityJUnitHeld)
+    {
+        if (UnityJUnitLength < sizeof(UnityJUnitRecords))
+        {
+            UnityJUnitRecords[UnityJUnitLength++] = (char)c;
+            return;
+        }
+        UnityJUnitRelease(0); /* too many records to hold, so the totals are left out */
+    }
+    UnityRawChar(c);
+}
+
+/*-----------------------------------------------*/
+static void UnityRecordPrint(const char* string)
+{
+    while (*string)
+    {
+        UnityRecordChar(*string++);
+    }
+}
+
+/*-----------------------------------------------*/
+static void UnityRecordUnsigned(UNITY_UINT number)
+{
+    char digits[sizeof(UNITY_UINT) * 3];
+    int count = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + (number % 10));
+        number /= 10;
+    } while (number != 0);
+    while (count > 0)
+    {
+        UnityRecordChar(digits[--count]);
+    }
+}
+
+/*-----------------------------------------------*/
+/* Escapes for a JSON string or an XML attribute value */
+static void UnityEscapedChar(const int c)
+{
+    const char* hex = "0123456789abcdef";
+
+    if (UnityIsJson())
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            UnityRecordChar('\\');
+            UnityRecordChar(c);
+        }
+        else if (c == '\n')
+        {
+            UnityRecordPrint("\\n");
+        }
+        else if ((c >= 0) && (c < 0x20))
+        {
+            UnityRecordPrint("\\u00");
+            UnityRecordChar(hex[(c >> 4) & 0xF]);
+            UnityRecordChar(hex[c & 0xF]);
+        }
+        else
+        {
+            UnityRecordChar(c);
+        }
+    }
+    else
+    {
+        switch (c)
+        {
+            case '&':  UnityRecordPrint("&amp;");  break;
+            case '<':  UnityRecordPrint("&lt;");   break;
+            case '>':  UnityRecordPrint("&gt;");   break;
+            case '"':  UnityRecordPrint("&quot;"); break;
+            case '\t': UnityRecordPrint("&#9;");   break;
+            case '\n': UnityRecordPrint("&#10;");  break;
+            case '\r': UnityRecordPrint("&#13;");  break;
+            default:
+                UnityRecordChar(((c >= 0) && (c < 0x20)) ? '?' : c); /* not allowed in XML 1.0 */
+                break;
+        }
+    }
+}
+
+/*-----------------------------------------------*/
+static void UnityEscapedPrint(const char* string)
+{
+    if (string == NULL)
+    {
+        return;
+    }
+    while (*string)
+    {
+        UnityEscapedChar(*string++);
+    }
+}
+
+/*-----------------------------------------------*/
+/* JSON: ,"name":"value" and XML: name="value" */
+static void UnityRecordString(const char* name, const char* value)
+{
+    UnityRecordPrint(UnityIsJson() ? ",\"" : " ");
+    UnityRecordPrint(name);
+    UnityRecordPrint(UnityIsJson() ? "\":\"" : "=\"");
+    UnityEscapedPrint(value);
+    UnityRecordChar('"');
+}
+
+/*-----------------------------------------------*/
+static void UnityRecordNumber(const char* name, const UNITY_UINT value)
+{
+    UnityRecordPrint(UnityIsJson() ? ",\"" : " ");
+    UnityRecordPrint(name);
+    UnityRecordPrint(UnityIsJson() ? "\":" : "=\"");
+    UnityRecordUnsigned(value);
+    if (!UnityIsJson())
+    {
+        UnityRecordChar('"');
+    }
+}
+
+/*-----------------------------------------------*/
+/* Writes the <testsuite> tag, then the records held until now */
+static void UnityJUnitRelease(const int totals)
+{
+    UNITY_UINT32 i;
+
+    UnityJUnitHeld = 0;
+    UnityRecordPrint("<testsuite");
+    UnityRecordString("name", Unity.TestFile);
+    if (totals)
+    {
+        UnityRecordNumber("tests", (UNITY_UINT)Unity.NumberOfTests);
+        UnityRecordNumber("failures", (UNITY_UINT)Unity.TestFailures);
+        UnityRecordNumber("ignored", (UNITY_UINT)Unity.TestIgnores);
+    }
+    UnityRecordPrint(">\n");
+    for (i = 0; i < UnityJUnitLength; i++)
+    {
+        UnityRawChar(UnityJUnitRecords[i]);
+    }
+    UnityJUnitLength = 0;
+}
+
+/*-----------------------------------------------*/
+static void UnityOutputLineEnd(void)
+{
+    if (UnityOutputLineOpen)
+    {
+        UnityRecordPrint(UnityIsJson() ? "\"}\n" : "</system-out>\n");
+        UnityOutputLineOpen = 0;
+    }
+}
+
+/*-----------------------------------------------*/
+/* Anything printed outside the records goes in an output record per line */
+static void UnityStructuredOutputChar(const int c)
+{
+    if (!UnityStructuredIsActive())
+    {
+        UnityRawChar(c);
+    }
+    else if (c == '\n')
+    {
+        UnityOutputLineEnd();
+    }
+    else if (c != '\r')
+    {
+        if (!UnityOutputLineOpen)
+        {
+            UnityRecordPrint(UnityIsJson() ? "{\"event\":\"output\",\"text\":\"" : "  <system-out>");
+            UnityOutputLineOpen = 1;
+        }
+        UnityEscapedChar(c);
+    }
+}
+
+/*-----------------------------------------------*/
+/* Ends the capture of a message for a record, cutting it with "..." if it did not fit */
+static void UnityStructuredCaptureEnd(void)
+{
+    if (UnityCaptureDropped && (UnityCaptureLength >= 3))
+    {
+        UnityCaptureBuffer[UnityCaptureLength - 3] = '.';
+        UnityCaptureBuffer[UnityCaptureLength - 2] = '.';
+        UnityCaptureBuffer[UnityCaptureLength - 1] = '.';
+    }
+    UnityCaptureEnd();
+}
+
+/*-----------------------------------------------*/
+/* Keeps what a failure or ignore prints after its status until it bails, on
+ * its own line after any message already kept for the test */
+static void UnityStructuredResultBegin(const UNITY_LINE_TYPE line)
+{
+    UnityOutputLineEnd();
+    if (!UnityResultKept)
+    {
+        UnityResultKept = 1;
+        UnityResultLine = line; /* later ones are only messages from tearDown */
+        UnityResultLength = 0;
+    }
+    UnityCaptureBegin(UnityResultMessage, (UNITY_UINT32)sizeof(UnityResultMessage), UnityResultLength);
+    if (UnityResultLength > 0)
+    {
+        UNITY_OUTPUT_CHAR('\n');
+    }
+    UnityResultStart = UnityCaptureLength;
+}
+
+/*-----------------------------------------------*/
+static void UnityStructuredResultEnd(void)
+{
+    UNITY_UINT32 from = UnityResultStart;
+
+    if (UnityCaptureBuffer != UnityResultMessage)
+    {
+        return;
+    }
+    UnityStructuredCaptureEnd();
+
+    /* the ':' and spaces after the status of a text line are not part of the message */
+    while ((UnityResultMessage[from] == ':') || (UnityResultMessage[from] == ' '))
+    {
+        from++;
+    }
+    UnityResultLength = UnityResultStart;
+    while (UnityResultMessage[from] != '\0')
+    {
+        UnityResultMessage[UnityResultLength++] = UnityResultMessage[from++];
+    }
+    UnityResultMessage[UnityResultLength] = '\0';
+}
+
+/*-----------------------------------------------*/
+/* Keeps what TEST_MESSAGE or TEST_PRINTF prints, for UnityStructuredInfoEnd */
+static void UnityStructuredInfoBegin(void)
+{
+    UnityOutputLineEnd();
+    UnityCaptureBegin(UnityInfoMessage, (UNITY_UINT32)sizeof(UnityInfoMessage), 0);
+}
+
+/*-----------------------------------------------*/
+static void UnityStructuredInfoEnd(const UNITY_LINE_TYPE line)
+{
+    UnityStructuredCaptureEnd();
+    if (UnityIsJson())
+    {
+        UnityRecordPrint("{\"event\":\"info\"");
+        UnityRecordString("file", Unity.TestFile);
+        UnityRecordString("test", Unity.CurrentTestName);
+        UnityRecordNumber("line", (UNITY_UINT)line);
+        UnityRecordString("message", UnityInfoMessage);
+        UnityRecordPrint("}\n");
+    }
+    else
+    {
+        UnityRecordPrint("  <system-out>");
+        UnityEscapedPrint(Unity.TestFile);
+        UnityRecordChar(':');
+        UnityRecordUnsigned((UNITY_UINT)line);
+        UnityRecordChar(':');
+        UnityEscapedPrint(Unity.CurrentTestName);
+        UnityRecordPrint(": ");
+        UnityEscapedPrint(UnityInfoMessage);
+        UnityRecordPrint("</system-out>\n");
+    }
+}
+
+/*-----------------------------------------------*/
+static void UnityStructuredConcludeTest(void)
+{
+    const char* status = "PASS"; /* not UnityStrPass, which may hold color codes */
+    const char* element = NULL;
+    const char* benchmark = "";
+
+    if (Unity.CurrentTestIgnored)
+    {
+        Unity.TestIgnores++;
+        status = "IGNORE";
+        element = "skipped";
+    }
+    else if (Unity.CurrentTestFailed)
+    {
+        Unity.TestFailures++;
+        status = "FAIL";
+        element = "failure";
+    }
+    UnityStructuredResultEnd(); /* in case a result did not bail out */
+    UnityOutputLineEnd();
+#ifdef UNITY_INCLUDE_BENCHMARK
+    /* the statistics of a passing test go in its record instead of after the PASS */
+    UnityCaptureBegin(UnityBenchmarkMessage, (UNITY_UINT32)sizeof(UnityBenchmarkMessage), 0);
+    UNITY_PRINT_BENCHMARK();
+    UnityStructuredCaptureEnd();
+    benchmark = UnityBenchmarkMessage;
+    while (*benchmark == ' ')
+    {
+        benchmark++;
+    }
+#endif
+
+    if (UnityIsJson())
+    {
+        UnityRecordPrint("{\"event\":\"test\"");
+        UnityRecordString("file", Unity.TestFile);
+        UnityRecordString("test", Unity.CurrentTestName);
+        UnityRecordNumber("line", (UNITY_UINT)Unity.CurrentTestLineNumber);
+        UnityRecordString("status", status);
+#ifdef UNITY_EXEC_TIME_MS
+        UnityRecordNumber("time_ms", (UNITY_UINT)UNITY_EXEC_TIME_MS());
+#endif
+        if (element != NULL)
+        {
+            UnityRecordNumber("result_line", (UNITY_UINT)UnityResultLine);
+            UnityRecordString("message", UnityResultMessage);
+        }
+        if (benchmark[0] != '\0')
+        {
+            UnityRecordString("benchmark", benchmark);
+        }
+        UnityRecordPrint("}\n");
+    }
+    else
+    {
+        UnityRecordPrint("  <testcase");
+        UnityRecordString("classname", Unity.TestFile);
+        UnityRecordString("name", Unity.CurrentTestName);
+        UnityRecordString("file", Unity.TestFile);
+        UnityRecordNumber("line", (UNITY_UINT)Unity.CurrentTestLineNumber);
+#ifdef UNITY_EXEC_TIME_MS
+        {
+            UNITY_UINT ms = (UNITY_UINT)UNITY_EXEC_TIME_MS();
+            UnityRecordPrint(" time=\"");
+            UnityRecordUnsigned(ms / 1000);
+            UnityRecordChar('.');
+            UnityRecordChar('0' + (int)((ms / 100) % 10));
+            UnityRecordChar('0' + (int)((ms / 10) % 10));
+            UnityRecordChar('0' + (int)(ms % 10));
+            UnityRecordChar('"');
+        }
+#endif
+        if (element != NULL)
+        {
+            UnityRecordPrint(">\n    <");
+            UnityRecordPrint(element);
+            UnityRecordString("message", UnityResultMessage);
+            UnityRecordNumber("line", (UNITY_UINT)UnityResultLine);
+            UnityRecordPrint("/>\n  </testcase>\n");
+        }
+        else if (benchmark[0] != '\0')
+        {
+            UnityRecordPrint(">\n    <system-out>");
+            UnityEscapedPrint(benchmark);
+            UnityRecordPrint("</system-out>\n  </testcase>\n");
+        }
+        else
+        {
+            UnityRecordPrint("/>\n");
+        }
+    }
+
+    UnityResultKept = 0;
+    UnityResultLength = 0;
+    UnityResultMessage[0] = '\0';
+    Unity.CurrentTestFailed = 0;
+    Unity.CurrentTestIgnored = 0;
+    UNITY_FLUSH_CALL();
+}
+
+/*-----------------------------------------------*/
+static void UnityStructuredSuiteBegin(void)
+{
+    UnityStructuredActive = 1;
+    UnityOutputLineOpen = 0;
+    UnityResultKept = 0;
+    UnityResultLength = 0;
+    UnityResultMessage[0] = '\0';
+    UnityJUnitHeld = 0;
+    UnityJUnitLength = 0;
+    if (UnityIsJson())
+    {
+        UnityRecordPrint("{\"event\":\"begin\"");
+        UnityRecordString("file", Unity.TestFile);
+        UnityRecordPrint("}\n");
+    }
+    else
+    {
+        UnityRecordPrint("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        UnityJUnitHeld = 1; /* the <testsuite> tag comes with the totals from UnityEnd */
+    }
+}
+
+/*-----------------------------------------------*/
+static void UnityStructuredSuiteEnd(void)
+{
+    UnityOutputLineEnd();
+    if (UnityIsJson())
+    {
+        UnityRecordPrint("{\"event\":\"end\"");
+        UnityRecordString("file", Unity.TestFile);
+        UnityRecordNumber("tests", (UNITY_UINT)Unity.NumberOfTests);
+        UnityRecordNumber("failures", (UNITY_UINT)Unity.TestFailures);
+        UnityRecordNumber("ignored", (UNITY_UINT)Unity.TestIgnores);
+        UnityRecordPrint("}\n");
+    }
+    else
+    {
+        if (UnityJUnitHeld)
+        {
+            UnityJUnitRelease(1);
+        }
+        UnityRecordPrint("</testsuite>\n");
+    }
+    UnityStructuredActive = 0;
+}
+#endif /* UNITY_INCLUDE_STRUCTURED_OUTPUT */
+
 /*-----------------------------------------------*/
 static void UnityAddMsgIfSpecified(const char* msg)
 {
@@ -683,6 +1256,78 @@ static int UnityIsOneArrayNull(UNITY_INTERNAL_PTR expected,
     return 0; /* return false if neither is NULL */
 }
 
+/*-----------------------------------------------*/
+#if defined(__GNUC__) || defined(__clang__)
+typedef UNITY_UINT __attribute__((__may_alias__)) UNITY_ALIASED_WORD;
+#else
+typedef UNITY_UINT UNITY_ALIASED_WORD;
+#endif
+
+/* Equality check of two byte ranges, a machine word at a time wherever both
+ * share the same alignment. This is only a fast path: mismatches are located
+ * and reported by the element loops of the assertions. */
+static int UnityBytesAreEqual(UNITY_INTERNAL_PTR expected,
+                              UNITY_INTERNAL_PTR actual,
+                              UNITY_UINT bytes)
+{
+#ifdef UNITY_MEMCMP
+    return UNITY_MEMCMP(expected, actual, bytes) == 0;
+#else
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_exp = (UNITY_PTR_ATTRIBUTE const unsigned char*)expected;
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_act = (UNITY_PTR_ATTRIBUTE const unsigned char*)actual;
+    const UNITY_UINT word_mask = (UNITY_UINT)sizeof(UNITY_UINT) - 1;
+
+    if ((((UNITY_UINT)(UNITY_PTR_TO_INT)ptr_exp ^ (UNITY_UINT)(UNITY_PTR_TO_INT)ptr_act) & word_mask) == 0)
+    {
+        while ((bytes > 0) && (((UNITY_UINT)(UNITY_PTR_TO_INT)ptr_exp & word_mask) != 0))
+        {
+            if (*ptr_exp++ != *ptr_act++) { return 0; }
+            bytes--;
+        }
+        while (bytes >= sizeof(UNITY_UINT))
+        {
+            if (*(UNITY_PTR_ATTRIBUTE const UNITY_ALIASED_WORD*)(UNITY_INTERNAL_PTR)ptr_exp !=
+                *(UNITY_PTR_ATTRIBUTE const UNITY_ALIASED_WORD*)(UNITY_INTERNAL_PTR)ptr_act)
+            {
+                return 0;
+            }
+            ptr_exp += sizeof(UNITY_UINT);
+            ptr_act += sizeof(UNITY_UINT);
+            bytes   -= sizeof(UNITY_UINT);
+        }
+    }
+    while (bytes > 0)
+    {
+        if (*ptr_exp++ != *ptr_act++) { return 0; }
+        bytes--;
+    }
+    return 1;
+#endif
+}
+
+/*-----------------------------------------------*/
+static int UnityArrayBytesAreEqual(UNITY_INTERNAL_PTR expected,
+                                   UNITY_INTERNAL_PTR actual,
+                                   const UNITY_UINT element_size,
+                                   const UNITY_UINT32 num_elements,
+                                   const int to_value)
+{
+    const UNITY_UINT total = element_size * (UNITY_UINT)num_elements;
+
+    if (total == 0)
+    {
+        return 1;
+    }
+    if (!to_value)
+    {
+        return UnityBytesAreEqual(expected, actual, total);
+    }
+
+    /* Every element matches the first when the array equals itself shifted by one element */
+    return UnityBytesAreEqual(expected, actual, element_size) &&
+           UnityBytesAreEqual(actual, (UNITY_INTERNAL_PTR)((const char*)actual + element_size), total - element_size);
+}
+
 /*-----------------------------------------------
  * Assertion Functions
  *-----------------------------------------------*/
@@ -811,6 +1456,25 @@ void UnityAssertEqualIntArray(UNITY_INTERNAL_PTR expected,
         UNITY_FAIL_AND_BAIL;
     }
 
+    switch (length)
+    {
+        case 1:
+        case 2:
+#ifdef UNITY_SUPPORT_64
+        case 8:
+#endif
+            increment = length;
+            break;
+
+        default: /* default is length 4 bytes */
+            increment = 4;
+            break;
+    }
+    if (UnityArrayBytesAreEqual(expected, actual, increment, num_elements, flags != UNITY_ARRAY_TO_ARRAY))
+    {
+        return;
+    }
+
     while ((elements > 0) && (elements--))
     {
         UNITY_INT expect_val;
@@ -1448,14 +2112,33 @@ void UnityAssertNumbersArrayWithin(const UNITY_UINT delta,
 #endif
     }
 
-    if (expected == actual)
-    {
-        return; /* Both are NULL or same pointer */
+    if (expected == actual)
+    {
+        return; /* Both are NULL or same pointer */
+    }
+
+    if (UnityIsOneArrayNull(expected, actual, lineNumber, msg))
+    {
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    switch (length)
+    {
+        case 1:
+        case 2:
+#ifdef UNITY_SUPPORT_64
+        case 8:
+#endif
+            increment = length;
+            break;
+
+        default: /* default is length 4 bytes */
+            increment = 4;
+            break;
     }
-
-    if (UnityIsOneArrayNull(expected, actual, lineNumber, msg))
+    if (UnityArrayBytesAreEqual(expected, actual, increment, num_elements, flags != UNITY_ARRAY_TO_ARRAY))
     {
-        UNITY_FAIL_AND_BAIL;
+        return;
     }
 
     while ((elements > 0) && (elements--))
@@ -1788,6 +2471,11 @@ void UnityAssertEqualMemory(UNITY_INTERNAL_PTR expected,
         UNITY_FAIL_AND_BAIL;
     }
 
+    if (UnityArrayBytesAreEqual(expected, actual, length, num_elements, flags == UNITY_ARRAY_TO_VAL))
+    {
+        return;
+    }
+
     while (elements--)
     {
         bytes = length;
@@ -2101,6 +2789,21 @@ static void UnityPrintFVA(const char* format, va_list va)
 
 void UnityPrintF(const UNITY_LINE_TYPE line, const char* format, ...)
 {
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    if (UnityStructuredIsActive())
+    {
+        UnityStructuredInfoBegin();
+        if (format != NULL)
+        {
+            va_list va;
+            va_start(va, format);
+            UnityPrintFVA(format, va);
+            va_end(va);
+        }
+        UnityStructuredInfoEnd(line);
+        return;
+    }
+#endif
     UnityTestResultsBegin(Unity.TestFile, line);
     UnityPrint("INFO");
     if(format != NULL)
@@ -2113,6 +2816,80 @@ void UnityPrintF(const UNITY_LINE_TYPE line, const char* format, ...)
     }
     UNITY_PRINT_EOL();
 }
+
+/*-----------------------------------------------
+ * Assertions with formatted messages
+ *-----------------------------------------------
+ * These compare first and only format their message on failure, so a passing
+ * assertion costs a call and a comparison. The message is formatted into a
+ * static buffer, and the arguments released, before the plain assertion is
+ * called with it and bails out. */
+
+static char UnityFormattedMessage[UNITY_FORMATTED_MESSAGE_LENGTH];
+
+static const char* UnityFormatMessage(const char* format, va_list va)
+{
+    if (format == NULL)
+    {
+        return NULL;
+    }
+    UnityCaptureBegin(UnityFormattedMessage, (UNITY_UINT32)sizeof(UnityFormattedMessage), 0);
+    UnityPrintFVA(format, va);
+    UnityCaptureEnd();
+    return UnityFormattedMessage;
+}
+
+/*-----------------------------------------------*/
+void UnityAssertEqualNumberF(const UNITY_INT expected,
+                             const UNITY_INT actual,
+                             const UNITY_LINE_TYPE lineNumber,
+                             const UNITY_DISPLAY_STYLE_T style,
+                             const char* format, ...)
+{
+    const char* msg;
+    va_list va;
+
+    if (expected == actual)
+    {
+        return;
+    }
+    va_start(va, format);
+    msg = UnityFormatMessage(format, va);
+    va_end(va);
+    UnityAssertEqualNumber(expected, actual, msg, lineNumber, style);
+}
+
+/*-----------------------------------------------*/
+void UnityAssertBitsF(const UNITY_INT mask,
+                      const UNITY_INT expected,
+                      const UNITY_INT actual,
+                      const UNITY_LINE_TYPE lineNumber,
+                      const char* format, ...)
+{
+    const char* msg;
+    va_list va;
+
+    if ((mask & expected) == (mask & actual))
+    {
+        return;
+    }
+    va_start(va, format);
+    msg = UnityFormatMessage(format, va);
+    va_end(va);
+    UnityAssertBits(mask, expected, actual, msg, lineNumber);
+}
+
+/*-----------------------------------------------*/
+void UnityFailF(const UNITY_LINE_TYPE line, const char* format, ...)
+{
+    const char* msg;
+    va_list va;
+
+    va_start(va, format);
+    msg = UnityFormatMessage(format, va);
+    va_end(va);
+    UnityFail(msg, line);
+}
 #endif /* ! UNITY_INCLUDE_PRINT_FORMATTED */
 
 
@@ -2125,8 +2902,7 @@ void UnityFail(const char* msg, const UNITY_LINE_TYPE line)
 {
     RETURN_IF_FAIL_OR_IGNORE;
 
-    UnityTestResultsBegin(Unity.TestFile, line);
-    UnityPrint(UnityStrFail);
+    UnityTestResultsStatusBegin(line, UnityStrFail);
     if (msg != NULL)
     {
         UNITY_OUTPUT_CHAR(':');
@@ -2162,8 +2938,7 @@ void UnityIgnore(const char* msg, const UNITY_LINE_TYPE line)
 {
     RETURN_IF_FAIL_OR_IGNORE;
 
-    UnityTestResultsBegin(Unity.TestFile, line);
-    UnityPrint(UnityStrIgnore);
+    UnityTestResultsStatusBegin(line, UnityStrIgnore);
     if (msg != NULL)
     {
         UNITY_OUTPUT_CHAR(':');
@@ -2176,6 +2951,15 @@ void UnityIgnore(const char* msg, const UNITY_LINE_TYPE line)
 /*-----------------------------------------------*/
 void UnityMessage(const char* msg, const UNITY_LINE_TYPE line)
 {
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    if (UnityStructuredIsActive())
+    {
+        UnityStructuredInfoBegin();
+        UnityPrint(msg);
+        UnityStructuredInfoEnd(line);
+        return;
+    }
+#endif
     UnityTestResultsBegin(Unity.TestFile, line);
     UnityPrint("INFO");
     if (msg != NULL)
@@ -2231,11 +3015,27 @@ void UnityBegin(const char* filename)
 
     UNITY_CLR_DETAILS();
     UNITY_OUTPUT_START();
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    UnityStructuredActive = 0;
+    if (UnityOutputFormat != UNITY_OUTPUT_FORMAT_TEXT)
+    {
+        UnityStructuredSuiteBegin();
+    }
+#endif
 }
 
 /*-----------------------------------------------*/
 int UnityEnd(void)
 {
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    if (UnityStructuredIsActive())
+    {
+        UnityStructuredSuiteEnd();
+        UNITY_FLUSH_CALL();
+        UNITY_OUTPUT_COMPLETE();
+        return (int)(Unity.TestFailures);
+    }
+#endif
     UNITY_PRINT_EOL();
     UnityPrint(UnityStrBreaker);
     UNITY_PRINT_EOL();
@@ -2263,6 +3063,128 @@ int UnityEnd(void)
     return (int)(Unity.TestFailures);
 }
 
+/*-----------------------------------------------
+ * Test Name Matching
+ *-----------------------------------------------*/
+
+static int UnityIsPatternEnd(const char c)
+{
+    return (c == 0) || (c == ',') || (c == ':') || (c == '"') || (c == '\'');
+}
+
+/*-----------------------------------------------*/
+/* Matches a glob where '*' is any run of characters and '?' any one character.
+ * Unless anchored, the pattern may match anywhere inside the string.
+ * Returns 2 instead of 1 when the pattern was ended by a ':' */
+static int UnityGlobMatchFrom(const char* pattern, const char* string, const int anchored)
+{
+    const char* star = NULL;
+    const char* resume = string;
+    const char* start = string;
+
+    for (;;)
+    {
+        if (UnityIsPatternEnd(*pattern))
+        {
+            if (!anchored || (*string == 0))
+            {
+                return (*pattern == ':') ? 2 : 1;
+            }
+        }
+        else if (*pattern == '*')
+        {
+            star = ++pattern;
+            resume = string;
+            continue;
+        }
+        else if ((*string != 0) && ((*pattern == '?') || (*pattern == *string)))
+        {
+            pattern++;
+            string++;
+            continue;
+        }
+
+        /* Mismatch: let the last '*' swallow one more character, else slide the whole pattern along */
+        if ((star != NULL) && (*resume != 0))
+        {
+            pattern = star;
+            string = ++resume;
+        }
+        else if (!anchored && (star == NULL) && (*start != 0))
+        {
+            pattern -= (string - start);
+            string = ++start;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+}
+
+/*-----------------------------------------------*/
+int UnityGlobMatch(const char* pattern, const char* string)
+{
+    return UnityGlobMatchFrom(pattern, string, 1);
+}
+
+/*-----------------------------------------------*/
+UNITY_UINT32 UnityHashString(UNITY_UINT32 hash, const char* string)
+{
+    /* FNV-1a, so a test keeps its hash on every platform and in every build */
+    while (*string != 0)
+    {
+        hash ^= (UNITY_UINT32)(unsigned char)*string++;
+        hash = (UNITY_UINT32)(hash * 16777619UL);
+    }
+    return hash;
+}
+
+/*-----------------------------------------------
+ * Timing Helpers for the Add-ons
+ *-----------------------------------------------*/
+
+#if defined(UNITY_CLOCK_NS)
+double UNITY_CLOCK_NS(void);
+double UnityClockNs(void)
+{
+    return UNITY_CLOCK_NS();
+}
+#elif defined(UNITY_EXCLUDE_TIME_H)
+/* Without a clock, the add-ons that time tests need UNITY_CLOCK_NS */
+#elif defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+double UnityClockNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((double)now.tv_sec * 1e9) + (double)now.tv_nsec;
+}
+#else
+#include <time.h>
+double UnityClockNs(void)
+{
+    return (double)clock() * (1e9 / (double)CLOCKS_PER_SEC);
+}
+#endif
+
+/*-----------------------------------------------*/
+/* Newton's method, so that the add-ons do not need libm */
+double UnitySqrt(const double value)
+{
+    double root = value;
+    int i;
+    if (value <= 0.0)
+    {
+        return 0.0;
+    }
+    for (i = 0; i < 64; i++)
+    {
+        root = 0.5 * (root + (value / root));
+    }
+    return root;
+}
+
 /*-----------------------------------------------
  * Command Line Argument Support
  *-----------------------------------------------*/
@@ -2270,16 +3192,90 @@ int UnityEnd(void)
 
 char* UnityOptionIncludeNamed = NULL;
 char* UnityOptionExcludeNamed = NULL;
+char* UnityOptionFileNamed    = NULL;
 int UnityVerbosity            = 1;
 int UnityStrictMatch          = 0;
+int UnityShardIndex           = 0;
+int UnityShardCount           = 1;
+
+static const UNITY_TEST_ENTRY_T* UnityTestTable = NULL;
+static int UnityTestTableCount = 0;
+
+/*-----------------------------------------------*/
+static int UnityIsLongOption(const char* arg, const char* option)
+{
+    while ((*option != 0) && (*arg == *option))
+    {
+        arg++;
+        option++;
+    }
+    return (*arg == 0) && (*option == 0);
+}
+
+/*-----------------------------------------------*/
+/* Reads INDEX/COUNT, where INDEX counts from 1 */
+static int UnityParseShard(const char* arg)
+{
+    int index = 0;
+    int count = 0;
+
+    while ((*arg >= '0') && (*arg <= '9'))
+    {
+        index = (index * 10) + (*arg++ - '0');
+    }
+    if (*arg++ != '/')
+    {
+        return 1;
+    }
+    while ((*arg >= '0') && (*arg <= '9'))
+    {
+        count = (count * 10) + (*arg++ - '0');
+    }
+    if ((*arg != 0) || (index < 1) || (index > count))
+    {
+        return 1;
+    }
+
+    UnityShardIndex = index - 1;
+    UnityShardCount = count;
+    return 0;
+}
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+/*-----------------------------------------------*/
+static int UnityParseOutputFormat(const char* arg)
+{
+    if (UnityIsLongOption(arg, "text"))
+    {
+        UnitySetOutputFormat(UNITY_OUTPUT_FORMAT_TEXT);
+    }
+    else if (UnityIsLongOption(arg, "json"))
+    {
+        UnitySetOutputFormat(UNITY_OUTPUT_FORMAT_JSON_LINES);
+    }
+    else if (UnityIsLongOption(arg, "junit"))
+    {
+        UnitySetOutputFormat(UNITY_OUTPUT_FORMAT_JUNIT_XML);
+    }
+    else
+    {
+        return 1;
+    }
+    return 0;
+}
+#endif
 
 /*-----------------------------------------------*/
 int UnityParseOptions(int argc, char** argv)
 {
     int i;
+    int list_tests = 0;
     UnityOptionIncludeNamed = NULL;
     UnityOptionExcludeNamed = NULL;
+    UnityOptionFileNamed = NULL;
     UnityStrictMatch = 0;
+    UnityShardIndex = 0;
+    UnityShardCount = 1;
 
     for (i = 1; i < argc; i++)
     {
@@ -2287,8 +3283,52 @@ int UnityParseOptions(int argc, char** argv)
         {
             switch (argv[i][1])
             {
-                case 'l': /* list tests */
-                    return -1;
+                case 'l': /* list tests, once the other options have been read */
+                    list_tests = 1;
+                    break;
+                case '-': /* long options */
+                    if (UnityIsLongOption(argv[i], "--list"))
+                    {
+                        list_tests = 1;
+                        break;
+                    }
+                    if (UnityIsLongOption(argv[i], "--shard"))
+                    {
+                        if ((++i < argc) && (UnityParseShard(argv[i]) == 0))
+                        {
+                            break;
+                        }
+                        UnityPrint("ERROR: Expected --shard INDEX/COUNT");
+                        UNITY_PRINT_EOL();
+                        return 1;
+                    }
+                    if (UnityIsLongOption(argv[i], "--file"))
+                    {
+                        if (++i < argc)
+                        {
+                            UnityOptionFileNamed = argv[i];
+                            break;
+                        }
+                        UnityPrint("ERROR: No Test File to Include Matches For");
+                        UNITY_PRINT_EOL();
+                        return 1;
+                    }
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+                    if (UnityIsLongOption(argv[i], "--format"))
+                    {
+                        if ((++i < argc) && (UnityParseOutputFormat(argv[i]) == 0))
+                        {
+                            break;
+                        }
+                        UnityPrint("ERROR: Expected --format text, json or junit");
+                        UNITY_PRINT_EOL();
+                        return 1;
+                    }
+#endif
+                    UnityPrint("ERROR: Unknown Option ");
+                    UnityPrint(argv[i]);
+                    UNITY_PRINT_EOL();
+                    return 1;
                 case 'n': /* include tests with name including this string */
                 case 'f': /* an alias for -n */
                     UnityStrictMatch = (argv[i][1] == 'n'); /* strictly match this string if -n */
@@ -2337,19 +3377,40 @@ int UnityParseOptions(int argc, char** argv)
                     /* FALLTHRU */
                 case 'h':
                     UnityPrint("Options: "); UNITY_PRINT_EOL();
-                    UnityPrint("-l        List all tests and exit"); UNITY_PRINT_EOL();
+                    UnityPrint("-l        List all tests and exit (also --list)"); UNITY_PRINT_EOL();
                     UnityPrint("-f NAME   Filter to run only tests whose name includes NAME"); UNITY_PRINT_EOL();
                     UnityPrint("-n NAME   Run only the test named NAME"); UNITY_PRINT_EOL();
                     UnityPrint("-h        show this Help menu"); UNITY_PRINT_EOL();
                     UnityPrint("-q        Quiet/decrease verbosity"); UNITY_PRINT_EOL();
                     UnityPrint("-v        increase Verbosity"); UNITY_PRINT_EOL();
                     UnityPrint("-x NAME   eXclude tests whose name includes NAME"); UNITY_PRINT_EOL();
+                    UnityPrint("--shard INDEX/COUNT  Run only shard INDEX (from 1) of COUNT"); UNITY_PRINT_EOL();
+                    UnityPrint("--file NAME  Run only tests of the files whose name includes NAME"); UNITY_PRINT_EOL();
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+                    UnityPrint("--format text|json|junit  Write results as text, JSON Lines or JUnit XML"); UNITY_PRINT_EOL();
+#endif
                     UNITY_OUTPUT_FLUSH();
                     return 1;
             }
         }
     }
 
+    return list_tests ? -1 : 0;
+}
+
+/*-----------------------------------------------*/
+/* A trailing '*' has always meant "anything from here on" and is handled by the
+ * plain matcher; '?', inner '*' and any '*' in an exact (-n) match need the glob */
+static int UnityPatternNeedsGlob(const char* pattern)
+{
+    for (; !UnityIsPatternEnd(*pattern); pattern++)
+    {
+        if ((*pattern == '?') ||
+            ((*pattern == '*') && (UnityStrictMatch || !UnityIsPatternEnd(pattern[1]))))
+        {
+            return 1;
+        }
+    }
     return 0;
 }
 
@@ -2360,6 +3421,11 @@ static int IsStringInBiggerString(const char* longstring, const char* shortstrin
     const char* sptr = shortstring;
     const char* lnext = lptr;
 
+    if (UnityPatternNeedsGlob(shortstring))
+    {
+        return UnityGlobMatchFrom(shortstring, longstring, UnityStrictMatch);
+    }
+
     if (*sptr == '*')
     {
         return UnityStrictMatch ? 0 : 1;
@@ -2471,6 +3537,58 @@ static int UnityStringArgumentMatches(const char* str)
     return 0;
 }
 
+/*-----------------------------------------------*/
+static int UnityFindEntry(const UNITY_TEST_ENTRY_T* sortedTests, const int count, const char* name)
+{
+    int low = 0;
+    int high = count - 1;
+
+    while (low <= high)
+    {
+        const int mid = low + ((high - low) / 2);
+        const char* lhs = name;
+        const char* rhs = sortedTests[mid].Name;
+        while ((*lhs != 0) && (*lhs == *rhs))
+        {
+            lhs++;
+            rhs++;
+        }
+        if (*lhs == *rhs)
+        {
+            return mid;
+        }
+        if ((unsigned char)*lhs < (unsigned char)*rhs)
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+    return -1;
+}
+
+/*-----------------------------------------------*/
+static int UnityCurrentTestShard(void)
+{
+    int entry = -1;
+    if (UnityTestTable != NULL)
+    {
+        entry = UnityFindEntry(UnityTestTable, UnityTestTableCount, Unity.CurrentTestName);
+    }
+
+    if ((entry >= 0) && (UnityTestTable[entry].ShardRank >= 0))
+    {
+        /* Tests ranked from slowest to fastest in a previous run are dealt out
+         * back and forth (0 1 2 2 1 0 0 1 ...) so that every shard gets a similar total */
+        const int cycle = UnityTestTable[entry].ShardRank % (2 * UnityShardCount);
+        return (cycle < UnityShardCount) ? cycle : ((2 * UnityShardCount) - 1 - cycle);
+    }
+
+    return (int)(UnityHashString(UNITY_HASH_INIT, Unity.CurrentTestName) % (UNITY_UINT32)UnityShardCount);
+}
+
 /*-----------------------------------------------*/
 int UnityTestMatches(void)
 {
@@ -2494,8 +3612,78 @@ int UnityTestMatches(void)
         }
     }
 
+    /* Check if this test is in one of the files being run */
+    if (retval && !UnityFileMatches(Unity.TestFile))
+    {
+        retval = 0;
+    }
+
+    /* Check if this test belongs to the shard being run */
+    if (retval && (UnityShardCount > 1) && (UnityCurrentTestShard() != UnityShardIndex))
+    {
+        retval = 0;
+    }
+
     return retval;
 }
 
+/*-----------------------------------------------*/
+/* Lets a runner of many test files skip whole files left out by --file,
+ * which takes a comma separated list of names or globs */
+int UnityFileMatches(const char* file)
+{
+    const char* pattern = UnityOptionFileNamed;
+
+    if (pattern == NULL)
+    {
+        return 1;
+    }
+    while (*pattern != 0)
+    {
+        if (UnityGlobMatchFrom(pattern, file, 0))
+        {
+            return 1;
+        }
+        while (!UnityIsPatternEnd(*pattern))
+        {
+            pattern++;
+        }
+        while ((*pattern != 0) && UnityIsPatternEnd(*pattern))
+        {
+            pattern++;
+        }
+    }
+    return 0;
+}
+
+/*-----------------------------------------------*/
+void UnitySetTestTable(const UNITY_TEST_ENTRY_T* sortedTests, const int count)
+{
+    UnityTestTable = sortedTests;
+    UnityTestTableCount = count;
+}
+
+/*-----------------------------------------------*/
+int UnityFindTestByName(const UNITY_TEST_ENTRY_T* sortedTests, const int count)
+{
+    const char* name = UnityOptionIncludeNamed;
+    const char* ptr;
+
+    /* Only a single plain name given to -n can be looked up, anything else is matched test by test */
+    if (!UnityStrictMatch || (name == NULL) || (*name == 0))
+    {
+        return -1;
+    }
+    for (ptr = name; *ptr != 0; ptr++)
+    {
+        if (UnityIsPatternEnd(*ptr) || (*ptr == '*') || (*ptr == '?'))
+        {
+            return -1;
+        }
+    }
+
+    return UnityFindEntry(sortedTests, count, name);
+}
+
 #endif /* UNITY_USE_COMMAND_LINE_ARGS */
 /*-----------------------------------------------*/
@@ -691,6 +691,47 @@ void verifyTest(void);
 #define TEST_ASSERT_NOT_EQUAL_MESSAGE(expected, actual, message)                                   UNITY_TEST_FAIL(__LINE__, UnityStrErrShorthand)
 #endif
 
+/*-------------------------------------------------------
+ * Test Asserts (with formatted messages)
+ *-------------------------------------------------------
+ * The message is a printf-style format followed by its arguments, as for
+ * TEST_PRINTF. It is only formatted when the assertion fails, so unlike a
+ * message built with snprintf beforehand, a passing assertion costs no more
+ * than the comparison. */
+
+#ifdef UNITY_INCLUDE_PRINT_FORMATTED
+/* Boolean */
+#define TEST_FAIL_MSGF(...)                                                                        UNITY_TEST_FAIL_MSGF(__LINE__, __VA_ARGS__)
+#define TEST_ASSERT_MSGF(condition, ...)                                                           UNITY_TEST_ASSERT_MSGF(       (condition), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_TRUE_MSGF(condition, ...)                                                      UNITY_TEST_ASSERT_MSGF(       (condition), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_UNLESS_MSGF(condition, ...)                                                    UNITY_TEST_ASSERT_MSGF(      !(condition), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_FALSE_MSGF(condition, ...)                                                     UNITY_TEST_ASSERT_MSGF(      !(condition), __LINE__, __VA_ARGS__)
+
+/* Integers (of all sizes) */
+#define TEST_ASSERT_EQUAL_INT_MSGF(expected, actual, ...)                                          UNITY_TEST_ASSERT_EQUAL_INT_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_INT8_MSGF(expected, actual, ...)                                         UNITY_TEST_ASSERT_EQUAL_INT8_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_INT16_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_INT16_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_INT32_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_INT32_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_INT64_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_INT64_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_UINT_MSGF(expected, actual, ...)                                         UNITY_TEST_ASSERT_EQUAL_UINT_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_UINT8_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_UINT8_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_UINT16_MSGF(expected, actual, ...)                                       UNITY_TEST_ASSERT_EQUAL_UINT16_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_UINT32_MSGF(expected, actual, ...)                                       UNITY_TEST_ASSERT_EQUAL_UINT32_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_UINT64_MSGF(expected, actual, ...)                                       UNITY_TEST_ASSERT_EQUAL_UINT64_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_size_t_MSGF(expected, actual, ...)                                       UNITY_TEST_ASSERT_EQUAL_UINT_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_HEX_MSGF(expected, actual, ...)                                          UNITY_TEST_ASSERT_EQUAL_HEX32_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_HEX8_MSGF(expected, actual, ...)                                         UNITY_TEST_ASSERT_EQUAL_HEX8_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_HEX16_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_HEX16_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_HEX32_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_HEX32_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_HEX64_MSGF(expected, actual, ...)                                        UNITY_TEST_ASSERT_EQUAL_HEX64_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_EQUAL_CHAR_MSGF(expected, actual, ...)                                         UNITY_TEST_ASSERT_EQUAL_CHAR_MSGF((expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_BITS_MSGF(mask, expected, actual, ...)                                         UNITY_TEST_ASSERT_BITS_MSGF((mask), (expected), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_BITS_HIGH_MSGF(mask, actual, ...)                                              UNITY_TEST_ASSERT_BITS_MSGF((mask), (UNITY_UINT32)(-1), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_BITS_LOW_MSGF(mask, actual, ...)                                               UNITY_TEST_ASSERT_BITS_MSGF((mask), (UNITY_UINT32)(0), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_BIT_HIGH_MSGF(bit, actual, ...)                                                UNITY_TEST_ASSERT_BITS_MSGF(((UNITY_UINT32)1 << (bit)), (UNITY_UINT32)(-1), (actual), __LINE__, __VA_ARGS__)
+#define TEST_ASSERT_BIT_LOW_MSGF(bit, actual, ...)                                                 UNITY_TEST_ASSERT_BITS_MSGF(((UNITY_UINT32)1 << (bit)), (UNITY_UINT32)(0), (actual), __LINE__, __VA_ARGS__)
+#endif
+
 /* end of UNITY_FRAMEWORK_H */
 #ifdef __cplusplus
 }
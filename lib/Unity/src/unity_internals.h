@@ -26,6 +26,10 @@
 
 #ifdef UNITY_INCLUDE_PRINT_FORMATTED
 #include <stdarg.h>
+/* Longest message formatted by the _MSGF assertions, the rest is dropped */
+#ifndef UNITY_FORMATTED_MESSAGE_LENGTH
+#define UNITY_FORMATTED_MESSAGE_LENGTH 128
+#endif
 #endif
 
 /* Unity Attempts to Auto-Detect Integer Types
@@ -374,8 +378,9 @@ typedef UNITY_FLOAT_TYPE UNITY_FLOAT;
       #define UNITY_TIME_TYPE UNITY_UINT
       #define UNITY_EXEC_TIME_START() Unity.CurrentTestStartTime = UNITY_CLOCK_MS()
       #define UNITY_EXEC_TIME_STOP() Unity.CurrentTestStopTime = UNITY_CLOCK_MS()
+      #define UNITY_EXEC_TIME_MS() ((UNITY_UINT)(Unity.CurrentTestStopTime - Unity.CurrentTestStartTime))
       #define UNITY_PRINT_EXEC_TIME() { \
-        UNITY_UINT execTimeMs = (Unity.CurrentTestStopTime - Unity.CurrentTestStartTime); \
+        UNITY_UINT execTimeMs = UNITY_EXEC_TIME_MS(); \
         UnityPrint(" ("); \
         UnityPrintNumberUnsigned(execTimeMs); \
         UnityPrint(" ms)"); \
@@ -386,8 +391,9 @@ typedef UNITY_FLOAT_TYPE UNITY_FLOAT;
       #define UNITY_GET_TIME(t) t = (clock_t)((clock() * 1000) / CLOCKS_PER_SEC)
       #define UNITY_EXEC_TIME_START() UNITY_GET_TIME(Unity.CurrentTestStartTime)
       #define UNITY_EXEC_TIME_STOP() UNITY_GET_TIME(Unity.CurrentTestStopTime)
+      #define UNITY_EXEC_TIME_MS() ((UNITY_UINT)(Unity.CurrentTestStopTime - Unity.CurrentTestStartTime))
       #define UNITY_PRINT_EXEC_TIME() { \
-        UNITY_UINT execTimeMs = (Unity.CurrentTestStopTime - Unity.CurrentTestStartTime); \
+        UNITY_UINT execTimeMs = UNITY_EXEC_TIME_MS(); \
         UnityPrint(" ("); \
         UnityPrintNumberUnsigned(execTimeMs); \
         UnityPrint(" ms)"); \
@@ -398,9 +404,10 @@ typedef UNITY_FLOAT_TYPE UNITY_FLOAT;
       #define UNITY_GET_TIME(t) clock_gettime(CLOCK_MONOTONIC, &t)
       #define UNITY_EXEC_TIME_START() UNITY_GET_TIME(Unity.CurrentTestStartTime)
       #define UNITY_EXEC_TIME_STOP() UNITY_GET_TIME(Unity.CurrentTestStopTime)
+      #define UNITY_EXEC_TIME_MS() ((UNITY_UINT)(((Unity.CurrentTestStopTime.tv_sec - Unity.CurrentTestStartTime.tv_sec) * 1000L) + \
+                                               ((Unity.CurrentTestStopTime.tv_nsec - Unity.CurrentTestStartTime.tv_nsec) / 1000000L)))
       #define UNITY_PRINT_EXEC_TIME() { \
-        UNITY_UINT execTimeMs = ((Unity.CurrentTestStopTime.tv_sec - Unity.CurrentTestStartTime.tv_sec) * 1000L); \
-        execTimeMs += ((Unity.CurrentTestStopTime.tv_nsec - Unity.CurrentTestStartTime.tv_nsec) / 1000000L); \
+        UNITY_UINT execTimeMs = UNITY_EXEC_TIME_MS(); \
         UnityPrint(" ("); \
         UnityPrintNumberUnsigned(execTimeMs); \
         UnityPrint(" ms)"); \
@@ -425,6 +432,37 @@ typedef UNITY_FLOAT_TYPE UNITY_FLOAT;
 #define UNITY_PRINT_EXEC_TIME() do { /* nothing*/ } while (0)
 #endif
 
+#ifdef UNITY_INCLUDE_BENCHMARK
+  /* Provided by extras/benchmark; appends benchmark statistics to a PASS line */
+  void UnityBenchmarkConcludeTest(void);
+  #define UNITY_PRINT_BENCHMARK() UnityBenchmarkConcludeTest()
+#endif
+
+#ifndef UNITY_PRINT_BENCHMARK
+#define UNITY_PRINT_BENCHMARK() do { /* nothing*/ } while (0)
+#endif
+
+/* Results can be written as JSON Lines or JUnit XML records instead of text.
+ * UNITY_OUTPUT_FOR_JSON_LINES or UNITY_OUTPUT_FOR_JUNIT_XML pick the format at
+ * compile time; UNITY_INCLUDE_STRUCTURED_OUTPUT alone leaves text as default
+ * and lets a runner choose with UnitySetOutputFormat or --format. */
+#if defined(UNITY_OUTPUT_FOR_JSON_LINES) || defined(UNITY_OUTPUT_FOR_JUNIT_XML)
+  #ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+  #define UNITY_INCLUDE_STRUCTURED_OUTPUT
+  #endif
+#endif
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+  /* Longest message kept for a test or info record; longer ones end in "..." */
+  #ifndef UNITY_STRUCTURED_MESSAGE_LENGTH
+  #define UNITY_STRUCTURED_MESSAGE_LENGTH 256
+  #endif
+  /* JUnit records held until the totals of the <testsuite> are known */
+  #ifndef UNITY_JUNIT_BUFFER_LENGTH
+  #define UNITY_JUNIT_BUFFER_LENGTH 4096
+  #endif
+#endif
+
 /*-------------------------------------------------------
  * Footprint
  *-------------------------------------------------------*/
@@ -505,6 +543,13 @@ typedef enum UNITY_FLOAT_TRAIT
 } UNITY_FLOAT_TRAIT_T;
 #endif
 
+typedef enum
+{
+    UNITY_OUTPUT_FORMAT_TEXT = 0,
+    UNITY_OUTPUT_FORMAT_JSON_LINES,
+    UNITY_OUTPUT_FORMAT_JUNIT_XML
+} UNITY_OUTPUT_FORMAT_T;
+
 typedef enum
 {
     UNITY_ARRAY_TO_VAL = 0,
@@ -545,6 +590,9 @@ void UnityBegin(const char* filename);
 int  UnityEnd(void);
 void UnitySetTestFile(const char* filename);
 void UnityConcludeTest(void);
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+void UnitySetOutputFormat(const UNITY_OUTPUT_FORMAT_T format);
+#endif
 
 #ifndef RUN_TEST
 void UnityDefaultTestRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum);
@@ -686,6 +734,26 @@ void UnityIgnore(const char* message, const UNITY_LINE_TYPE line);
 
 void UnityMessage(const char* message, const UNITY_LINE_TYPE line);
 
+#ifdef UNITY_INCLUDE_PRINT_FORMATTED
+void UnityAssertEqualNumberF(const UNITY_INT expected,
+                             const UNITY_INT actual,
+                             const UNITY_LINE_TYPE lineNumber,
+                             const UNITY_DISPLAY_STYLE_T style,
+                             const char* format, ...);
+
+void UnityAssertBitsF(const UNITY_INT mask,
+                      const UNITY_INT expected,
+                      const UNITY_INT actual,
+                      const UNITY_LINE_TYPE lineNumber,
+                      const char* format, ...);
+
+#ifndef UNITY_EXCLUDE_SETJMP_H
+UNITY_NORETURN void UnityFailF(const UNITY_LINE_TYPE line, const char* format, ...);
+#else
+void UnityFailF(const UNITY_LINE_TYPE line, const char* format, ...);
+#endif
+#endif
+
 #ifndef UNITY_EXCLUDE_FLOAT
 void UnityAssertFloatsWithin(const UNITY_FLOAT delta,
                              const UNITY_FLOAT expected,
@@ -872,9 +940,33 @@ extern const char UnityStrErrShorthand[];
  * Command Line Argument Support
  *-----------------------------------------------*/
 
+/* Whole-string glob match, '*' is any run of characters and '?' any one.
+ * The pattern also ends at , : ' or " so it can be matched within a list. */
+int UnityGlobMatch(const char* pattern, const char* string);
+
+/* Stable string hash, chain calls starting from UNITY_HASH_INIT */
+#define UNITY_HASH_INIT ((UNITY_UINT32)2166136261UL)
+UNITY_UINT32 UnityHashString(UNITY_UINT32 hash, const char* string);
+
+/* Monotonic timestamp in nanoseconds and square root, for the benchmark and
+ * fixture add-ons. UNITY_CLOCK_NS names a replacement clock function. */
+double UnityClockNs(void);
+double UnitySqrt(const double value);
+
 #ifdef UNITY_USE_COMMAND_LINE_ARGS
+typedef struct UNITY_TEST_ENTRY_T
+{
+    const char* Name;
+    UnityTestFunction Func;
+    UNITY_LINE_TYPE Line;
+    int ShardRank; /* position from slowest in a previous run, or -1 to shard by hash */
+} UNITY_TEST_ENTRY_T;
+
 int UnityParseOptions(int argc, char** argv);
 int UnityTestMatches(void);
+int UnityFileMatches(const char* file);
+void UnitySetTestTable(const UNITY_TEST_ENTRY_T* sortedTests, const int count);
+int UnityFindTestByName(const UNITY_TEST_ENTRY_T* sortedTests, const int count);
 #endif
 
 /*-------------------------------------------------------
@@ -1179,5 +1271,36 @@ int UnityTestMatches(void);
 #define UNITY_TEST_ASSERT_DOUBLE_IS_NOT_DETERMINATE(actual, line, message)                       UnityAssertDoubleSpecial((UNITY_DOUBLE)(actual), (message), (UNITY_LINE_TYPE)(line), UNITY_FLOAT_IS_NOT_DET)
 #endif
 
+/*-------------------------------------------------------
+ * Test Asserts with Formatted Messages
+ *-------------------------------------------------------*/
+
+#ifdef UNITY_INCLUDE_PRINT_FORMATTED
+#define UNITY_TEST_FAIL_MSGF(line, ...)                                                          UnityFailF((UNITY_LINE_TYPE)(line), __VA_ARGS__)
+#define UNITY_TEST_ASSERT_MSGF(condition, line, ...)                                             do { if (condition) { /* nothing*/ } else { UnityFailF((UNITY_LINE_TYPE)(line), __VA_ARGS__); } } while (0)
+#define UNITY_TEST_ASSERT_EQUAL_INT_MSGF(expected, actual, line, ...)                            UnityAssertEqualNumberF((UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_INT, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_INT8_MSGF(expected, actual, line, ...)                           UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT8 )(expected), (UNITY_INT)(UNITY_INT8 )(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_INT8, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_INT16_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT16)(expected), (UNITY_INT)(UNITY_INT16)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_INT16, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_INT32_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT32)(expected), (UNITY_INT)(UNITY_INT32)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_INT32, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_UINT_MSGF(expected, actual, line, ...)                           UnityAssertEqualNumberF((UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_UINT, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_UINT8_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(UNITY_UINT8 )(expected), (UNITY_INT)(UNITY_UINT8 )(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_UINT8, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_UINT16_MSGF(expected, actual, line, ...)                         UnityAssertEqualNumberF((UNITY_INT)(UNITY_UINT16)(expected), (UNITY_INT)(UNITY_UINT16)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_UINT16, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_UINT32_MSGF(expected, actual, line, ...)                         UnityAssertEqualNumberF((UNITY_INT)(UNITY_UINT32)(expected), (UNITY_INT)(UNITY_UINT32)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_UINT32, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_HEX8_MSGF(expected, actual, line, ...)                           UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT8 )(expected), (UNITY_INT)(UNITY_INT8 )(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_HEX8, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_HEX16_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT16)(expected), (UNITY_INT)(UNITY_INT16)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_HEX16, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_HEX32_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT32)(expected), (UNITY_INT)(UNITY_INT32)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_HEX32, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_CHAR_MSGF(expected, actual, line, ...)                           UnityAssertEqualNumberF((UNITY_INT)(UNITY_INT8 )(expected), (UNITY_INT)(UNITY_INT8 )(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_CHAR, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_BITS_MSGF(mask, expected, actual, line, ...)                           UnityAssertBitsF((UNITY_INT)(mask), (UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), __VA_ARGS__)
+#ifdef UNITY_SUPPORT_64
+#define UNITY_TEST_ASSERT_EQUAL_INT64_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_INT64, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_UINT64_MSGF(expected, actual, line, ...)                         UnityAssertEqualNumberF((UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_UINT64, __VA_ARGS__)
+#define UNITY_TEST_ASSERT_EQUAL_HEX64_MSGF(expected, actual, line, ...)                          UnityAssertEqualNumberF((UNITY_INT)(expected), (UNITY_INT)(actual), (UNITY_LINE_TYPE)(line), UNITY_DISPLAY_STYLE_HEX64, __VA_ARGS__)
+#else
+#define UNITY_TEST_ASSERT_EQUAL_INT64_MSGF(expected, actual, line, ...)                          UNITY_TEST_FAIL((UNITY_LINE_TYPE)(line), UnityStrErr64)
+#define UNITY_TEST_ASSERT_EQUAL_UINT64_MSGF(expected, actual, line, ...)                         UNITY_TEST_FAIL((UNITY_LINE_TYPE)(line), UnityStrErr64)
+#define UNITY_TEST_ASSERT_EQUAL_HEX64_MSGF(expected, actual, line, ...)                          UNITY_TEST_FAIL((UNITY_LINE_TYPE)(line), UnityStrErr64)
+#endif
+#endif
+
 /* End of UNITY_INTERNALS_H */
 #endif
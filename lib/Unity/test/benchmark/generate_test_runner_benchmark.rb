@@ -0,0 +1,88 @@
+# =========================================================================
+#   Unity - A Test Framework for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+# Times generate_test_runner.rb on a corpus of synthetic test files: once per
+# file as a build system calls it, in one batch, and again with every runner
+# cached.
+#
+#   ruby benchmark/generate_test_runner_benchmark.rb [file_count] [tests_per_file]
+#
+# 500 files of 40 tests are used by default.
+
+require_relative '../../auto/generate_test_runner'
+require 'tmpdir'
+require 'fileutils'
+
+GENERATOR = File.expand_path('../../auto/generate_test_runner.rb', __dir__)
+
+def synthetic_test_file(index, test_count)
+  lines = ['#include "unity.h"', "#include \"leds_module_#{index}.h\"", "#include \"Mockport_#{index % 13}.h\"", '#include <string.h>', '']
+  lines << '/* A block comment with a // inside and a fake test:'
+  lines << '   void test_ThisIsNotATest(void) { } */'
+  lines << "static const char* banner = \"{ not; a } block // nor a comment\";"
+  lines << 'static uint16_t virtual_port;' << ''
+  lines << 'void setUp(void)' << '{' << "    leds_init(&virtual_port);" << '}' << ''
+  lines << 'void tearDown(void)' << '{' << '}' << ''
+  test_count.times do |t|
+    lines << "// checks case #{t}; see the datasheet {p. #{t}}"
+    lines << "TEST_CASE(#{t}, \"led #{t}\")" if t.even?
+    lines << "void test_leds_module_#{index}_case_#{t}(#{t.even? ? 'int led, const char* name' : 'void'})"
+    lines << '{'
+    lines << "    leds_turn_on(#{t % 16});"
+    lines << "    TEST_ASSERT_EQUAL_HEX16(1 << #{t % 16}, virtual_port); /* on */"
+    lines << '}' << ''
+  end
+  lines.join("\n")
+end
+
+def timed
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  yield
+  Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+end
+
+file_count = (ARGV[0] || 500).to_i
+test_count = (ARGV[1] || 40).to_i
+options = { use_param_tests: true }
+
+Dir.mktmpdir('generate_test_runner_benchmark') do |dir|
+  tests = Array.new(file_count) do |i|
+    path = File.join(dir, "test_leds_module_#{i}.c")
+    File.write(path, synthetic_test_file(i, test_count))
+    path
+  end
+  runners = tests.map { |test| test.sub(/\.c$/, '_Runner.c') }
+  results = {}
+
+  results['one process per file'] = timed do
+    tests.each_with_index do |test, i|
+      system('ruby', GENERATOR, '--use_param_tests=1', test, runners[i]) || raise("#{GENERATOR} failed on #{test}")
+    end
+  end
+
+  results['one process per file, in Ruby'] = timed do
+    tests.each_with_index { |test, i| UnityTestRunnerGenerator.new(options).run(test, runners[i]) }
+  end
+
+  FileUtils.rm_f(runners)
+  results['batch, cold cache'] = timed do
+    system('ruby', GENERATOR, '-batch', '--use_param_tests=1', '--cache_runners=1', *tests) || raise("#{GENERATOR} -batch failed")
+  end
+
+  results['batch, warm cache'] = timed do
+    system('ruby', GENERATOR, '-batch', '--use_param_tests=1', '--cache_runners=1', *tests) || raise("#{GENERATOR} -batch failed")
+  end
+
+  FileUtils.touch(tests[0])
+  File.write(tests[1], "#{File.read(tests[1])}\nvoid test_added(void)\n{\n}\n")
+  results['batch, one file edited'] = timed do
+    system('ruby', GENERATOR, '-batch', '--use_param_tests=1', '--cache_runners=1', *tests) || raise("#{GENERATOR} -batch failed")
+  end
+
+  puts "#{file_count} test files of #{test_count} tests"
+  results.each { |name, time| printf "%-32s: %8.2f s %8.2f ms/file\n", name, time, time * 1000.0 / file_count }
+end
@@ -0,0 +1,86 @@
+# =========================================================================
+#   Unity - A Test Framework for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+# Times parse_output.rb on a synthetic log of repeated test runs, such as the
+# log of a soak test, and compares it to just reading the same file.
+#
+#   ruby benchmark/parse_output_benchmark.rb [size_in_mb] [log_file]
+#
+# The log is 2048 MB by default and is kept (and reused) when a file is given.
+
+require_relative '../../auto/parse_output'
+require 'tmpdir'
+
+TESTS_PER_RUN = 200
+
+# One run of a test executable: mostly passes, a few failures and ignores,
+# some output of the code under test and the summary.
+def synthetic_run(run)
+  lines = []
+  TESTS_PER_RUN.times do |i|
+    name = "test/test_leds_module_#{run % 7}.c:#{100 + i}:test_leds_case_#{i}"
+    lines << case i % 50
+             when 7  then "#{name}:FAIL: Expected 0x#{format('%04X', i)} Was 0x#{format('%04X', run & 0xFFFF)}. Led <#{i % 16}> & friends"
+             when 13 then "#{name}:IGNORE: Not yet implemented"
+             when 21 then "leds: port written 0x#{format('%04X', i)}\n#{name}:PASS (#{i % 5} ms)"
+             else "#{name}:PASS (#{i % 5} ms)"
+             end
+  end
+  lines << '' << '-----------------------' << "#{TESTS_PER_RUN} Tests 8 Failures 4 Ignored" << 'FAIL'
+  lines.join("\n") << "\n"
+end
+
+def write_log(path, size_mb)
+  runs = Array.new(64) { |run| synthetic_run(run) }
+  written = 0
+  File.open(path, 'wb') do |file|
+    while written < size_mb * 1024 * 1024
+      text = runs[(written / runs[0].bytesize) % runs.size]
+      file << text
+      written += text.bytesize
+    end
+  end
+end
+
+def peak_rss_mb
+  status = File.read('/proc/self/status') rescue ''
+  status =~ /VmHWM:\s+(\d+) kB/ ? (Regexp.last_match(1).to_i / 1024.0) : nil
+end
+
+def timed
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  yield
+  Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+end
+
+size_mb = (ARGV[0] || 2048).to_i
+Dir.mktmpdir('parse_output_benchmark') do |dir|
+  log = ARGV[1] || File.join(dir, 'output.txt')
+  unless File.exist?(log) && File.size(log) >= size_mb * 1024 * 1024
+    puts "Writing #{size_mb} MB synthetic log to #{log}"
+    write_log(log, size_mb)
+  end
+  bytes = File.size(log)
+  lines = 0
+
+  read_time = timed { File.open(log, 'rb') { |file| file.each_line { lines += 1 } } }
+
+  parser = ParseOutput.new
+  parser.set_xml_output
+  parser.set_quiet
+  parser.xml_file_name = File.join(dir, 'report.xml')
+  parse_time = timed { parser.process(log) }
+
+  mb = bytes / (1024.0 * 1024.0)
+  puts ''
+  puts '=================== BENCHMARK ==================='
+  printf "Log               : %.0f MB, %d lines\n", mb, lines
+  printf "Read only         : %8.2f s %8.1f MB/s\n", read_time, mb / read_time
+  printf "parse_output -xml : %8.2f s %8.1f MB/s %10.0f lines/s\n", parse_time, mb / parse_time, lines / parse_time
+  printf "report.xml        : %.0f MB\n", File.size(File.join(dir, 'report.xml')) / (1024.0 * 1024.0)
+  printf "Peak RSS          : %.0f MB\n", peak_rss_mb if peak_rss_mb
+end
@@ -225,7 +225,8 @@ module RakefileHelpers
 
   def test_memory()
     { 'w_malloc' => [],
-      'wo_malloc' => ['UNITY_EXCLUDE_STDLIB_MALLOC']
+      'wo_malloc' => ['UNITY_EXCLUDE_STDLIB_MALLOC'],
+      'wo_malloc_pools' => ['UNITY_EXCLUDE_STDLIB_MALLOC', 'UNITY_INTERNAL_HEAP_POOLS']
     }.each_pair do |name, defs|
       report "\nRunning Memory Addon #{name}"
 
@@ -249,6 +250,77 @@ module RakefileHelpers
     end
   end
 
+  def test_benchmark()
+    report "\nRunning Benchmark Addon"
+
+    # Get a list of all source files needed
+    src_files  = Dir[File.join('..','extras','benchmark','src','*.c')]
+    src_files += Dir[File.join('..','extras','benchmark','test','*.c')]
+    src_files << File.join('..','extras','memory','test','unity_output_Spy.c')
+    src_files << File.join('..','src','unity.c')
+
+    # Build object files
+    $extra_paths = [File.join('..','extras','benchmark','src'), File.join('..','extras','memory','test')]
+    defs = ['UNITY_INCLUDE_BENCHMARK', 'UNITY_BENCHMARK_CLOCK_NS=FakeClockNs', 'UNITY_INCLUDE_STRUCTURED_OUTPUT',
+            'UNITY_OUTPUT_CHAR=UnityOutputCharSpy_OutputChar', 'UNITY_OUTPUT_CHAR_HEADER_DECLARATION=UnityOutputCharSpy_OutputChar\\(int\\)',
+            'BENCHMARK_BASELINE_PATH=\\"build/benchmark_baseline.txt\\"']
+    obj_list = src_files.map { |f| compile(f, defs) }
+
+    # Link the test executable
+    test_base = File.basename('benchmark_test', C_EXTENSION)
+    link_it(test_base, obj_list)
+
+    # Run and collect output
+    output = runtest(test_base)
+    save_test_results(test_base, output)
+  end
+
+  def test_registry()
+    report "\nRunning Registry Addon"
+
+    # Get a list of all source files needed
+    src_files  = Dir[File.join('..','extras','registry','src','*.c')]
+    src_files += Dir[File.join('..','extras','registry','test','*.c')]
+    src_files << File.join('..','extras','memory','test','unity_output_Spy.c')
+    src_files << File.join('..','src','unity.c')
+
+    # Build object files
+    $extra_paths = [File.join('..','extras','registry','src'), File.join('..','extras','memory','test')]
+    defs = ['UNITY_OUTPUT_CHAR=UnityOutputCharSpy_OutputChar', 'UNITY_OUTPUT_CHAR_HEADER_DECLARATION=UnityOutputCharSpy_OutputChar\\(int\\)']
+    obj_list = src_files.map { |f| compile(f, defs) }
+
+    # Link the test executable
+    test_base = File.basename('registry_test', C_EXTENSION)
+    link_it(test_base, obj_list)
+
+    # Run and collect output
+    output = runtest(test_base)
+    save_test_results(test_base, output)
+  end
+
+  def test_property()
+    report "\nRunning Property Addon"
+
+    # Get a list of all source files needed
+    src_files  = Dir[File.join('..','extras','property','src','*.c')]
+    src_files += Dir[File.join('..','extras','property','test','*.c')]
+    src_files << File.join('..','extras','memory','test','unity_output_Spy.c')
+    src_files << File.join('..','src','unity.c')
+
+    # Build object files
+    $extra_paths = [File.join('..','extras','property','src'), File.join('..','extras','memory','test')]
+    defs = ['UNITY_OUTPUT_CHAR=UnityOutputCharSpy_OutputChar', 'UNITY_OUTPUT_CHAR_HEADER_DECLARATION=UnityOutputCharSpy_OutputChar\\(int\\)']
+    obj_list = src_files.map { |f| compile(f, defs) }
+
+    # Link the test executable
+    test_base = File.basename('property_test', C_EXTENSION)
+    link_it(test_base, obj_list)
+
+    # Run and collect output
+    output = runtest(test_base)
+    save_test_results(test_base, output)
+  end
+
   def run_tests(test_files)
     report "\nRunning Unity system tests"
 
@@ -306,8 +378,9 @@ module RakefileHelpers
       "make -s UNITY_INCLUDE_DOUBLE= ",        # test without double
       "cd #{File.join("..","extras","fixture",'test')} && make -s default noStdlibMalloc",
       "cd #{File.join("..","extras","fixture",'test')} && make -s C89",
-      "cd #{File.join("..","extras","memory",'test')} && make -s default noStdlibMalloc",
+      "cd #{File.join("..","extras","memory",'test')} && make -s default noStdlibMalloc pools",
       "cd #{File.join("..","extras","memory",'test')} && make -s C89",
+      "cd #{File.join("..","extras","benchmark",'test')} && make -s default C89",
     ].each do |cmd|
       report "Testing '#{cmd}'"
       execute(cmd, false)
@@ -0,0 +1,56 @@
+# =========================================================================
+#   Unity - A Test Framework for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require '../auto/generate_test_runner.rb'
+require 'fileutils'
+
+describe 'UnityTestRunnerGenerator with cached runners' do
+  def write_test(file, tests)
+    File.write("sandbox/#{file}", tests.map { |t| "void #{t}(void)\n{\n}\n" }.join)
+  end
+
+  def generate(options = { cache_runners: true })
+    UnityTestRunnerGenerator.new(options).run('sandbox/test_meh.c', 'sandbox/test_meh_Runner.c')
+  end
+
+  before do
+    FileUtils.rm_rf 'sandbox'
+    FileUtils.mkdir_p 'sandbox'
+    write_test('test_meh.c', %w[test_one test_two])
+  end
+
+  it 'does not write the runner again while the test file is unchanged' do
+    files_used = generate
+    File.write('sandbox/test_meh_Runner.c', File.read('sandbox/test_meh_Runner.c') + '/* kept */')
+
+    expect(generate).to eq(files_used)
+    expect(File.read('sandbox/test_meh_Runner.c')).to end_with('/* kept */')
+  end
+
+  it 'writes the runner again when the test file changes' do
+    generate
+    write_test('test_meh.c', %w[test_one test_two test_three])
+    generate
+
+    expect(File.read('sandbox/test_meh_Runner.c')).to include('test_three')
+  end
+
+  it 'writes the runner again when the options change' do
+    generate
+    generate(cache_runners: true, test_prefix: 'test_t')
+
+    expect(File.read('sandbox/test_meh_Runner.c')).not_to include('test_one')
+  end
+
+  it 'generates the runners of many files in one batch' do
+    write_test('test_other.c', %w[test_three])
+    UnityTestRunnerGenerator.run_batch({ cache_runners: true }, ['sandbox/test_meh.c', 'sandbox/test_other.c'], 'sandbox/runners')
+
+    expect(File.read('sandbox/runners/test_meh_Runner.c')).to include('test_two')
+    expect(File.read('sandbox/runners/test_other_Runner.c')).to include('test_three')
+  end
+end
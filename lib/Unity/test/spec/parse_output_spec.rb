@@ -0,0 +1,68 @@
+# =========================================================================
+#   Unity - A Test Framework for C
+#   ThrowTheSwitch.org
+#   Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+#   SPDX-License-Identifier: MIT
+# =========================================================================
+
+require '../auto/parse_output.rb'
+require 'fileutils'
+require 'rexml/document'
+
+describe 'ParseOutput' do
+  def write_log(lines)
+    File.open('sandbox/output.txt', 'w') { |f| f.puts(lines) }
+  end
+
+  def parse_log
+    parser = ParseOutput.new
+    parser.set_xml_output
+    parser.set_quiet
+    parser.xml_file_name = 'sandbox/report.xml'
+    expect { parser.process('sandbox/output.txt') }.to output(/Tests Passed/).to_stdout
+    REXML::Document.new(File.read('sandbox/report.xml'))
+  end
+
+  before do
+    FileUtils.rm_rf 'sandbox'
+    FileUtils.mkdir_p 'sandbox'
+  end
+
+  it 'writes one suite with its totals and test cases' do
+    write_log ['test/test_leds.c:10:test_on:PASS',
+               'test/test_leds.c:20:test_off:FAIL: Expected 1 Was <2>',
+               'test/test_leds.c:30:test_later:IGNORE: not yet',
+               '-----------------------',
+               '3 Tests 1 Failures 1 Ignored',
+               'FAIL']
+    suites = parse_log.get_elements('testsuites/testsuite')
+
+    expect(suites.size).to eq(1)
+    expect(suites[0].attributes['tests']).to eq('3')
+    expect(suites[0].attributes['failures']).to eq('1')
+    expect(suites[0].attributes['skips']).to eq('1')
+    expect(suites[0].get_elements('testcase').map { |t| t.attributes['name'] }).to eq(%w[test_on test_off test_later])
+    expect(suites[0].get_text('testcase/failure').value).to start_with('Expected 1 Was <2>')
+  end
+
+  it 'starts a new suite after every summary line' do
+    write_log ['test/test_leds.c:10:test_on:PASS',
+               '1 Tests 0 Failures 0 Ignored',
+               'OK',
+               'test/test_leds.c:10:test_on:PASS',
+               'test/test_leds.c:20:test_off:FAIL: Expected 1 Was 2',
+               '2 Tests 1 Failures 0 Ignored',
+               'FAIL',
+               'test/test_leds.c:10:test_on:PASS']
+    suites = parse_log.get_elements('testsuites/testsuite')
+
+    expect(suites.map { |s| s.attributes['tests'] }).to eq(%w[1 2 1])
+    expect(suites.map { |s| s.attributes['failures'] }).to eq(%w[0 1 0])
+  end
+
+  it 'writes an empty report when there are no results' do
+    write_log ['nothing to see here']
+
+    expect(parse_log.get_elements('testsuites/testsuite')).to be_empty
+  end
+end
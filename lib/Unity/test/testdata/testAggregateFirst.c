@@ -0,0 +1,39 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+/* This Test File Is Linked With testAggregateSecond.c Into One Aggregated Runner.
+   Both define setUp, tearDown and a test of the same name. */
+
+#include "unity.h"
+
+static int CounterSetup = 0;
+static int CounterTeardown = 0;
+
+void setUp(void)
+{
+    CounterSetup = 1;
+}
+
+void tearDown(void)
+{
+    CounterTeardown = 1;
+}
+
+void test_TheSetUpOfThisFileRan(void)
+{
+    TEST_ASSERT_EQUAL_MESSAGE(1, CounterSetup, "Setup Of The First File Wasn't Run");
+}
+
+void test_TheTearDownOfThisFileRan(void)
+{
+    TEST_ASSERT_EQUAL_MESSAGE(1, CounterTeardown, "Teardown Of The First File Wasn't Run");
+}
+
+void test_ThisTestAlwaysFails(void)
+{
+    TEST_FAIL_MESSAGE("This Test Should Fail");
+}
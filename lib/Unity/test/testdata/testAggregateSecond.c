@@ -0,0 +1,39 @@
+/* =========================================================================
+    Unity - A Test Framework for C
+    ThrowTheSwitch.org
+    Copyright (c) 2007-24 Mike Karlesky, Mark VanderVoord, & Greg Williams
+    SPDX-License-Identifier: MIT
+========================================================================= */
+
+/* This Test File Is Linked With testAggregateFirst.c Into One Aggregated Runner.
+   It has no tearDown, so the generated stub must not clash with the first file's. */
+
+#include "unity.h"
+
+static int CounterSetup = 0;
+static int CounterSuiteSetup = 0;
+
+void suiteSetUp(void)
+{
+    CounterSuiteSetup = 1;
+}
+
+void setUp(void)
+{
+    CounterSetup = 2;
+}
+
+void test_TheSetUpOfThisFileRan(void)
+{
+    TEST_ASSERT_EQUAL_MESSAGE(2, CounterSetup, "Setup Of The Second File Wasn't Run");
+}
+
+void test_TheSuiteSetUpOfThisFileRan(void)
+{
+    TEST_ASSERT_EQUAL_MESSAGE(1, CounterSuiteSetup, "Suite Setup Of The Second File Wasn't Run");
+}
+
+void test_ThisTestAlwaysIgnored(void)
+{
+    TEST_IGNORE_MESSAGE("This Test Should Be Ignored");
+}
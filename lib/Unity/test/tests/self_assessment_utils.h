@@ -66,7 +66,9 @@ static const UNITY_DOUBLE d_zero = 0.0;
 
 #ifdef USING_OUTPUT_SPY
 #include <stdio.h>
+#ifndef SPY_BUFFER_MAX
 #define SPY_BUFFER_MAX 40
+#endif
 static char putcharSpyBuffer[SPY_BUFFER_MAX];
 #endif
 static UNITY_COUNTER_TYPE indexSpyBuffer;
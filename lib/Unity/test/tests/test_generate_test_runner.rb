@@ -71,6 +71,25 @@ RUNNER_TESTS = [
     }
   },
 
+  { :name => 'CachedRunnerThroughCommandLine',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST'],
+    :cmdline => "--cache_runners=1",
+    :expected => {
+      :to_pass => [ 'test_ThisTestAlwaysPasses',
+                    'spec_ThisTestPassesWhenNormalSetupRan',
+                    'spec_ThisTestPassesWhenNormalTeardownRan',
+                    'test_NotBeConfusedByLongComplicatedStrings',
+                    'test_NotDisappearJustBecauseTheTestBeforeAndAfterHaveCrazyStrings',
+                    'test_StillNotBeConfusedByLongComplicatedStrings',
+                    'should_RunTestsStartingWithShouldByDefault',
+                    'spec_ThisTestPassesWhenNormalSuiteSetupAndTeardownRan',
+                  ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
   { :name => 'ShorterFilterOfJustTest',
     :testfile => 'testdata/testRunnerGenerator.c',
     :testdefines => ['TEST'],
@@ -1073,6 +1092,240 @@ RUNNER_TESTS = [
     }
   },
 
+  { :name => 'ArgsIncludeWithGlob',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-f 'test_*Always*'",
+    :expected => {
+      :to_pass => [ 'test_ThisTestAlwaysPasses' ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'ArgsIncludeWithSingleCharacterGlob',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-f 'ThisTestAlways?a*'",
+    :expected => {
+      :to_pass => [ 'test_ThisTestAlwaysPasses' ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsHandlePreciseMatchWithGlob',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-n 'spec_*Ran'",
+    :expected => {
+      :to_pass => [ 'spec_ThisTestPassesWhenNormalSetupRan',
+                    'spec_ThisTestPassesWhenNormalTeardownRan',
+                    'spec_ThisTestPassesWhenNormalSuiteSetupAndTeardownRan',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsExcludeWithGlob',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-f test_ -x '*Always*,*Still*'",
+    :expected => {
+      :to_pass => [ 'test_NotBeConfusedByLongComplicatedStrings',
+                    'test_NotDisappearJustBecauseTheTestBeforeAndAfterHaveCrazyStrings',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsHandlePreciseMatchOfParameterizedTest',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :cmdline => "--use_param_tests=1",
+    :yaml => {
+      :cmdline_args => true,
+      :test_prefix => "paratest"
+    },
+    :cmdline_args => "-n 'paratest_ShouldHandleParameterizedTests(125)'",
+    :features => [ :parameterized ],
+    :expected => {
+      :to_pass => [ 'paratest_ShouldHandleParameterizedTests\(125\)' ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsFirstShardByHash',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--shard 1/2",
+    :expected => {
+      :to_pass => [ 'should_RunTestsStartingWithShouldByDefault',
+                    'spec_ThisTestPassesWhenNormalSuiteSetupAndTeardownRan',
+                    'spec_ThisTestPassesWhenNormalTeardownRan',
+                    'test_NotDisappearJustBecauseTheTestBeforeAndAfterHaveCrazyStrings',
+                    'test_ThisTestAlwaysPasses',
+                  ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsSecondShardByHash',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--shard 2/2",
+    :expected => {
+      :to_pass => [ 'spec_ThisTestPassesWhenNormalSetupRan',
+                    'test_NotBeConfusedByLongComplicatedStrings',
+                    'test_StillNotBeConfusedByLongComplicatedStrings',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'ArgsShardWithFilter',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-f test_ --shard 2/2",
+    :expected => {
+      :to_pass => [ 'test_NotBeConfusedByLongComplicatedStrings',
+                    'test_StillNotBeConfusedByLongComplicatedStrings',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'ArgsFirstShardBalancedByTimings',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+      :shard_timings => 'testdata/testRunnerGeneratorTimings.txt',
+    },
+    :cmdline_args => "--shard 1/3",
+    :expected => {
+      :to_pass => [ 'test_ThisTestAlwaysPasses',
+                    'test_NotBeConfusedByLongComplicatedStrings',
+                    'test_NotDisappearJustBecauseTheTestBeforeAndAfterHaveCrazyStrings',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'ArgsLastShardBalancedByTimings',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+      :shard_timings => 'testdata/testRunnerGeneratorTimings.txt',
+    },
+    :cmdline_args => "--shard 3/3",
+    :expected => {
+      :to_pass => [ 'should_RunTestsStartingWithShouldByDefault',
+                    'spec_ThisTestPassesWhenNormalSuiteSetupAndTeardownRan',
+                    'spec_ThisTestPassesWhenNormalSetupRan',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'ArgsIllegalShard',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--shard 3/2",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [ "ERROR: Expected --shard INDEX/COUNT" ],
+    }
+  },
+
+  { :name => 'ArgsFormatJsonLines',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS', 'UNITY_INCLUDE_STRUCTURED_OUTPUT'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--format json -n test_ThisTestAlwaysFails,test_ThisTestAlwaysPasses",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [ '^\\{"event":"begin","file":"[^"]*testRunnerGenerator.c"\\}$',
+                 '^\\{"event":"test",.*"test":"test_ThisTestAlwaysPasses","line":\\d+,"status":"PASS"\\}$',
+                 '^\\{"event":"test",.*"test":"test_ThisTestAlwaysFails",.*"status":"FAIL","result_line":\\d+,"message":"This Test Should Fail"\\}$',
+                 '^\\{"event":"end",.*"tests":2,"failures":1,"ignored":0\\}$' ],
+    }
+  },
+
+  { :name => 'ArgsFormatJUnitXml',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS', 'UNITY_INCLUDE_STRUCTURED_OUTPUT'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--format junit -n test_ThisTestAlwaysIgnored",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [ '^<\\?xml version="1.0" encoding="UTF-8"\\?>$',
+                 '^<testsuite name="[^"]*testRunnerGenerator.c" tests="1" failures="0" ignored="1">$',
+                 '^  <testcase classname="[^"]*" name="test_ThisTestAlwaysIgnored" file="[^"]*" line="\\d+">$',
+                 '^    <skipped message="This Test Should Be Ignored" line="\\d+"/>$',
+                 '^  </testcase>$',
+                 '^</testsuite>$' ],
+    }
+  },
+
+  { :name => 'ArgsIllegalFormat',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS', 'UNITY_INCLUDE_STRUCTURED_OUTPUT'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--format yaml",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [ "ERROR: Expected --format text, json or junit" ],
+    }
+  },
+
   { :name => 'ArgsIncludeWithAlternateFlag',
     :testfile => 'testdata/testRunnerGenerator.c',
     :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
@@ -1134,6 +1387,32 @@ RUNNER_TESTS = [
     }
   },
 
+  { :name => 'ArgsLongList',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--list",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [  "testRunnerGenerator",
+                  "test_ThisTestAlwaysPasses",
+                  "test_ThisTestAlwaysFails",
+                  "test_ThisTestAlwaysIgnored",
+                  "spec_ThisTestPassesWhenNormalSuiteSetupAndTeardownRan",
+                  "spec_ThisTestPassesWhenNormalSetupRan",
+                  "spec_ThisTestPassesWhenNormalTeardownRan",
+                  "test_NotBeConfusedByLongComplicatedStrings",
+                  "test_NotDisappearJustBecauseTheTestBeforeAndAfterHaveCrazyStrings",
+                  "test_StillNotBeConfusedByLongComplicatedStrings",
+                  "should_RunTestsStartingWithShouldByDefault"
+               ]
+    }
+  },
+
   { :name => 'ArgsListParameterized',
     :testfile => 'testdata/testRunnerGenerator.c',
     :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
@@ -1211,6 +1490,8 @@ RUNNER_TESTS = [
         "-q        Quiet/decrease verbosity",
         "-v        increase Verbosity",
         "-x NAME   eXclude tests whose name includes NAME",
+        "--shard INDEX/COUNT  Run only shard INDEX \\(from 1\\) of COUNT",
+        "--file NAME  Run only tests of the files whose name includes NAME",
       ],
     }
   },
@@ -1235,9 +1516,106 @@ RUNNER_TESTS = [
         "-q        Quiet/decrease verbosity",
         "-v        increase Verbosity",
         "-x NAME   eXclude tests whose name includes NAME",
+        "--shard INDEX/COUNT  Run only shard INDEX \\(from 1\\) of COUNT",
+        "--file NAME  Run only tests of the files whose name includes NAME",
       ],
     }
   },
+
+  { :name => 'ArgsFilterByFile',
+    :testfile => 'testdata/testRunnerGenerator.c',
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--file OtherFile.c",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+]
+
+AGGREGATE_TESTS = [
+  { :name => 'AggregateRunsEveryFile',
+    :testfiles => ['testdata/testAggregateFirst.c', 'testdata/testAggregateSecond.c'],
+    :testdefines => ['TEST'],
+    :options => nil,
+    :expected => {
+      :to_pass => [ 'test_TheSetUpOfThisFileRan',
+                    'test_TheSetUpOfThisFileRan',
+                    'test_TheTearDownOfThisFileRan',
+                    'test_TheSuiteSetUpOfThisFileRan',
+                  ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'AggregateSuiteSetUpOnlyInFirstFile',
+    :testfiles => ['testdata/testAggregateSecond.c', 'testdata/testAggregateFirst.c'],
+    :testdefines => ['TEST'],
+    :cmdline => "",
+    :expected => {
+      :to_pass => [ 'test_TheSetUpOfThisFileRan',
+                    'test_TheSuiteSetUpOfThisFileRan',
+                    'test_TheSetUpOfThisFileRan',
+                    'test_TheTearDownOfThisFileRan',
+                  ],
+      :to_fail => [ 'test_ThisTestAlwaysFails' ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'AggregateThroughCommandLine',
+    :testfiles => ['testdata/testAggregateFirst.c', 'testdata/testAggregateSecond.c'],
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :cmdline => "--cmdline_args=1",
+    :cmdline_args => "-n test_TheSetUpOfThisFileRan",
+    :expected => {
+      :to_pass => [ 'test_TheSetUpOfThisFileRan',
+                    'test_TheSetUpOfThisFileRan',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+    }
+  },
+
+  { :name => 'AggregateFilterByFile',
+    :testfiles => ['testdata/testAggregateFirst.c', 'testdata/testAggregateSecond.c'],
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "--file Second",
+    :expected => {
+      :to_pass => [ 'testAggregateSecond.c:\\d+:test_TheSetUpOfThisFileRan',
+                    'test_TheSuiteSetUpOfThisFileRan',
+                  ],
+      :to_fail => [ ],
+      :to_ignore => [ 'test_ThisTestAlwaysIgnored' ],
+    }
+  },
+
+  { :name => 'AggregateListFilteredByFile',
+    :testfiles => ['testdata/testAggregateFirst.c', 'testdata/testAggregateSecond.c'],
+    :testdefines => ['TEST', 'UNITY_USE_COMMAND_LINE_ARGS'],
+    :options => {
+      :cmdline_args => true,
+    },
+    :cmdline_args => "-l --file First",
+    :expected => {
+      :to_pass => [ ],
+      :to_fail => [ ],
+      :to_ignore => [ ],
+      :text => [ "testdata/testAggregateFirst\\.",
+                 "  test_TheSetUpOfThisFileRan",
+                 "  test_TheTearDownOfThisFileRan",
+                 "  test_ThisTestAlwaysFails",
+               ],
+    }
+  },
 ]
 
 def runner_test(test, runner, expected, test_defines, cmdline_args, features)
@@ -1265,7 +1643,27 @@ def runner_test(test, runner, expected, test_defines, cmdline_args, features)
 
   # Execute unit test and generate results file
   output = runtest(test_base, true, cmdline_args)
+  verify_output(expected, output)
+end
+
+def aggregate_test(runner, suites, expected, test_defines, cmdline_args)
+  load_configuration($cfg_file)
+
+  #compile objects, the suites include the test files themselves
+  obj_list = suites.map { |suite| compile(suite, test_defines) }
+  obj_list << compile(runner, test_defines)
+  obj_list << compile('../src/unity.c', test_defines)
 
+  # Link the test executable
+  test_base = File.basename(runner, C_EXTENSION)
+  link_it(test_base, obj_list)
+
+  # Execute unit test and generate results file
+  output = runtest(test_base, true, cmdline_args)
+  verify_output(expected, output)
+end
+
+def verify_output(expected, output)
   #compare to the expected pass/fail
   allgood = expected[:to_pass].inject(true)      {|s,v| s && verify_match(/#{v}:PASS/,   output) }
   allgood = expected[:to_fail].inject(allgood)   {|s,v| s && verify_match(/#{v}:FAIL/,   output) }
@@ -1338,4 +1736,28 @@ RUNNER_TESTS.each do |testset|
   end
 end
 
+AGGREGATE_TESTS.each do |testset|
+  testset_name = "Runner_Aggregate_#{testset[:name]}"
+  should testset_name do
+    runner_name = OUT_FILE + testset[:name] + '_runner.c'
+    suites = testset[:testfiles].map { |f| "build/#{File.basename(f, C_EXTENSION)}_Suite.c" }
+
+    #run script via command line or through hash function call, as requested
+    if (testset[:cmdline])
+      files = testset[:testfiles].map { |f| "\"#{f}\"" }.join(' ')
+      `ruby ../auto/generate_test_runner.rb #{testset[:cmdline]} --aggregate="#{runner_name}" #{files}`
+    else
+      UnityTestRunnerGenerator.new(testset[:options]).run_aggregate(testset[:testfiles], runner_name)
+    end
+
+    if (aggregate_test(runner_name, suites, testset[:expected], testset[:testdefines], testset[:cmdline_args]))
+      report "#{testset_name}:PASS"
+    else
+      report "#{testset_name}:FAIL"
+      $generate_test_runner_failures += 1
+    end
+    $generate_test_runner_tests += 1
+  end
+end
+
 raise "There were #{$generate_test_runner_failures.to_s} failures while testing generate_test_runner.rb" if ($generate_test_runner_failures > 0)
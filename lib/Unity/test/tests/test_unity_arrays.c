@@ -2939,3 +2939,91 @@ void testVerifyIntFailingPointerComparisonOnZeroLengthArray(void)
     VERIFY_FAILS_END
 #endif
 }
+
+void testVerifyEachEqualFailingPointerComparisonOnZeroLengthArray(void)
+{
+    int a[] = { 1 };
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EACH_EQUAL_INT(1, a, 0);
+    VERIFY_FAILS_END
+}
+
+void testEqualUINT16LongArrays(void)
+{
+    UNITY_UINT16 expected[1001];
+    UNITY_UINT16 actual[1001];
+    int i;
+
+    for (i = 0; i < 1001; i++)
+    {
+        expected[i] = actual[i] = (UNITY_UINT16)(i * 131);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, actual, 1001);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(&expected[1], &actual[1], 1000);
+}
+
+void testNotEqualUINT16LongArraysLastElement(void)
+{
+    UNITY_UINT16 expected[1001];
+    UNITY_UINT16 actual[1001];
+    int i;
+
+    for (i = 0; i < 1001; i++)
+    {
+        expected[i] = actual[i] = (UNITY_UINT16)(i * 131);
+    }
+    actual[1000] ^= 0x8000;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, actual, 1001);
+    VERIFY_FAILS_END
+}
+
+void testEqualUINT16LongEachEqual(void)
+{
+    UNITY_UINT16 actual[1001];
+    int i;
+
+    for (i = 0; i < 1001; i++)
+    {
+        actual[i] = 0xA55A;
+    }
+
+    TEST_ASSERT_EACH_EQUAL_UINT16(0xA55A, actual, 1001);
+    TEST_ASSERT_EACH_EQUAL_HEX16(0xA55A, &actual[1], 1000);
+}
+
+void testNotEqualUINT16LongEachEqualLastElement(void)
+{
+    UNITY_UINT16 actual[1001];
+    int i;
+
+    for (i = 0; i < 1001; i++)
+    {
+        actual[i] = 0xA55A;
+    }
+    actual[1000] = 0xA55B;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EACH_EQUAL_UINT16(0xA55A, actual, 1001);
+    VERIFY_FAILS_END
+}
+
+void testNotEqualINT8LongArraysUnaligned(void)
+{
+    UNITY_INT8 expected[257];
+    UNITY_INT8 actual[257];
+    int i;
+
+    for (i = 0; i < 257; i++)
+    {
+        expected[i] = actual[i] = (UNITY_INT8)i;
+    }
+    actual[200] = 0;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EQUAL_INT8_ARRAY(&expected[1], &actual[1], 256);
+    VERIFY_FAILS_END
+}
@@ -7,6 +7,7 @@
 
 #include "unity.h"
 #define TEST_INSTANCES
+#define SPY_BUFFER_MAX 512 /* room for a few structured output records */
 #include "self_assessment_utils.h"
 
 static int SetToOneToFailInTearDown;
@@ -373,3 +374,196 @@ void testThatDetailsCanBeHandleSingleDetailClearingTwoDetails(void)
     VERIFY_FAILS_END
 #endif
 }
+
+void testGlobMatchWithoutWildcardsNeedsWholeString(void)
+{
+    TEST_ASSERT_TRUE(UnityGlobMatch("test_Name", "test_Name"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("test_Name", "test_Names"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("test_Name", "test_Nam"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("", ""));
+}
+
+void testGlobMatchHandlesWildcards(void)
+{
+    TEST_ASSERT_TRUE(UnityGlobMatch("*", ""));
+    TEST_ASSERT_TRUE(UnityGlobMatch("test_*", "test_Name"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("*Name", "test_Name"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("t*_*e", "test_Name"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("test_N?me", "test_Name"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("*a*a*a", "banana_a"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("test_N?me", "test_Nme"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("*Names", "test_Name"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("?*b", "a"));
+}
+
+void testGlobMatchStopsAtListSeparators(void)
+{
+    TEST_ASSERT_TRUE(UnityGlobMatch("test_*,other", "test_Name"));
+    TEST_ASSERT_TRUE(UnityGlobMatch("test_Name:rest", "test_Name"));
+    TEST_ASSERT_FALSE(UnityGlobMatch("test_Name,other", "other"));
+}
+
+#ifdef UNITY_INCLUDE_STRUCTURED_OUTPUT
+/* Runs a small suite of one failing, passing or ignored test, plus a message,
+ * in the given format, then puts back the state of the suite running us */
+static void runStructuredSuite(const UNITY_OUTPUT_FORMAT_T format, const int outcome)
+{
+    struct UNITY_STORAGE_T savedUnity = Unity;
+
+    UnitySetOutputFormat(format);
+    startPutcharSpy();
+    UnityBegin("a.c");
+    Unity.CurrentTestName = "t";
+    Unity.CurrentTestLineNumber = 7;
+    Unity.NumberOfTests++;
+    if (TEST_PROTECT())
+    {
+        UnityMessage("x<\"y\"", 8);
+        if (outcome == 'F')
+        {
+            UNITY_TEST_ASSERT_EQUAL_INT(1, 2, 9, "m&sg");
+        }
+        else if (outcome == 'I')
+        {
+            UNITY_TEST_IGNORE(9, "later");
+        }
+    }
+    if ((outcome == 'T') && TEST_PROTECT())
+    {
+        /* fails twice, as with a runner that carries on into tearDown */
+        UNITY_TEST_ASSERT_EQUAL_INT(1, 2, 9, "m&sg");
+    }
+    if ((outcome == 'T') && TEST_PROTECT())
+    {
+        Unity.CurrentTestFailed = 0;
+        UNITY_TEST_FAIL(10, "again");
+    }
+    UnityConcludeTest();
+    UnityEnd();
+    endPutcharSpy();
+    UnitySetOutputFormat(UNITY_OUTPUT_FORMAT_TEXT);
+    Unity = savedUnity;
+}
+#endif
+
+void testStructuredOutputWritesJsonLines(void)
+{
+#ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    TEST_IGNORE();
+#else
+    runStructuredSuite(UNITY_OUTPUT_FORMAT_JSON_LINES, 'F');
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"event\":\"begin\",\"file\":\"a.c\"}\n"
+        "{\"event\":\"info\",\"file\":\"a.c\",\"test\":\"t\",\"line\":8,\"message\":\"x<\\\"y\\\"\"}\n"
+        "{\"event\":\"test\",\"file\":\"a.c\",\"test\":\"t\",\"line\":7,\"status\":\"FAIL\","
+        "\"result_line\":9,\"message\":\"Expected 1 Was 2. m&sg\"}\n"
+        "{\"event\":\"end\",\"file\":\"a.c\",\"tests\":1,\"failures\":1,\"ignored\":0}\n",
+        getBufferPutcharSpy());
+#endif
+}
+
+void testStructuredOutputWritesJUnitXml(void)
+{
+#ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    TEST_IGNORE();
+#else
+    runStructuredSuite(UNITY_OUTPUT_FORMAT_JUNIT_XML, 'I');
+    TEST_ASSERT_EQUAL_STRING(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<testsuite name=\"a.c\" tests=\"1\" failures=\"0\" ignored=\"1\">\n"
+        "  <system-out>a.c:8:t: x&lt;&quot;y&quot;</system-out>\n"
+        "  <testcase classname=\"a.c\" name=\"t\" file=\"a.c\" line=\"7\">\n"
+        "    <skipped message=\"later\" line=\"9\"/>\n"
+        "  </testcase>\n"
+        "</testsuite>\n",
+        getBufferPutcharSpy());
+#endif
+}
+
+void testStructuredOutputKeepsEveryFailureMessage(void)
+{
+#ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    TEST_IGNORE();
+#else
+    runStructuredSuite(UNITY_OUTPUT_FORMAT_JSON_LINES, 'T');
+    TEST_ASSERT_NOT_NULL(strstr(getBufferPutcharSpy(),
+        "\"status\":\"FAIL\",\"result_line\":9,\"message\":\"Expected 1 Was 2. m&sg\\nagain\"}\n"));
+
+    runStructuredSuite(UNITY_OUTPUT_FORMAT_JUNIT_XML, 'T');
+    TEST_ASSERT_NOT_NULL(strstr(getBufferPutcharSpy(),
+        "<failure message=\"Expected 1 Was 2. m&amp;sg&#10;again\" line=\"9\"/>"));
+#endif
+}
+
+void testStructuredOutputWritesPassingTests(void)
+{
+#ifndef UNITY_INCLUDE_STRUCTURED_OUTPUT
+    TEST_IGNORE();
+#else
+    runStructuredSuite(UNITY_OUTPUT_FORMAT_JUNIT_XML, 'P');
+    TEST_ASSERT_EQUAL_STRING(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<testsuite name=\"a.c\" tests=\"1\" failures=\"0\" ignored=\"0\">\n"
+        "  <system-out>a.c:8:t: x&lt;&quot;y&quot;</system-out>\n"
+        "  <testcase classname=\"a.c\" name=\"t\" file=\"a.c\" line=\"7\"/>\n"
+        "</testsuite>\n",
+        getBufferPutcharSpy());
+#endif
+}
+
+void testFormattedMessageAssertsPrintNothingWhenPassing(void)
+{
+#ifndef UNITY_INCLUDE_PRINT_FORMATTED
+    TEST_IGNORE();
+#else
+    startPutcharSpy();
+    TEST_ASSERT_EQUAL_HEX16_MSGF(0x0004, 0x0004, "led %d of %s", 3, "bank");
+    TEST_ASSERT_BITS_MSGF(0x00F0, 0x1234, 0xAB3C, "step %u", 7u);
+    TEST_ASSERT_TRUE_MSGF(1, "never %s", "shown");
+    endPutcharSpy();
+    TEST_ASSERT_EQUAL_STRING("", getBufferPutcharSpy());
+#endif
+}
+
+void testFormattedMessageAssertsFormatTheMessageOnFailure(void)
+{
+#ifndef UNITY_INCLUDE_PRINT_FORMATTED
+    TEST_IGNORE();
+#else
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EQUAL_HEX16_MSGF(0x0004, 0x0006, "led %d of %s", 3, "bank");
+    VERIFY_FAILS_END
+    TEST_ASSERT_NOT_NULL(strstr(getBufferPutcharSpy(), "Expected 0x0004 Was 0x0006. led 3 of bank"));
+#endif
+}
+
+void testFormattedMessageFailPrintsTheFormattedMessage(void)
+{
+#ifndef UNITY_INCLUDE_PRINT_FORMATTED
+    TEST_IGNORE();
+#else
+    EXPECT_ABORT_BEGIN
+    TEST_FAIL_MSGF("step %d of %d", 7, 9);
+    VERIFY_FAILS_END
+    TEST_ASSERT_NOT_NULL(strstr(getBufferPutcharSpy(), "FAIL: step 7 of 9"));
+#endif
+}
+
+void testFormattedMessageIsCutToItsBuffer(void)
+{
+#ifndef UNITY_INCLUDE_PRINT_FORMATTED
+    TEST_IGNORE();
+#else
+    char longText[UNITY_FORMATTED_MESSAGE_LENGTH + 16];
+    memset(longText, 'a', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    EXPECT_ABORT_BEGIN
+    TEST_FAIL_MSGF("%s", longText);
+    VERIFY_FAILS_END
+    longText[UNITY_FORMATTED_MESSAGE_LENGTH - 1] = '\0';
+    TEST_ASSERT_NOT_NULL(strstr(getBufferPutcharSpy(), longText));
+    longText[UNITY_FORMATTED_MESSAGE_LENGTH - 1] = 'a';
+    longText[UNITY_FORMATTED_MESSAGE_LENGTH] = '\0';
+    TEST_ASSERT_NULL(strstr(getBufferPutcharSpy(), longText));
+#endif
+}
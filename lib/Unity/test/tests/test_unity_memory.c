@@ -80,3 +80,84 @@ void testNotEqualMemoryLengthZero(void)
     TEST_ASSERT_EQUAL_MEMORY(NULL, NULL, 0);
     VERIFY_FAILS_END
 }
+
+void testEqualMemoryLongUnalignedRanges(void)
+{
+    unsigned char expected[1031];
+    unsigned char actual[1031];
+    int i;
+
+    for (i = 0; i < 1031; i++)
+    {
+        expected[i] = (unsigned char)(i * 7);
+        actual[(i + 2) % 1031] = (unsigned char)(i * 7);
+    }
+
+    TEST_ASSERT_EQUAL_MEMORY(expected, &actual[2], 1029);
+    TEST_ASSERT_EQUAL_MEMORY(&expected[1], &actual[3], 1028);
+}
+
+void testNotEqualMemoryLastByteOfLongRange(void)
+{
+    unsigned char expected[1031];
+    unsigned char actual[1031];
+    int i;
+
+    for (i = 0; i < 1031; i++)
+    {
+        expected[i] = actual[i] = (unsigned char)i;
+    }
+    actual[1030] = 0xFF;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EQUAL_MEMORY(&expected[1], &actual[1], 1030);
+    VERIFY_FAILS_END
+}
+
+void testNotEqualMemoryLongUnalignedRanges(void)
+{
+    unsigned char expected[1031];
+    unsigned char actual[1031];
+    int i;
+
+    for (i = 0; i < 1031; i++)
+    {
+        expected[i] = actual[i] = (unsigned char)i;
+    }
+    actual[517] = 0;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EQUAL_MEMORY(&expected[3], &actual[3], 1000);
+    VERIFY_FAILS_END
+}
+
+void testEqualMemoryArrayToValue(void)
+{
+    unsigned char block[3] = { 0x12, 0x34, 0x56 };
+    unsigned char frames[300];
+    int i;
+
+    for (i = 0; i < 300; i++)
+    {
+        frames[i] = block[i % 3];
+    }
+
+    TEST_ASSERT_EACH_EQUAL_MEMORY(block, frames, 3, 100);
+}
+
+void testNotEqualMemoryArrayToValueLastElement(void)
+{
+    unsigned char block[3] = { 0x12, 0x34, 0x56 };
+    unsigned char frames[300];
+    int i;
+
+    for (i = 0; i < 300; i++)
+    {
+        frames[i] = block[i % 3];
+    }
+    frames[298] = 0;
+
+    EXPECT_ABORT_BEGIN
+    TEST_ASSERT_EACH_EQUAL_MEMORY(block, frames, 3, 100);
+    VERIFY_FAILS_END
+}
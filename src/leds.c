@@ -3,10 +3,28 @@
 #include "leds.h"
 
 static uint16_t *leds_puerto;
+static leds_budget_t *leds_presupuesto;
 
 #define ERROR_CODE -1
 #define SUCCESS_CODE 1
 
+#ifdef LEDS_DIFFERENTIAL_CHECK
+/* The functions below are compiled under these names, and the public functions at
+ * the end of the file call them and check the result against the reference model. */
+#define leds_init leds_driver_init
+#define leds_turn_on leds_driver_turn_on
+#define leds_turn_off leds_driver_turn_off
+#define leds_state leds_driver_state
+#define leds_turn_all_on leds_driver_turn_all_on
+#define leds_turn_all_off leds_driver_turn_all_off
+void leds_driver_init(uint16_t *puerto);
+int leds_driver_turn_on(int led);
+int leds_driver_turn_off(int led);
+int leds_driver_state(int led);
+void leds_driver_turn_all_on(void);
+void leds_driver_turn_all_off(void);
+#endif
+
 /**
  * @brief Checks if the given LED index is within the valid range.
  *
@@ -35,6 +53,183 @@ int check_led_index(int led)
  */
 static int led_it_bit(int led_index) { return 1 << (led_index - 1); }
 
+/**
+ * @brief Counts the bits set in a port word.
+ *
+ * @param word The port word.
+ * @return int The number of LEDs on in the word.
+ */
+static int popcount16(uint16_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(word);
+#else
+    unsigned bits = word - ((word >> 1) & 0x5555u);
+    bits = (bits & 0x3333u) + ((bits >> 2) & 0x3333u);
+    bits = (bits + (bits >> 4)) & 0x0F0Fu;
+    return (int)((bits + (bits >> 8)) & 0x1Fu);
+#endif
+}
+
+/**
+ * @brief Computes the current drawn by some LEDs of a bank.
+ *
+ * Each weight plane holds the lines whose weight has one bit set, so the current is one
+ * popcount per bit of the weights instead of one addition per LED.
+ *
+ * @param budget The budget, which holds the weight planes.
+ * @param leds The port word of the LEDs.
+ * @return long The sum of the weights of the LEDs.
+ */
+static long budget_current(const leds_budget_t *budget, uint16_t leds)
+{
+    long current = 0;
+    int bit;
+
+    for (bit = 0; bit < LEDS_BUDGET_WEIGHT_BITS; bit++)
+    {
+        current += (long)popcount16((uint16_t)(leds & budget->weight_planes[bit])) << bit;
+    }
+    return current;
+}
+
+/**
+ * @brief Initializes a power budget with no LED on.
+ *
+ * @param budget The budget to initialize.
+ * @param mode What to do with a change that exceeds the budget: reject it or turn on only
+ * the LEDs that fit.
+ * @param max_lit The number of LEDs that can be on at once.
+ * @param max_current The current that can be drawn at once, in units of the weights.
+ * @param weights The current of the LED on each line, 16 of them, or NULL for 1 on every line.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_budget_init(leds_budget_t *budget, leds_budget_mode_t mode, int max_lit, long max_current,
+                     const uint8_t weights[16])
+{
+    int bit;
+    int line;
+
+    if (budget == NULL || (mode != LEDS_BUDGET_REJECT && mode != LEDS_BUDGET_SCALE) || max_lit < 0 ||
+        max_current < 0)
+    {
+        return ERROR_CODE;
+    }
+    budget->mode = mode;
+    budget->max_lit = max_lit;
+    budget->max_current = max_current;
+    budget->lit = 0;
+    budget->current = 0;
+    for (bit = 0; bit < LEDS_BUDGET_WEIGHT_BITS; bit++)
+    {
+        uint16_t plane = 0;
+
+        for (line = 0; line < 16; line++)
+        {
+            const unsigned weight = (weights != NULL) ? weights[line] : 1u;
+            plane = (uint16_t)(plane | (((weight >> bit) & 1u) << line));
+        }
+        budget->weight_planes[bit] = plane;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Charges the change of the port word of a bank to a budget.
+ *
+ * Only the bits that changed are counted, so the check takes the same time whatever the
+ * LEDs already on. If the change exceeds the budget, the LEDs it turns off still turn off,
+ * and those it turns on are dropped, or with LEDS_BUDGET_SCALE kept from line 1 up,
+ * skipping any that does not fit.
+ *
+ * @param budget The budget.
+ * @param before The port word of the bank, as already charged to the budget.
+ * @param after The port word requested, replaced by the word granted if the change exceeds the budget.
+ * @return int Returns ERROR_CODE if an argument is invalid or the change was not granted whole, otherwise SUCCESS_CODE.
+ */
+int leds_budget_request(leds_budget_t *budget, uint16_t before, uint16_t *after)
+{
+    uint16_t added;
+    uint16_t removed;
+    uint16_t granted;
+    int lit;
+    long current;
+    int line;
+
+    if (budget == NULL || after == NULL)
+    {
+        return ERROR_CODE;
+    }
+    added = (uint16_t)(*after & ~before);
+    removed = (uint16_t)(before & ~*after);
+    lit = budget->lit - popcount16(removed);
+    current = budget->current - budget_current(budget, removed);
+    if (lit + popcount16(added) <= budget->max_lit && current + budget_current(budget, added) <= budget->max_current)
+    {
+        budget->lit = lit + popcount16(added);
+        budget->current = current + budget_current(budget, added);
+        return SUCCESS_CODE;
+    }
+    granted = 0;
+    if (budget->mode == LEDS_BUDGET_SCALE)
+    {
+        for (line = 0; line < 16; line++)
+        {
+            const uint16_t bit = (uint16_t)(1u << line);
+            const long weight = budget_current(budget, bit);
+
+            if ((added & bit) != 0 && lit < budget->max_lit && current + weight <= budget->max_current)
+            {
+                granted = (uint16_t)(granted | bit);
+                lit++;
+                current += weight;
+            }
+        }
+    }
+    *after = (uint16_t)((before & *after) | granted);
+    budget->lit = lit;
+    budget->current = current;
+    return ERROR_CODE;
+}
+
+/**
+ * @brief Attaches a power budget to the port of the driver, or detaches it with NULL.
+ *
+ * The LEDs already on are charged to the new budget and released from the previous one.
+ * From then on, the LEDs that would exceed the budget are not turned on: leds_turn_on
+ * returns ERROR_CODE, and leds_turn_all_on turns on only those the mode of the budget grants.
+ *
+ * @param budget The budget, which may be shared with other banks, or NULL.
+ * @return int Returns ERROR_CODE if the LEDs already on exceed the budget, which is then not attached and the
+ * previous one stays in force, otherwise SUCCESS_CODE.
+ */
+int leds_set_budget(leds_budget_t *budget)
+{
+    uint16_t leds;
+
+    if (budget == leds_presupuesto)
+    {
+        return SUCCESS_CODE;
+    }
+    if (budget != NULL && leds_puerto != NULL)
+    {
+        leds = *leds_puerto;
+        if (leds_budget_request(budget, 0, &leds) != SUCCESS_CODE)
+        {
+            uint16_t released = 0;
+            leds_budget_request(budget, leds, &released);
+            return ERROR_CODE;
+        }
+    }
+    if (leds_presupuesto != NULL && leds_puerto != NULL)
+    {
+        leds = 0;
+        leds_budget_request(leds_presupuesto, *leds_puerto, &leds);
+    }
+    leds_presupuesto = budget;
+    return SUCCESS_CODE;
+}
+
 /**
  * @brief Initializes the LED module.
  *
@@ -49,6 +244,11 @@ void leds_init(uint16_t *puerto)
     {
         return;
     }
+    if (leds_presupuesto != NULL && leds_puerto != NULL)
+    {
+        uint16_t leds = 0;
+        leds_budget_request(leds_presupuesto, *leds_puerto, &leds);
+    }
     leds_puerto = puerto;
     *leds_puerto = 0;
 }
@@ -62,13 +262,20 @@ void leds_init(uint16_t *puerto)
  */
 int leds_turn_on(int led)
 {
-    if (check_led_index(led) == ERROR_CODE)
+    if (leds_puerto == NULL || check_led_index(led) == ERROR_CODE)
     {
         return ERROR_CODE;
     }
     else
     {
-
+        if (leds_presupuesto != NULL)
+        {
+            uint16_t leds = (uint16_t)(*leds_puerto | led_it_bit(led));
+            if (leds_budget_request(leds_presupuesto, *leds_puerto, &leds) == ERROR_CODE)
+            {
+                return ERROR_CODE;
+            }
+        }
         *leds_puerto |= led_it_bit(led);
         return SUCCESS_CODE;
     }
@@ -80,16 +287,24 @@ int leds_turn_on(int led)
  * This function sets the state of the specified LED to off.
  *
  * @param led The identifier of the LED to turn off.
+ * @return int Returns ERROR_CODE if the index is invalid, otherwise returns SUCCESS_CODE.
  */
 int leds_turn_off(int led)
 {
-    if (check_led_index(led) == ERROR_CODE)
+    if (leds_puerto == NULL || check_led_index(led) == ERROR_CODE)
     {
         return ERROR_CODE;
     }
     else
-
+    {
+        if (leds_presupuesto != NULL)
+        {
+            uint16_t leds = (uint16_t)(*leds_puerto & ~led_it_bit(led));
+            leds_budget_request(leds_presupuesto, *leds_puerto, &leds);
+        }
         *leds_puerto &= ~led_it_bit(led);
+        return SUCCESS_CODE;
+    }
 }
 
 /**
@@ -102,7 +317,7 @@ int leds_turn_off(int led)
 int leds_state(int led)
 
 {
-    if (check_led_index(led) == ERROR_CODE)
+    if (leds_puerto == NULL || check_led_index(led) == ERROR_CODE)
     {
         return ERROR_CODE;
     }
@@ -116,10 +331,19 @@ int leds_state(int led)
  * @brief Turns all LEDs on.
  *
  * This function sets all bits of the LED port to 1, effectively turning on all LEDs connected to the port.
+ * With a power budget attached, only the LEDs it grants are turned on.
  */
 void leds_turn_all_on(void)
 {
-    *leds_puerto = 0xFFFF;
+    if (leds_puerto != NULL)
+    {
+        uint16_t leds = 0xFFFF;
+        if (leds_presupuesto != NULL)
+        {
+            leds_budget_request(leds_presupuesto, *leds_puerto, &leds);
+        }
+        *leds_puerto = leds;
+    }
 }
 
 /**
@@ -129,5 +353,119 @@ void leds_turn_all_on(void)
  */
 void leds_turn_all_off(void)
 {
-    *leds_puerto = 0;
+    if (leds_puerto != NULL)
+    {
+        if (leds_presupuesto != NULL)
+        {
+            uint16_t leds = 0;
+            leds_budget_request(leds_presupuesto, *leds_puerto, &leds);
+        }
+        *leds_puerto = 0;
+    }
+}
+
+#ifdef LEDS_DIFFERENTIAL_CHECK
+#undef leds_init
+#undef leds_turn_on
+#undef leds_turn_off
+#undef leds_state
+#undef leds_turn_all_on
+#undef leds_turn_all_off
+
+#include "leds_reference.h"
+
+static leds_reference_t leds_referencia;
+static leds_differential_handler_t leds_differential_handler;
+static unsigned long leds_differential_count;
+
+/**
+ * @brief Sets the function called with a description of each mismatch.
+ *
+ * Without a handler, mismatches are only counted.
+ *
+ * @param handler The function to call, or NULL.
+ */
+void leds_differential_set_handler(leds_differential_handler_t handler)
+{
+    leds_differential_handler = handler;
+}
+
+/**
+ * @brief Returns the number of calls where the driver and the reference model disagreed.
+ */
+unsigned long leds_differential_mismatches(void)
+{
+    return leds_differential_count;
+}
+
+/**
+ * @brief Compares the port and the returned value of a call with those of the reference model.
+ *
+ * @param call The name of the call that was checked.
+ * @param led The LED index passed to the call, or 0 when it has none.
+ * @param returned The value returned by the driver.
+ * @param expected The value returned by the reference model.
+ * @return int The value returned by the driver.
+ */
+static int leds_differential_check(const char *call, int led, int returned, int expected)
+{
+    char message[128];
+    const uint16_t port = (leds_puerto != NULL) ? *leds_puerto : 0;
+    const uint16_t port_expected = leds_reference_port(&leds_referencia);
+
+    if (returned == expected && port == port_expected)
+    {
+        return returned;
+    }
+    leds_differential_count++;
+    if (leds_differential_handler != NULL)
+    {
+        snprintf(message, sizeof(message), "%s(%d) returned %d with the port at 0x%04X, the reference %d and 0x%04X",
+                 call, led, returned, (unsigned)port, expected, (unsigned)port_expected);
+        leds_differential_handler(message);
+    }
+    return returned;
+}
+
+void leds_init(uint16_t *puerto)
+{
+    leds_driver_init(puerto);
+    if (puerto != NULL)
+    {
+        leds_reference_init(&leds_referencia, 1);
+    }
+    leds_differential_check("leds_init", 0, 0, 0);
+}
+
+int leds_turn_on(int led)
+{
+    const int returned = leds_driver_turn_on(led);
+    return leds_differential_check("leds_turn_on", led, returned, leds_reference_turn_on(&leds_referencia, led));
+}
+
+int leds_turn_off(int led)
+{
+    const int returned = leds_driver_turn_off(led);
+    return leds_differential_check("leds_turn_off", led, returned, leds_reference_turn_off(&leds_referencia, led));
+}
+
+int leds_state(int led)
+{
+    const int returned = leds_driver_state(led);
+    return leds_differential_check("leds_state", led, returned, leds_reference_state(&leds_referencia, led));
+}
+
+void leds_turn_all_on(void)
+{
+    leds_driver_turn_all_on();
+    leds_reference_turn_all_on(&leds_referencia);
+    leds_differential_check("leds_turn_all_on", 0, 0, 0);
+}
+
+void leds_turn_all_off(void)
+{
+    leds_driver_turn_all_off();
+    leds_reference_turn_all_off(&leds_referencia);
+    leds_differential_check("leds_turn_all_off", 0, 0, 0);
 }
+#endif
@@ -16,3 +16,53 @@ int leds_state(int led);
 void leds_turn_all_on(void);
 
 void leds_turn_all_off(void);
+
+/*
+ * @brief Optional power budget, which limits how many LEDs are on at once and the current
+ * they draw. Every LED line draws a weight of current, the same on every bank, and every
+ * change of a port word is charged by counting the bits that turned on and off, so a check
+ * takes the same time whatever the number of LEDs. A change that exceeds the budget is
+ * rejected whole, or with LEDS_BUDGET_SCALE the LEDs it turns on are kept from line 1 up
+ * as long as they fit. LEDs are always allowed to turn off.
+ *
+ * A budget can be shared by a group of banks: leds_set_budget attaches it to the port of
+ * this driver, and the words of the other banks go through leds_budget_request. The
+ * reference model knows nothing of budgets, so differential builds should not set one.
+ */
+#define LEDS_BUDGET_WEIGHT_BITS 8
+
+typedef enum
+{
+    LEDS_BUDGET_REJECT,
+    LEDS_BUDGET_SCALE,
+} leds_budget_mode_t;
+
+typedef struct
+{
+    leds_budget_mode_t mode;
+    int max_lit;
+    long max_current;
+    int lit;
+    long current;
+    uint16_t weight_planes[LEDS_BUDGET_WEIGHT_BITS];
+} leds_budget_t;
+
+int leds_budget_init(leds_budget_t *budget, leds_budget_mode_t mode, int max_lit, long max_current,
+                     const uint8_t weights[16]);
+
+int leds_budget_request(leds_budget_t *budget, uint16_t before, uint16_t *after);
+
+int leds_set_budget(leds_budget_t *budget);
+
+#ifdef LEDS_DIFFERENTIAL_CHECK
+/*
+ * @brief Differential check, a debug build of the driver that repeats every call on
+ * the reference model of leds_reference.h and compares the port word and the returned
+ * value after each one. Without LEDS_DIFFERENTIAL_CHECK none of it is compiled.
+ */
+typedef void (*leds_differential_handler_t)(const char *message);
+
+void leds_differential_set_handler(leds_differential_handler_t handler);
+
+unsigned long leds_differential_mismatches(void);
+#endif
@@ -0,0 +1,239 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_charlieplex.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/* The line state table keeps the high line of each LED in the upper nibble and its low line in the lower one */
+#define HIGH_LINE(entry) ((entry) >> 4)
+#define LOW_LINE(entry) ((entry)&0x0F)
+
+/**
+ * @brief Checks that the module is initialized and the LED index is between 1 and the number of LEDs.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @param led The index of the LED to check.
+ * @return int Returns ERROR_CODE if either is invalid, otherwise SUCCESS_CODE.
+ */
+static int check_led_index(const leds_charlieplex_t *charlieplex, int led)
+{
+    if (charlieplex == NULL || charlieplex->direction == NULL || led < 1 || led > charlieplex->leds)
+    {
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Rebuilds the scan schedule from the lit LEDs.
+ *
+ * Every LED sharing a high line is lit in the same step, by driving that line high and
+ * the low lines of all of them low, so a frame has one step per high line with at least
+ * one lit LED instead of one step per LED.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ */
+static void update_schedule(leds_charlieplex_t *charlieplex)
+{
+    int line;
+    int steps = 0;
+
+    for (line = 0; line < charlieplex->lines; line++)
+    {
+        if (charlieplex->lit_low_lines[line] != 0)
+        {
+            charlieplex->step_level[steps] = (uint16_t)(1u << line);
+            charlieplex->step_direction[steps] = (uint16_t)((1u << line) | charlieplex->lit_low_lines[line]);
+            steps++;
+        }
+    }
+    charlieplex->steps = steps;
+    if (charlieplex->next >= steps)
+    {
+        charlieplex->next = 0;
+    }
+}
+
+/**
+ * @brief Initializes the charlieplexed LEDs, all off, and tri-states every line.
+ *
+ * The line state table of every LED is computed here, once.
+ *
+ * @param charlieplex The charlieplexed LEDs to initialize.
+ * @param direction A pointer to the direction register of the port.
+ * @param level A pointer to the output register of the port.
+ * @param lines The number of lines, from 2 to LEDS_CHARLIEPLEX_MAX_LINES, for lines * (lines - 1) LEDs.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_charlieplex_init(leds_charlieplex_t *charlieplex, uint16_t *direction, uint16_t *level, int lines)
+{
+    int high;
+    int low;
+    int led = 0;
+
+    if (charlieplex == NULL || direction == NULL || level == NULL || lines < 2 || lines > LEDS_CHARLIEPLEX_MAX_LINES)
+    {
+        return ERROR_CODE;
+    }
+    charlieplex->direction = direction;
+    charlieplex->level = level;
+    charlieplex->lines = lines;
+    charlieplex->leds = lines * (lines - 1);
+    for (high = 0; high < lines; high++)
+    {
+        for (low = 0; low < lines; low++)
+        {
+            if (low != high)
+            {
+                charlieplex->led_lines[led++] = (uint8_t)((high << 4) | low);
+            }
+        }
+        charlieplex->lit_low_lines[high] = 0;
+    }
+    charlieplex->next = 0;
+    update_schedule(charlieplex);
+    *direction = 0;
+    *level = 0;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Returns the lines an LED is connected to.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @param led The index of the LED.
+ * @param high Where the line driven high to light it is stored, from 1.
+ * @param low Where the line driven low to light it is stored, from 1.
+ * @return int Returns ERROR_CODE if the index is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_charlieplex_lines(const leds_charlieplex_t *charlieplex, int led, int *high, int *low)
+{
+    if (check_led_index(charlieplex, led) == ERROR_CODE || high == NULL || low == NULL)
+    {
+        return ERROR_CODE;
+    }
+    *high = HIGH_LINE(charlieplex->led_lines[led - 1]) + 1;
+    *low = LOW_LINE(charlieplex->led_lines[led - 1]) + 1;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Turns on a specific LED, from the next scan of its high line.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @param led The index of the LED to turn on.
+ * @return int Returns ERROR_CODE if the index is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_charlieplex_turn_on(leds_charlieplex_t *charlieplex, int led)
+{
+    uint8_t entry;
+
+    if (check_led_index(charlieplex, led) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    entry = charlieplex->led_lines[led - 1];
+    charlieplex->lit_low_lines[HIGH_LINE(entry)] |= (uint16_t)(1u << LOW_LINE(entry));
+    update_schedule(charlieplex);
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Turns off a specific LED.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @param led The index of the LED to turn off.
+ * @return int Returns ERROR_CODE if the index is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_charlieplex_turn_off(leds_charlieplex_t *charlieplex, int led)
+{
+    uint8_t entry;
+
+    if (check_led_index(charlieplex, led) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    entry = charlieplex->led_lines[led - 1];
+    charlieplex->lit_low_lines[HIGH_LINE(entry)] &= (uint16_t)~(1u << LOW_LINE(entry));
+    update_schedule(charlieplex);
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Returns the state of a specified LED.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @param led The index of the LED.
+ * @return int 1 if the LED is on, 0 if it is off, or ERROR_CODE if the index is invalid.
+ */
+int leds_charlieplex_state(const leds_charlieplex_t *charlieplex, int led)
+{
+    uint8_t entry;
+
+    if (check_led_index(charlieplex, led) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    entry = charlieplex->led_lines[led - 1];
+    return (charlieplex->lit_low_lines[HIGH_LINE(entry)] >> LOW_LINE(entry)) & 1;
+}
+
+/**
+ * @brief Turns off all LEDs.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ */
+void leds_charlieplex_turn_all_off(leds_charlieplex_t *charlieplex)
+{
+    int line;
+
+    if (charlieplex == NULL || charlieplex->direction == NULL)
+    {
+        return;
+    }
+    for (line = 0; line < charlieplex->lines; line++)
+    {
+        charlieplex->lit_low_lines[line] = 0;
+    }
+    update_schedule(charlieplex);
+}
+
+/**
+ * @brief Returns the number of scan steps of a whole frame, one per high line with lit LEDs.
+ *
+ * @param charlieplex The charlieplexed LEDs.
+ * @return int The number of steps, or ERROR_CODE if the module is not initialized.
+ */
+int leds_charlieplex_steps(const leds_charlieplex_t *charlieplex)
+{
+    if (charlieplex == NULL || charlieplex->direction == NULL)
+    {
+        return ERROR_CODE;
+    }
+    return charlieplex->steps;
+}
+
+/**
+ * @brief Shows the next step of the frame. Meant to be called from the scan timer.
+ *
+ * Every line is tri-stated before the levels change, so no LED of the previous step lights
+ * while the lines switch. With no LED lit, the lines are left tri-stated.
+ *
+ * @param charlieplex The initialized charlieplexed LEDs.
+ */
+void leds_charlieplex_scan(leds_charlieplex_t *charlieplex)
+{
+    volatile uint16_t *const direction = charlieplex->direction;
+    volatile uint16_t *const level = charlieplex->level;
+    const int step = charlieplex->next;
+
+    *direction = 0;
+    if (charlieplex->steps == 0)
+    {
+        return;
+    }
+    *level = charlieplex->step_level[step];
+    *direction = charlieplex->step_direction[step];
+    charlieplex->next = (step + 1 == charlieplex->steps) ? 0 : step + 1;
+}
@@ -0,0 +1,46 @@
+#include <stdint.h>
+
+/*
+ * @brief Charlieplexed LEDs, with one LED between every ordered pair of n port lines.
+ *
+ * The port is modelled as two words: the direction, where a 1 makes the line an output
+ * and a 0 leaves it tri-stated, and the level driven by the outputs. An LED lights when
+ * its high line outputs 1 and its low line outputs 0.
+ *
+ * LEDs are counted from 1, grouped by high line and then by low line: with 4 lines, LEDs
+ * 1 to 3 go from line 1 to lines 2, 3 and 4, LEDs 4 to 6 from line 2 to lines 1, 3 and 4,
+ * and so on. Lines are counted from 1 as well.
+ */
+
+#define LEDS_CHARLIEPLEX_MAX_LINES 16
+#define LEDS_CHARLIEPLEX_MAX_LEDS (LEDS_CHARLIEPLEX_MAX_LINES * (LEDS_CHARLIEPLEX_MAX_LINES - 1))
+
+typedef struct
+{
+    uint16_t *direction;
+    uint16_t *level;
+    int lines;
+    int leds;
+    uint8_t led_lines[LEDS_CHARLIEPLEX_MAX_LEDS];
+    uint16_t lit_low_lines[LEDS_CHARLIEPLEX_MAX_LINES];
+    uint16_t step_direction[LEDS_CHARLIEPLEX_MAX_LINES];
+    uint16_t step_level[LEDS_CHARLIEPLEX_MAX_LINES];
+    int steps;
+    int next;
+} leds_charlieplex_t;
+
+int leds_charlieplex_init(leds_charlieplex_t *charlieplex, uint16_t *direction, uint16_t *level, int lines);
+
+int leds_charlieplex_lines(const leds_charlieplex_t *charlieplex, int led, int *high, int *low);
+
+int leds_charlieplex_turn_on(leds_charlieplex_t *charlieplex, int led);
+
+int leds_charlieplex_turn_off(leds_charlieplex_t *charlieplex, int led);
+
+int leds_charlieplex_state(const leds_charlieplex_t *charlieplex, int led);
+
+void leds_charlieplex_turn_all_off(leds_charlieplex_t *charlieplex);
+
+int leds_charlieplex_steps(const leds_charlieplex_t *charlieplex);
+
+void leds_charlieplex_scan(leds_charlieplex_t *charlieplex);
@@ -0,0 +1,247 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "leds_display.h"
+
+#define ERROR_CODE -1
+
+#define FONT_FIRST ' '
+#define FONT_LAST '~'
+
+/**
+ * @brief Segment words of the printable ASCII characters, from ' ' to '~'.
+ *
+ * Lowercase letters use the same glyphs as the uppercase ones.
+ */
+static const uint16_t leds_display_font[FONT_LAST - FONT_FIRST + 1] = {
+    0x0000, /* ' ' */
+    0x000C, /* '!' */
+    0x0880, /* '"' */
+    0x4B3C, /* '#' */
+    0x4BBB, /* '$' */
+    0xDBA9, /* '%' */
+    0x2D71, /* '&' */
+    0x1000, /* '\'' */
+    0x3000, /* '(' */
+    0x8400, /* ')' */
+    0xFF00, /* '*' */
+    0x4B00, /* '+' */
+    0x8000, /* ',' */
+    0x0300, /* '-' */
+    0x0010, /* '.' */
+    0x9000, /* '/' */
+    0x90FF, /* '0' */
+    0x100C, /* '1' */
+    0x0377, /* '2' */
+    0x023F, /* '3' */
+    0x038C, /* '4' */
+    0x03BB, /* '5' */
+    0x03FB, /* '6' */
+    0x000F, /* '7' */
+    0x03FF, /* '8' */
+    0x03BF, /* '9' */
+    0x4800, /* ':' */
+    0x8800, /* ';' */
+    0x3000, /* '<' */
+    0x0330, /* '=' */
+    0x8400, /* '>' */
+    0x4207, /* '?' */
+    0x0AF7, /* '@' */
+    0x03CF, /* 'A' */
+    0x4A3F, /* 'B' */
+    0x00F3, /* 'C' */
+    0x483F, /* 'D' */
+    0x01F3, /* 'E' */
+    0x01C3, /* 'F' */
+    0x02FB, /* 'G' */
+    0x03CC, /* 'H' */
+    0x4833, /* 'I' */
+    0x007C, /* 'J' */
+    0x31C0, /* 'K' */
+    0x00F0, /* 'L' */
+    0x14CC, /* 'M' */
+    0x24CC, /* 'N' */
+    0x00FF, /* 'O' */
+    0x03C7, /* 'P' */
+    0x20FF, /* 'Q' */
+    0x23C7, /* 'R' */
+    0x03BB, /* 'S' */
+    0x4803, /* 'T' */
+    0x00FC, /* 'U' */
+    0x90C0, /* 'V' */
+    0xA0CC, /* 'W' */
+    0xB400, /* 'X' */
+    0x5400, /* 'Y' */
+    0x9033, /* 'Z' */
+    0x4822, /* '[' */
+    0x2400, /* '\\' */
+    0x4811, /* ']' */
+    0xA000, /* '^' */
+    0x0030, /* '_' */
+    0x0400, /* '`' */
+    0x03CF, /* 'a' */
+    0x4A3F, /* 'b' */
+    0x00F3, /* 'c' */
+    0x483F, /* 'd' */
+    0x01F3, /* 'e' */
+    0x01C3, /* 'f' */
+    0x02FB, /* 'g' */
+    0x03CC, /* 'h' */
+    0x4833, /* 'i' */
+    0x007C, /* 'j' */
+    0x31C0, /* 'k' */
+    0x00F0, /* 'l' */
+    0x14CC, /* 'm' */
+    0x24CC, /* 'n' */
+    0x00FF, /* 'o' */
+    0x03C7, /* 'p' */
+    0x20FF, /* 'q' */
+    0x23C7, /* 'r' */
+    0x03BB, /* 's' */
+    0x4803, /* 't' */
+    0x00FC, /* 'u' */
+    0x90C0, /* 'v' */
+    0xA0CC, /* 'w' */
+    0xB400, /* 'x' */
+    0x5400, /* 'y' */
+    0x9033, /* 'z' */
+    0x4922, /* '{' */
+    0x4800, /* '|' */
+    0x4A11, /* '}' */
+    0x9300, /* '~' */
+};
+
+/**
+ * @brief Returns the segment word of a character.
+ *
+ * @param character The character to show.
+ * @return uint16_t The segments that draw it, or no segment for characters outside the font.
+ */
+uint16_t leds_display_glyph(char character)
+{
+    if (character < FONT_FIRST || character > FONT_LAST)
+    {
+        return 0;
+    }
+    return leds_display_font[character - FONT_FIRST];
+}
+
+/**
+ * @brief Writes a text across several banks, one character per bank and one store per port.
+ *
+ * Banks past the end of the text are blanked, and characters past the last bank are not shown.
+ *
+ * @param ports The ports of the banks, from left to right.
+ * @param banks The number of banks.
+ * @param text The text to show.
+ * @return int The number of characters shown, or ERROR_CODE if an argument is invalid.
+ */
+int leds_display_write(uint16_t *const ports[], int banks, const char *text)
+{
+    int bank;
+    int shown = 0;
+
+    if (ports == NULL || banks < 1 || text == NULL)
+    {
+        return ERROR_CODE;
+    }
+    for (bank = 0; bank < banks; bank++)
+    {
+        if (text[shown] != '\0')
+        {
+            *ports[bank] = leds_display_glyph(text[shown]);
+            shown++;
+        }
+        else
+        {
+            *ports[bank] = 0;
+        }
+    }
+    return shown;
+}
+
+/**
+ * @brief Precomputes the frames of a text scrolling across the banks.
+ *
+ * The buffer is filled with one blank word per bank, the glyphs of the text and one blank
+ * word per bank again. The first frame is blank, the text then enters from the right one
+ * digit per frame and the last frame is blank again, for length + banks + 1 frames.
+ *
+ * @param marquee The marquee to prepare.
+ * @param text The text to scroll.
+ * @param banks The number of banks it scrolls across.
+ * @param buffer Where the frames are kept, which must outlive the marquee.
+ * @param capacity The number of words of the buffer, at least LEDS_DISPLAY_MARQUEE_WORDS.
+ * @return int The number of frames, or ERROR_CODE if an argument is invalid or the buffer too small.
+ */
+int leds_display_marquee_prepare(leds_display_marquee_t *marquee, const char *text, int banks, uint16_t *buffer,
+                                 int capacity)
+{
+    size_t length;
+    size_t index;
+
+    if (marquee == NULL || text == NULL || banks < 1 || buffer == NULL || capacity < 0)
+    {
+        return ERROR_CODE;
+    }
+    length = strlen(text);
+    if (length > (size_t)capacity || (size_t)capacity - length < 2 * (size_t)banks)
+    {
+        return ERROR_CODE;
+    }
+    memset(buffer, 0, LEDS_DISPLAY_MARQUEE_WORDS(length, (size_t)banks) * sizeof(uint16_t));
+    for (index = 0; index < length; index++)
+    {
+        buffer[(size_t)banks + index] = leds_display_glyph(text[index]);
+    }
+    marquee->strip = buffer;
+    marquee->banks = banks;
+    marquee->frames = (int)length + banks + 1;
+    marquee->next = 0;
+    return marquee->frames;
+}
+
+/**
+ * @brief Returns the segment words of one frame of a marquee, one per bank from left to right.
+ *
+ * @param marquee The prepared marquee.
+ * @param frame The index of the frame.
+ * @return const uint16_t* The words of the frame, or NULL if the frame does not exist.
+ */
+const uint16_t *leds_display_marquee_frame(const leds_display_marquee_t *marquee, int frame)
+{
+    if (marquee == NULL || marquee->strip == NULL || frame < 0 || frame >= marquee->frames)
+    {
+        return NULL;
+    }
+    return marquee->strip + frame;
+}
+
+/**
+ * @brief Shows the next frame of a marquee, starting over after the last one.
+ *
+ * Meant to be called from the refresh timer: it only copies one word to each port.
+ *
+ * @param marquee The prepared marquee.
+ * @param ports The ports of the banks, from left to right.
+ * @return int The index of the frame shown, or ERROR_CODE if an argument is invalid.
+ */
+int leds_display_marquee_show(leds_display_marquee_t *marquee, uint16_t *const ports[])
+{
+    const uint16_t *words;
+    int shown;
+    int bank;
+
+    if (marquee == NULL || marquee->strip == NULL || ports == NULL)
+    {
+        return ERROR_CODE;
+    }
+    shown = marquee->next;
+    words = marquee->strip + shown;
+    for (bank = 0; bank < marquee->banks; bank++)
+    {
+        *ports[bank] = words[bank];
+    }
+    marquee->next = (shown + 1 == marquee->frames) ? 0 : shown + 1;
+    return shown;
+}
@@ -0,0 +1,67 @@
+#include <stdint.h>
+
+/*
+ * @brief Alphanumeric display layer, where each 16-bit port drives one 16-segment digit.
+ *
+ * LED n of a bank is segment bit n-1, in the order of the LEDS_DISPLAY_SEGMENT_* constants:
+ *
+ *      -A1-  -A2-
+ *     |\    |    /|
+ *     F H   I   J B
+ *     |  \  |  /  |
+ *      -G1-  -G2-
+ *     |  /  |  \  |
+ *     E M   L   K C
+ *     |/    |    \|
+ *      -D1-  -D2-
+ *
+ * Characters are turned into segment words through a constant font table, so a whole
+ * digit is written with a single store instead of one leds_turn_on call per segment.
+ */
+
+#define LEDS_DISPLAY_SEGMENT_A1 0x0001
+#define LEDS_DISPLAY_SEGMENT_A2 0x0002
+#define LEDS_DISPLAY_SEGMENT_B 0x0004
+#define LEDS_DISPLAY_SEGMENT_C 0x0008
+#define LEDS_DISPLAY_SEGMENT_D1 0x0010
+#define LEDS_DISPLAY_SEGMENT_D2 0x0020
+#define LEDS_DISPLAY_SEGMENT_E 0x0040
+#define LEDS_DISPLAY_SEGMENT_F 0x0080
+#define LEDS_DISPLAY_SEGMENT_G1 0x0100
+#define LEDS_DISPLAY_SEGMENT_G2 0x0200
+#define LEDS_DISPLAY_SEGMENT_H 0x0400
+#define LEDS_DISPLAY_SEGMENT_I 0x0800
+#define LEDS_DISPLAY_SEGMENT_J 0x1000
+#define LEDS_DISPLAY_SEGMENT_K 0x2000
+#define LEDS_DISPLAY_SEGMENT_L 0x4000
+#define LEDS_DISPLAY_SEGMENT_M 0x8000
+
+/*
+ * @brief Number of segment words needed by a marquee of a text of the given length on
+ * the given number of banks: the text with one blank digit per bank on each side.
+ */
+#define LEDS_DISPLAY_MARQUEE_WORDS(length, banks) ((length) + 2 * (banks))
+
+/*
+ * @brief A text scrolling from right to left across the banks. Every frame is a window
+ * of `banks` consecutive words of the strip, so the frames are computed once when the
+ * marquee is prepared, and showing one only copies words to the ports.
+ */
+typedef struct
+{
+    const uint16_t *strip;
+    int banks;
+    int frames;
+    int next;
+} leds_display_marquee_t;
+
+uint16_t leds_display_glyph(char character);
+
+int leds_display_write(uint16_t *const ports[], int banks, const char *text);
+
+int leds_display_marquee_prepare(leds_display_marquee_t *marquee, const char *text, int banks, uint16_t *buffer,
+                                 int capacity);
+
+const uint16_t *leds_display_marquee_frame(const leds_display_marquee_t *marquee, int frame);
+
+int leds_display_marquee_show(leds_display_marquee_t *marquee, uint16_t *const ports[]);
@@ -0,0 +1,87 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_dither.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Initializes the dithering of a number of banks.
+ *
+ * The accumulators of the 16 LEDs of a bank start at 16 different fractions of a frame,
+ * so LEDs with the same intensity do not all turn on in the same frame.
+ *
+ * @param dither The dithering to initialize.
+ * @param bits The resolution of the intensities, 12 or 16.
+ * @param banks The number of banks, at least 1.
+ * @param errors The accumulators, 16 words per bank, which must outlive the dithering.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_dither_init(leds_dither_t *dither, int bits, int banks, uint16_t *errors)
+{
+    int bank;
+    int led;
+
+    if (dither == NULL || errors == NULL || (bits != 12 && bits != 16) || banks < 1)
+    {
+        return ERROR_CODE;
+    }
+    dither->bits = bits;
+    dither->banks = banks;
+    dither->errors = errors;
+    for (bank = 0; bank < banks; bank++)
+    {
+        for (led = 0; led < LEDS_DITHER_LEDS_PER_BANK; led++)
+        {
+            errors[bank * LEDS_DITHER_LEDS_PER_BANK + led] = (uint16_t)(((led * 7) % 16) << (bits - 4));
+        }
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Computes the on/off port word of every bank for the next frame.
+ *
+ * The intensities are stretched so the highest one equals a full frame, and the sum with
+ * the accumulator carries the bit of the LED, so there is no branch per LED.
+ *
+ * @param dither The dithering.
+ * @param intensities The intensity of each LED, 16 per bank, bank 1 first, from 0 to 2^bits - 1.
+ * @param words Where the port word of each bank is stored.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_dither_frame(leds_dither_t *dither, const uint16_t *intensities, uint16_t *words)
+{
+    uint16_t *error;
+    const uint16_t *intensity;
+    uint32_t mask;
+    int shift;
+    int bank;
+    int led;
+
+    if (dither == NULL || dither->errors == NULL || intensities == NULL || words == NULL)
+    {
+        return ERROR_CODE;
+    }
+    shift = dither->bits;
+    mask = (1u << shift) - 1u;
+    error = dither->errors;
+    intensity = intensities;
+    for (bank = 0; bank < dither->banks; bank++)
+    {
+        uint32_t word = 0;
+
+        for (led = 0; led < LEDS_DITHER_LEDS_PER_BANK; led++)
+        {
+            const uint32_t level = (uint32_t)intensity[led] & mask;
+            const uint32_t sum = error[led] + level + (level >> (shift - 1));
+
+            word |= (sum >> shift) << led;
+            error[led] = (uint16_t)(sum & mask);
+        }
+        words[bank] = (uint16_t)word;
+        error += LEDS_DITHER_LEDS_PER_BANK;
+        intensity += LEDS_DITHER_LEDS_PER_BANK;
+    }
+    return SUCCESS_CODE;
+}
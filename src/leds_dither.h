@@ -0,0 +1,29 @@
+#include <stdint.h>
+
+/*
+ * @brief Temporal dithering, which shows 12-bit or 16-bit intensities with LEDs that are
+ * only on or off.
+ *
+ * Every frame, the intensity of each LED is added to its error accumulator, and the LED is
+ * on in that frame when the sum reaches a full frame, which is then taken off. Over 2^bits
+ * frames an LED is on as many frames as its intensity, one more for the upper half of the
+ * intensities so the highest one is on in every frame, and the on frames are spread as
+ * evenly as possible instead of grouped in one pulse, so low levels do not flicker at the
+ * refresh rate.
+ *
+ * The accumulators are one word per LED, in an array allocated by the caller, and each
+ * frame yields one port word per bank, with LED n of the bank on line n like in leds.h.
+ */
+
+#define LEDS_DITHER_LEDS_PER_BANK 16
+
+typedef struct
+{
+    int bits;
+    int banks;
+    uint16_t *errors;
+} leds_dither_t;
+
+int leds_dither_init(leds_dither_t *dither, int bits, int banks, uint16_t *errors);
+
+int leds_dither_frame(leds_dither_t *dither, const uint16_t *intensities, uint16_t *words);
@@ -0,0 +1,270 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_fade.h"
+#include "leds_lanes.h"
+
+#if defined(__SSE2__) && !defined(LEDS_FADE_NO_SIMD)
+#include <emmintrin.h>
+#define LEDS_FADE_SSE2
+#endif
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Initializes a fade in Q8.8, with every LED off and still.
+ *
+ * @param fade The fade to initialize.
+ * @param count The number of LEDs.
+ * @param levels The current level of each LED, count words that must outlive the fade.
+ * @param steps The step of each LED, count words that must outlive the fade.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_fade_init_q8_8(leds_fade_t *fade, int count, uint16_t *levels, uint16_t *steps)
+{
+    int led;
+
+    if (fade == NULL || count < 1 || levels == NULL || steps == NULL)
+    {
+        return ERROR_CODE;
+    }
+    fade->format = LEDS_FADE_Q8_8;
+    fade->count = count;
+    fade->remaining = 0;
+    fade->target = NULL;
+    fade->levels8 = levels;
+    fade->steps8 = steps;
+    fade->levels16 = NULL;
+    fade->steps16 = NULL;
+    for (led = 0; led < count; led++)
+    {
+        levels[led] = 0;
+        steps[led] = 0;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Initializes a fade in Q16.16, with every LED off and still.
+ *
+ * @param fade The fade to initialize.
+ * @param count The number of LEDs.
+ * @param levels The current level of each LED, count words that must outlive the fade.
+ * @param steps The step of each LED, count words that must outlive the fade.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_fade_init_q16_16(leds_fade_t *fade, int count, uint32_t *levels, uint32_t *steps)
+{
+    int led;
+
+    if (fade == NULL || count < 1 || levels == NULL || steps == NULL)
+    {
+        return ERROR_CODE;
+    }
+    fade->format = LEDS_FADE_Q16_16;
+    fade->count = count;
+    fade->remaining = 0;
+    fade->target = NULL;
+    fade->levels8 = NULL;
+    fade->steps8 = NULL;
+    fade->levels16 = levels;
+    fade->steps16 = steps;
+    for (led = 0; led < count; led++)
+    {
+        levels[led] = 0;
+        steps[led] = 0;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Starts a fade from one frame to another.
+ *
+ * The steps are rounded towards zero, so no LED overshoots its target, and are stored
+ * modulo 2^16 or 2^32: a negative step wraps around like the levels it is added to.
+ *
+ * @param fade The fade.
+ * @param from The brightness of each LED at the start, which may be the last frame shown.
+ * @param to The brightness of each LED at the end, which must not change until the fade ends.
+ * @param ticks The number of ticks the fade takes, at least 1.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_fade_start(leds_fade_t *fade, const uint8_t *from, const uint8_t *to, int ticks)
+{
+    int led;
+
+    if (fade == NULL || from == NULL || to == NULL || ticks < 1 || (fade->levels8 == NULL && fade->levels16 == NULL))
+    {
+        return ERROR_CODE;
+    }
+    for (led = 0; led < fade->count; led++)
+    {
+        const long difference = (long)to[led] - (long)from[led];
+
+        if (fade->format == LEDS_FADE_Q8_8)
+        {
+            fade->levels8[led] = (uint16_t)(from[led] << 8);
+            fade->steps8[led] = (uint16_t)(difference * 256 / ticks);
+        }
+        else
+        {
+            fade->levels16[led] = (uint32_t)from[led] << 16;
+            fade->steps16[led] = (uint32_t)(difference * 65536 / ticks);
+        }
+    }
+    fade->target = to;
+    fade->remaining = ticks;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Moves every Q8.8 level one step and stores its integer part.
+ */
+static void tick_q8_8(uint16_t *levels, const uint16_t *steps, uint8_t *brightness, int count)
+{
+    int led = 0;
+
+#ifdef LEDS_FADE_SSE2
+    for (; led + 16 <= count; led += 16)
+    {
+        __m128i *const level = (__m128i *)(void *)(levels + led);
+        const __m128i *const step = (const __m128i *)(const void *)(steps + led);
+        const __m128i first = _mm_add_epi16(_mm_loadu_si128(level), _mm_loadu_si128(step));
+        const __m128i second = _mm_add_epi16(_mm_loadu_si128(level + 1), _mm_loadu_si128(step + 1));
+
+        _mm_storeu_si128(level, first);
+        _mm_storeu_si128(level + 1, second);
+        _mm_storeu_si128((__m128i *)(void *)(brightness + led),
+                         _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8)));
+    }
+#endif
+    for (; led < count; led++)
+    {
+        levels[led] = (uint16_t)(levels[led] + steps[led]);
+        brightness[led] = (uint8_t)(levels[led] >> 8);
+    }
+}
+
+/**
+ * @brief Moves every Q16.16 level one step and stores its integer part.
+ */
+static void tick_q16_16(uint32_t *levels, const uint32_t *steps, uint8_t *brightness, int count)
+{
+    int led = 0;
+
+#ifdef LEDS_FADE_SSE2
+    for (; led + 16 <= count; led += 16)
+    {
+        __m128i *const level = (__m128i *)(void *)(levels + led);
+        const __m128i *const step = (const __m128i *)(const void *)(steps + led);
+        __m128i sums[4];
+        int quarter;
+
+        for (quarter = 0; quarter < 4; quarter++)
+        {
+            sums[quarter] = _mm_add_epi32(_mm_loadu_si128(level + quarter), _mm_loadu_si128(step + quarter));
+            _mm_storeu_si128(level + quarter, sums[quarter]);
+            sums[quarter] = _mm_srli_epi32(sums[quarter], 16);
+        }
+        _mm_storeu_si128((__m128i *)(void *)(brightness + led),
+                         _mm_packus_epi16(_mm_packs_epi32(sums[0], sums[1]), _mm_packs_epi32(sums[2], sums[3])));
+    }
+#endif
+    for (; led < count; led++)
+    {
+        levels[led] += steps[led];
+        brightness[led] = (uint8_t)(levels[led] >> 16);
+    }
+}
+
+/**
+ * @brief Advances the fade one tick and stores the brightness of every LED.
+ *
+ * On the last tick the levels are set to the target frame, which is then shown until the
+ * next fade starts.
+ *
+ * @param fade The fade.
+ * @param brightness Where the brightness of each LED is stored.
+ * @return int The number of ticks left, or ERROR_CODE if an argument is invalid.
+ */
+int leds_fade_tick(leds_fade_t *fade, uint8_t *brightness)
+{
+    int led;
+
+    if (fade == NULL || brightness == NULL || (fade->levels8 == NULL && fade->levels16 == NULL))
+    {
+        return ERROR_CODE;
+    }
+    if (fade->remaining > 1 || fade->target == NULL)
+    {
+        if (fade->format == LEDS_FADE_Q8_8)
+        {
+            tick_q8_8(fade->levels8, fade->steps8, brightness, fade->count);
+        }
+        else
+        {
+            tick_q16_16(fade->levels16, fade->steps16, brightness, fade->count);
+        }
+        if (fade->remaining > 0)
+        {
+            fade->remaining--;
+        }
+        return fade->remaining;
+    }
+    for (led = 0; led < fade->count; led++)
+    {
+        brightness[led] = fade->target[led];
+        if (fade->format == LEDS_FADE_Q8_8)
+        {
+            fade->levels8[led] = (uint16_t)(fade->target[led] << 8);
+            fade->steps8[led] = 0;
+        }
+        else
+        {
+            fade->levels16[led] = (uint32_t)fade->target[led] << 16;
+            fade->steps16[led] = 0;
+        }
+    }
+    fade->target = NULL;
+    fade->remaining = 0;
+    return 0;
+}
+
+/**
+ * @brief Turns the brightness of whole banks into the port words of their bit planes.
+ *
+ * The 16 levels of a bank are transposed with the kernel of leds_lanes.c, which yields
+ * bit n of every level in one word.
+ *
+ * @param brightness The brightness of each LED, 16 per bank, bank 1 first.
+ * @param banks The number of banks.
+ * @param planes Where the words are stored, LEDS_FADE_PLANES * banks of them: the word of
+ * every bank for plane 0, then for plane 1, and so on.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_fade_planes(const uint8_t *brightness, int banks, uint16_t *planes)
+{
+    uint16_t lanes[LEDS_LANES];
+    uint16_t clocks[16];
+    int bank;
+    int lane;
+    int plane;
+
+    if (brightness == NULL || planes == NULL || banks < 1)
+    {
+        return ERROR_CODE;
+    }
+    for (bank = 0; bank < banks; bank++)
+    {
+        for (lane = 0; lane < LEDS_LANES; lane++)
+        {
+            lanes[lane] = brightness[bank * LEDS_LANES + lane];
+        }
+        leds_lanes_transpose(lanes, clocks);
+        for (plane = 0; plane < LEDS_FADE_PLANES; plane++)
+        {
+            planes[plane * banks + bank] = clocks[15 - plane];
+        }
+    }
+    return SUCCESS_CODE;
+}
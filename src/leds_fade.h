@@ -0,0 +1,47 @@
+#include <stdint.h>
+
+/*
+ * @brief Fades and crossfades of the brightness of many LEDs, in fixed point.
+ *
+ * A fade goes from one frame of 8-bit brightness levels to another in a number of ticks.
+ * Every LED keeps its current level and the step it moves on each tick, in contiguous
+ * arrays allocated by the caller, so a tick is one addition per LED, done 8 or 16 LEDs at
+ * a time with SSE2 when available. Define LEDS_FADE_NO_SIMD to use the portable loop.
+ *
+ * Q8.8 levels take half the memory and twice the LEDs per instruction, but can only move
+ * by multiples of 1/256 of a level per tick, so fades longer than 256 ticks should use
+ * Q16.16. Whatever the format, the last tick lands exactly on the target frame.
+ *
+ * The levels are shown with bit angle modulation: leds_fade_planes turns them into one
+ * port word per bank for each of the 8 bit planes, and plane n is shown for 2^n time units.
+ */
+
+#define LEDS_FADE_PLANES 8
+
+typedef enum
+{
+    LEDS_FADE_Q8_8,
+    LEDS_FADE_Q16_16,
+} leds_fade_format_t;
+
+typedef struct
+{
+    leds_fade_format_t format;
+    int count;
+    int remaining;
+    const uint8_t *target;
+    uint16_t *levels8;
+    uint16_t *steps8;
+    uint32_t *levels16;
+    uint32_t *steps16;
+} leds_fade_t;
+
+int leds_fade_init_q8_8(leds_fade_t *fade, int count, uint16_t *levels, uint16_t *steps);
+
+int leds_fade_init_q16_16(leds_fade_t *fade, int count, uint32_t *levels, uint32_t *steps);
+
+int leds_fade_start(leds_fade_t *fade, const uint8_t *from, const uint8_t *to, int ticks);
+
+int leds_fade_tick(leds_fade_t *fade, uint8_t *brightness);
+
+int leds_fade_planes(const uint8_t *brightness, int banks, uint16_t *planes);
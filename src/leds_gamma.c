@@ -0,0 +1,171 @@
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_gamma.h"
+
+#define CURVES 2
+
+static uint8_t leds_gamma_tables8[CURVES][LEDS_GAMMA_LEVELS];
+static uint16_t leds_gamma_tables12[CURVES][LEDS_GAMMA_LEVELS];
+static int leds_gamma_ready[CURVES];
+
+/**
+ * @brief Returns the relative luminance, from 0 to 1, that looks as bright as a level.
+ *
+ * @param curve The correction curve.
+ * @param level The brightness level, from 0 to 1.
+ * @return double The relative luminance, that is the duty cycle.
+ */
+static double luminance(leds_gamma_curve_t curve, double level)
+{
+    double lightness;
+
+    if (curve == LEDS_GAMMA_CURVE_POWER)
+    {
+        return pow(level, LEDS_GAMMA);
+    }
+    lightness = level * 100.0;
+    if (lightness <= 8.0)
+    {
+        return lightness / 903.3;
+    }
+    return pow((lightness + 16.0) / 116.0, 3.0);
+}
+
+/**
+ * @brief Computes the 8-bit and 12-bit tables of a curve, rounding to the nearest duty cycle.
+ *
+ * @param curve The correction curve.
+ */
+static void build_tables(leds_gamma_curve_t curve)
+{
+    int level;
+
+    for (level = 0; level < LEDS_GAMMA_LEVELS; level++)
+    {
+        const double duty = luminance(curve, level / (double)(LEDS_GAMMA_LEVELS - 1));
+        leds_gamma_tables8[curve][level] = (uint8_t)(duty * 255.0 + 0.5);
+        leds_gamma_tables12[curve][level] = (uint16_t)(duty * 4095.0 + 0.5);
+    }
+    leds_gamma_ready[curve] = 1;
+}
+
+/**
+ * @brief Returns the table from brightness level to 8-bit duty cycle of a curve.
+ *
+ * The table is computed on the first call for each curve, which should happen at startup
+ * rather than in the refresh loop or in an interrupt.
+ *
+ * @param curve The correction curve.
+ * @return const uint8_t* The LEDS_GAMMA_LEVELS duty cycles, or NULL for an unknown curve.
+ */
+const uint8_t *leds_gamma_table8(leds_gamma_curve_t curve)
+{
+    if (curve != LEDS_GAMMA_CURVE_POWER && curve != LEDS_GAMMA_CURVE_CIE1931)
+    {
+        return NULL;
+    }
+    if (!leds_gamma_ready[curve])
+    {
+        build_tables(curve);
+    }
+    return leds_gamma_tables8[curve];
+}
+
+/**
+ * @brief Returns the table from brightness level to 12-bit duty cycle of a curve.
+ *
+ * @param curve The correction curve.
+ * @return const uint16_t* The LEDS_GAMMA_LEVELS duty cycles, from 0 to 4095, or NULL for an unknown curve.
+ */
+const uint16_t *leds_gamma_table12(leds_gamma_curve_t curve)
+{
+    if (curve != LEDS_GAMMA_CURVE_POWER && curve != LEDS_GAMMA_CURVE_CIE1931)
+    {
+        return NULL;
+    }
+    if (!leds_gamma_ready[curve])
+    {
+        build_tables(curve);
+    }
+    return leds_gamma_tables12[curve];
+}
+
+/*
+ * Table lookups do not map to SSE2 or NEON, which have no gather, so the loops below look
+ * up eight levels per iteration instead: the loads are independent and overlap.
+ */
+
+/**
+ * @brief Corrects the brightness levels of whole banks into 8-bit duty cycles.
+ *
+ * @param table A table returned by leds_gamma_table8.
+ * @param levels The brightness levels.
+ * @param duties Where the duty cycles are stored, which may be the same array as the levels.
+ * @param count The number of levels.
+ */
+void leds_gamma_apply8(const uint8_t *table, const uint8_t *levels, uint8_t *duties, size_t count)
+{
+    size_t index = 0;
+
+    for (; index + 8 <= count; index += 8)
+    {
+        const uint8_t d0 = table[levels[index]];
+        const uint8_t d1 = table[levels[index + 1]];
+        const uint8_t d2 = table[levels[index + 2]];
+        const uint8_t d3 = table[levels[index + 3]];
+        const uint8_t d4 = table[levels[index + 4]];
+        const uint8_t d5 = table[levels[index + 5]];
+        const uint8_t d6 = table[levels[index + 6]];
+        const uint8_t d7 = table[levels[index + 7]];
+        duties[index] = d0;
+        duties[index + 1] = d1;
+        duties[index + 2] = d2;
+        duties[index + 3] = d3;
+        duties[index + 4] = d4;
+        duties[index + 5] = d5;
+        duties[index + 6] = d6;
+        duties[index + 7] = d7;
+    }
+    for (; index < count; index++)
+    {
+        duties[index] = table[levels[index]];
+    }
+}
+
+/**
+ * @brief Corrects the brightness levels of whole banks into 12-bit duty cycles.
+ *
+ * @param table A table returned by leds_gamma_table12.
+ * @param levels The brightness levels.
+ * @param duties Where the duty cycles are stored.
+ * @param count The number of levels.
+ */
+void leds_gamma_apply12(const uint16_t *table, const uint8_t *levels, uint16_t *duties, size_t count)
+{
+    size_t index = 0;
+
+    for (; index + 8 <= count; index += 8)
+    {
+        const uint16_t d0 = table[levels[index]];
+        const uint16_t d1 = table[levels[index + 1]];
+        const uint16_t d2 = table[levels[index + 2]];
+        const uint16_t d3 = table[levels[index + 3]];
+        const uint16_t d4 = table[levels[index + 4]];
+        const uint16_t d5 = table[levels[index + 5]];
+        const uint16_t d6 = table[levels[index + 6]];
+        const uint16_t d7 = table[levels[index + 7]];
+        duties[index] = d0;
+        duties[index + 1] = d1;
+        duties[index + 2] = d2;
+        duties[index + 3] = d3;
+        duties[index + 4] = d4;
+        duties[index + 5] = d5;
+        duties[index + 6] = d6;
+        duties[index + 7] = d7;
+    }
+    for (; index < count; index++)
+    {
+        duties[index] = table[levels[index]];
+    }
+}
@@ -0,0 +1,34 @@
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * @brief Brightness correction tables for dimmable LEDs.
+ *
+ * The eye does not see duty cycle linearly, so an 8-bit brightness level is mapped to the
+ * duty cycle that looks that bright, either with a gamma curve or with the CIE 1931
+ * lightness formula, for an 8-bit or a 12-bit PWM. Each table is computed once, the first
+ * time it is asked for, and then only looked up.
+ */
+
+/*
+ * @brief Exponent of the gamma curve. Values around 2.8 suit most LEDs.
+ */
+#ifndef LEDS_GAMMA
+#define LEDS_GAMMA 2.8
+#endif
+
+#define LEDS_GAMMA_LEVELS 256
+
+typedef enum
+{
+    LEDS_GAMMA_CURVE_POWER,
+    LEDS_GAMMA_CURVE_CIE1931,
+} leds_gamma_curve_t;
+
+const uint8_t *leds_gamma_table8(leds_gamma_curve_t curve);
+
+const uint16_t *leds_gamma_table12(leds_gamma_curve_t curve);
+
+void leds_gamma_apply8(const uint8_t *table, const uint8_t *levels, uint8_t *duties, size_t count);
+
+void leds_gamma_apply12(const uint16_t *table, const uint8_t *levels, uint16_t *duties, size_t count);
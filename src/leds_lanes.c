@@ -0,0 +1,143 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_lanes.h"
+
+#if defined(__SSE2__) && !defined(LEDS_LANES_NO_SIMD)
+#include <emmintrin.h>
+#define LEDS_LANES_SSE2
+#endif
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+#ifdef LEDS_LANES_SSE2
+/**
+ * @brief Transposes the bits of one word of every chain into the port words of 16 clocks.
+ *
+ * The high and the low bytes of the 16 words are packed into two vectors with the byte of
+ * chain n in byte n-1. The sign bits of the 16 bytes then form the port word of one clock,
+ * and adding each vector to itself moves the next bit of every byte into its sign bit.
+ *
+ * @param lanes One word of each chain, chain 1 first.
+ * @param clocks Where the port words are stored, in shifting order.
+ */
+void leds_lanes_transpose(const uint16_t lanes[LEDS_LANES], uint16_t clocks[16])
+{
+    const __m128i first = _mm_loadu_si128((const __m128i *)(const void *)lanes);
+    const __m128i second = _mm_loadu_si128((const __m128i *)(const void *)(lanes + 8));
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    __m128i high = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+    __m128i low = _mm_packus_epi16(_mm_and_si128(first, low_bytes), _mm_and_si128(second, low_bytes));
+    int clock;
+
+    for (clock = 0; clock < 8; clock++)
+    {
+        clocks[clock] = (uint16_t)_mm_movemask_epi8(high);
+        clocks[clock + 8] = (uint16_t)_mm_movemask_epi8(low);
+        high = _mm_add_epi8(high, high);
+        low = _mm_add_epi8(low, low);
+    }
+}
+#else
+/**
+ * @brief Transposes the bits of one word of every chain into the port words of 16 clocks.
+ *
+ * The 16x16 bit matrix is transposed in place by swapping its off-diagonal blocks of 8x8,
+ * then those of 4x4, 2x2 and 1x1 bits, two rows at a time with masks and shifts. The result
+ * holds bit n of every chain in word n, so it is stored backwards to shift the most
+ * significant bit first.
+ *
+ * @param lanes One word of each chain, chain 1 first.
+ * @param clocks Where the port words are stored, in shifting order.
+ */
+void leds_lanes_transpose(const uint16_t lanes[LEDS_LANES], uint16_t clocks[16])
+{
+    static const uint16_t masks[4] = {0x00FF, 0x0F0F, 0x3333, 0x5555};
+    uint16_t rows[16];
+    int width = 8;
+    int stage;
+    int row;
+
+    for (row = 0; row < 16; row++)
+    {
+        rows[row] = lanes[row];
+    }
+    for (stage = 0; stage < 4; stage++, width >>= 1)
+    {
+        for (row = 0; row < 16; row = (row + width + 1) & ~width)
+        {
+            const uint16_t swap = (uint16_t)(((rows[row] >> width) ^ rows[row + width]) & masks[stage]);
+            rows[row] = (uint16_t)(rows[row] ^ (swap << width));
+            rows[row + width] = (uint16_t)(rows[row + width] ^ swap);
+        }
+    }
+    for (row = 0; row < 16; row++)
+    {
+        clocks[row] = rows[15 - row];
+    }
+}
+#endif
+
+/**
+ * @brief Converts the buffers of the 16 chains into the port words that shift them out.
+ *
+ * @param chains The buffer of each chain, chain 1 first, each one of the same number of words.
+ * @param words The number of words of every chain.
+ * @param stream Where the port words are stored, one per clock.
+ * @param capacity The number of words of the stream, at least LEDS_LANES_STREAM_WORDS(words).
+ * @return int The number of port words, or ERROR_CODE if an argument is invalid.
+ */
+int leds_lanes_encode(const uint16_t *const chains[LEDS_LANES], int words, uint16_t *stream, int capacity)
+{
+    uint16_t lanes[LEDS_LANES];
+    int word;
+    int lane;
+
+    if (chains == NULL || stream == NULL || words < 1 || capacity < LEDS_LANES_STREAM_WORDS(words))
+    {
+        return ERROR_CODE;
+    }
+    for (lane = 0; lane < LEDS_LANES; lane++)
+    {
+        if (chains[lane] == NULL)
+        {
+            return ERROR_CODE;
+        }
+    }
+    for (word = 0; word < words; word++)
+    {
+        for (lane = 0; lane < LEDS_LANES; lane++)
+        {
+            lanes[lane] = chains[lane][word];
+        }
+        leds_lanes_transpose(lanes, stream + LEDS_LANES_STREAM_WORDS(word));
+    }
+    return LEDS_LANES_STREAM_WORDS(words);
+}
+
+/**
+ * @brief Writes the port words of a stream, one per clock.
+ *
+ * The clock itself is not on this port: each word is meant to be taken by the clock
+ * edge that follows its store, from a timer or another port.
+ *
+ * @param port A pointer to the port where the data line of every chain is connected.
+ * @param stream The port words, as returned by leds_lanes_encode.
+ * @param length The number of port words.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_lanes_send(uint16_t *port, const uint16_t *stream, int length)
+{
+    volatile uint16_t *const data = port;
+    int word;
+
+    if (port == NULL || stream == NULL || length < 0)
+    {
+        return ERROR_CODE;
+    }
+    for (word = 0; word < length; word++)
+    {
+        *data = stream[word];
+    }
+    return SUCCESS_CODE;
+}
@@ -0,0 +1,26 @@
+#include <stdint.h>
+
+/*
+ * @brief Sixteen shift register chains fed in parallel, one per line of the port.
+ *
+ * Each chain has its own buffer of 16-bit words, shifted out from the first word, most
+ * significant bit first. On every clock, line n of the port carries the next bit of
+ * chain n, counted from 1 like the LEDs of leds.h, so one port word per clock shifts 16
+ * bits at once. The buffers are turned into those port words sixteen clocks at a time,
+ * by transposing the 16x16 bit matrix of one word of every chain.
+ *
+ * Define LEDS_LANES_NO_SIMD to use the portable transpose on targets with SSE2.
+ */
+
+#define LEDS_LANES 16
+
+/*
+ * @brief Number of port words that shift the given number of words of every chain.
+ */
+#define LEDS_LANES_STREAM_WORDS(words) ((words) * 16)
+
+void leds_lanes_transpose(const uint16_t lanes[LEDS_LANES], uint16_t clocks[16]);
+
+int leds_lanes_encode(const uint16_t *const chains[LEDS_LANES], int words, uint16_t *stream, int capacity);
+
+int leds_lanes_send(uint16_t *port, const uint16_t *stream, int length);
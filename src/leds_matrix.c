@@ -0,0 +1,207 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_matrix.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Checks that a pixel lies inside the matrix.
+ *
+ * @param matrix The matrix.
+ * @param row The row of the pixel, from 1.
+ * @param column The column of the pixel, from 1.
+ * @return int Returns ERROR_CODE if the matrix or the pixel is invalid, otherwise SUCCESS_CODE.
+ */
+static int check_pixel(const leds_matrix_t *matrix, int row, int column)
+{
+    if (matrix == NULL || matrix->port == NULL || row < 1 || row > matrix->rows || column < 1 ||
+        column > matrix->columns)
+    {
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Recomputes the port word that shows one row: its row line and the lines of its lit columns.
+ *
+ * Lines wired active low are inverted here, once per change, instead of on every scan tick.
+ *
+ * @param matrix The matrix.
+ * @param index The index of the row, from 0.
+ */
+static void update_row_word(leds_matrix_t *matrix, int index)
+{
+    const unsigned lines = (1u << index) | ((unsigned)matrix->pixels[index] << matrix->rows);
+    matrix->row_words[index] = (uint16_t)(matrix->idle ^ lines);
+}
+
+/**
+ * @brief Initializes a matrix and blanks its port.
+ *
+ * Every pixel starts off and every row at full brightness.
+ *
+ * @param matrix The matrix to initialize.
+ * @param port A pointer to the port where the row and column lines are connected.
+ * @param rows The number of rows, from 1 to LEDS_MATRIX_MAX_ROWS.
+ * @param columns The number of columns, from 1 to LEDS_MATRIX_MAX_COLUMNS.
+ * @param active_low The port lines that are active when low, such as the rows of a common cathode matrix.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_matrix_init(leds_matrix_t *matrix, uint16_t *port, int rows, int columns, uint16_t active_low)
+{
+    int index;
+
+    if (matrix == NULL || port == NULL || rows < 1 || rows > LEDS_MATRIX_MAX_ROWS || columns < 1 ||
+        columns > LEDS_MATRIX_MAX_COLUMNS)
+    {
+        return ERROR_CODE;
+    }
+    matrix->port = port;
+    matrix->rows = rows;
+    matrix->columns = columns;
+    matrix->idle = (uint16_t)(active_low & ((1u << (rows + columns)) - 1u));
+    for (index = 0; index < LEDS_MATRIX_MAX_ROWS; index++)
+    {
+        matrix->pixels[index] = 0;
+        matrix->brightness[index] = LEDS_MATRIX_BRIGHTNESS_LEVELS;
+        update_row_word(matrix, index);
+    }
+    matrix->row = 0;
+    matrix->pass = 0;
+    *port = matrix->idle;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Turns a pixel of the framebuffer on or off.
+ *
+ * The change is shown the next time its row is scanned.
+ *
+ * @param matrix The matrix.
+ * @param row The row of the pixel, from 1.
+ * @param column The column of the pixel, from 1.
+ * @param on Nonzero to turn the pixel on.
+ * @return int Returns ERROR_CODE if the pixel is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_matrix_set_pixel(leds_matrix_t *matrix, int row, int column, int on)
+{
+    uint8_t bit;
+
+    if (check_pixel(matrix, row, column) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    bit = (uint8_t)(1u << (column - 1));
+    if (on)
+    {
+        matrix->pixels[row - 1] |= bit;
+    }
+    else
+    {
+        matrix->pixels[row - 1] &= (uint8_t)~bit;
+    }
+    update_row_word(matrix, row - 1);
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Returns the state of a pixel of the framebuffer.
+ *
+ * @param matrix The matrix.
+ * @param row The row of the pixel, from 1.
+ * @param column The column of the pixel, from 1.
+ * @return int 1 if the pixel is on, 0 if it is off, or ERROR_CODE if it is invalid.
+ */
+int leds_matrix_pixel(const leds_matrix_t *matrix, int row, int column)
+{
+    if (check_pixel(matrix, row, column) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    return (matrix->pixels[row - 1] >> (column - 1)) & 1;
+}
+
+/**
+ * @brief Replaces a whole row of the framebuffer.
+ *
+ * @param matrix The matrix.
+ * @param row The row, from 1.
+ * @param pixels One bit per column, column 1 in the least significant bit. Bits past the last column are ignored.
+ * @return int Returns ERROR_CODE if the row is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_matrix_set_row(leds_matrix_t *matrix, int row, uint8_t pixels)
+{
+    if (check_pixel(matrix, row, 1) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    matrix->pixels[row - 1] = (uint8_t)(pixels & ((1u << matrix->columns) - 1u));
+    update_row_word(matrix, row - 1);
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Turns every pixel of the framebuffer off.
+ *
+ * @param matrix The matrix.
+ */
+void leds_matrix_clear(leds_matrix_t *matrix)
+{
+    int index;
+
+    if (matrix == NULL || matrix->port == NULL)
+    {
+        return;
+    }
+    for (index = 0; index < matrix->rows; index++)
+    {
+        matrix->pixels[index] = 0;
+        update_row_word(matrix, index);
+    }
+}
+
+/**
+ * @brief Sets the brightness of a row.
+ *
+ * @param matrix The matrix.
+ * @param row The row, from 1.
+ * @param level From 0, never shown, to LEDS_MATRIX_BRIGHTNESS_LEVELS, shown on every scan.
+ * @return int Returns ERROR_CODE if the row or the level is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_matrix_set_brightness(leds_matrix_t *matrix, int row, int level)
+{
+    if (check_pixel(matrix, row, 1) == ERROR_CODE || level < 0 || level > LEDS_MATRIX_BRIGHTNESS_LEVELS)
+    {
+        return ERROR_CODE;
+    }
+    matrix->brightness[row - 1] = (uint8_t)level;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Shows the next row of the matrix. Meant to be called from the scan timer.
+ *
+ * The port is blanked before the word of the new row is stored, so the columns of the
+ * previous row never light the new one while the lines switch. The cost is the same for
+ * every tick, whatever the size or the contents of the matrix.
+ *
+ * @param matrix The initialized matrix.
+ */
+void leds_matrix_scan(leds_matrix_t *matrix)
+{
+    volatile uint16_t *const port = matrix->port;
+    const int row = matrix->row;
+
+    *port = matrix->idle;
+    *port = (matrix->pass < matrix->brightness[row]) ? matrix->row_words[row] : matrix->idle;
+    if (++matrix->row == matrix->rows)
+    {
+        matrix->row = 0;
+        if (++matrix->pass == LEDS_MATRIX_BRIGHTNESS_LEVELS)
+        {
+            matrix->pass = 0;
+        }
+    }
+}
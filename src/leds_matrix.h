@@ -0,0 +1,46 @@
+#include <stdint.h>
+
+/*
+ * @brief Multiplexed LED matrix scanned one row at a time over a single 16-bit port.
+ *
+ * Row r drives port line r and column c drives port line rows + c, both counted from 1
+ * like the LEDs of leds.h, so an 8x8 matrix uses the whole port. The port word of each
+ * row is kept up to date whenever the framebuffer changes, so every scan tick only
+ * blanks the port and stores the word of the next row.
+ */
+
+#define LEDS_MATRIX_MAX_ROWS 8
+#define LEDS_MATRIX_MAX_COLUMNS 8
+
+/*
+ * @brief Brightness of a fully lit row. A row of brightness b is shown on b out of
+ * every LEDS_MATRIX_BRIGHTNESS_LEVELS scans of the whole matrix.
+ */
+#define LEDS_MATRIX_BRIGHTNESS_LEVELS 16
+
+typedef struct
+{
+    uint16_t *port;
+    int rows;
+    int columns;
+    uint16_t idle;
+    uint8_t pixels[LEDS_MATRIX_MAX_ROWS];
+    uint8_t brightness[LEDS_MATRIX_MAX_ROWS];
+    uint16_t row_words[LEDS_MATRIX_MAX_ROWS];
+    int row;
+    int pass;
+} leds_matrix_t;
+
+int leds_matrix_init(leds_matrix_t *matrix, uint16_t *port, int rows, int columns, uint16_t active_low);
+
+int leds_matrix_set_pixel(leds_matrix_t *matrix, int row, int column, int on);
+
+int leds_matrix_pixel(const leds_matrix_t *matrix, int row, int column);
+
+int leds_matrix_set_row(leds_matrix_t *matrix, int row, uint8_t pixels);
+
+void leds_matrix_clear(leds_matrix_t *matrix);
+
+int leds_matrix_set_brightness(leds_matrix_t *matrix, int row, int level);
+
+void leds_matrix_scan(leds_matrix_t *matrix);
@@ -0,0 +1,125 @@
+#include "leds_reference.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Checks whether an LED can be used: the port is attached and the index is between 1 and 16.
+ *
+ * @param reference The model.
+ * @param led The index of the LED.
+ * @return int 1 when the LED can be used, 0 otherwise.
+ */
+static int reference_usable(const leds_reference_t *reference, int led)
+{
+    return reference->attached && led >= 1 && led <= 16;
+}
+
+/**
+ * @brief Sets every LED of the model to the same state.
+ *
+ * @param reference The model.
+ * @param on 1 to turn every LED on, 0 to turn every LED off.
+ */
+static void reference_set_all(leds_reference_t *reference, int on)
+{
+    int led;
+    for (led = 1; led <= 16; led++)
+    {
+        reference->on[led - 1] = on;
+    }
+}
+
+/**
+ * @brief Initializes the model with every LED off, like leds_init.
+ *
+ * @param reference The model.
+ * @param attached 0 to model a driver that has no port yet, 1 otherwise.
+ */
+void leds_reference_init(leds_reference_t *reference, int attached)
+{
+    reference->attached = attached;
+    reference_set_all(reference, 0);
+}
+
+/**
+ * @brief Turns on one LED of the model, like leds_turn_on.
+ *
+ * @return int ERROR_CODE if the LED cannot be used, otherwise SUCCESS_CODE.
+ */
+int leds_reference_turn_on(leds_reference_t *reference, int led)
+{
+    if (!reference_usable(reference, led))
+    {
+        return ERROR_CODE;
+    }
+    reference->on[led - 1] = 1;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Turns off one LED of the model, like leds_turn_off.
+ *
+ * @return int ERROR_CODE if the LED cannot be used, otherwise SUCCESS_CODE.
+ */
+int leds_reference_turn_off(leds_reference_t *reference, int led)
+{
+    if (!reference_usable(reference, led))
+    {
+        return ERROR_CODE;
+    }
+    reference->on[led - 1] = 0;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Returns the state of one LED of the model, like leds_state.
+ *
+ * @return int ERROR_CODE if the LED cannot be used, otherwise 1 when it is on and 0 when it is off.
+ */
+int leds_reference_state(const leds_reference_t *reference, int led)
+{
+    if (!reference_usable(reference, led))
+    {
+        return ERROR_CODE;
+    }
+    return reference->on[led - 1];
+}
+
+/**
+ * @brief Turns on every LED of the model, like leds_turn_all_on.
+ */
+void leds_reference_turn_all_on(leds_reference_t *reference)
+{
+    if (reference->attached)
+    {
+        reference_set_all(reference, 1);
+    }
+}
+
+/**
+ * @brief Turns off every LED of the model, like leds_turn_all_off.
+ */
+void leds_reference_turn_all_off(leds_reference_t *reference)
+{
+    if (reference->attached)
+    {
+        reference_set_all(reference, 0);
+    }
+}
+
+/**
+ * @brief Builds the word the driver must have written to its port, with LED 1 in bit 0.
+ *
+ * @return uint16_t The expected port value.
+ */
+uint16_t leds_reference_port(const leds_reference_t *reference)
+{
+    uint16_t port = 0;
+    int led;
+    for (led = 16; led >= 1; led--)
+    {
+        port = (uint16_t)(port * 2 + (reference->on[led - 1] ? 1 : 0));
+    }
+    return port;
+}
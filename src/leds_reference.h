@@ -0,0 +1,27 @@
+#include <stdint.h>
+
+/*
+ * @brief Reference model of the LED module, written for clarity instead of speed.
+ * It keeps one flag per LED and builds the port word from them, so that optimized
+ * versions of the driver can be compared against it.
+ */
+
+typedef struct
+{
+    int attached;
+    int on[16];
+} leds_reference_t;
+
+void leds_reference_init(leds_reference_t *reference, int attached);
+
+int leds_reference_turn_on(leds_reference_t *reference, int led);
+
+int leds_reference_turn_off(leds_reference_t *reference, int led);
+
+int leds_reference_state(const leds_reference_t *reference, int led);
+
+void leds_reference_turn_all_on(leds_reference_t *reference);
+
+void leds_reference_turn_all_off(leds_reference_t *reference);
+
+uint16_t leds_reference_port(const leds_reference_t *reference);
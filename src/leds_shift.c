@@ -0,0 +1,137 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_shift.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Checks that a line mask selects exactly one line of the port.
+ *
+ * @param line The mask of the line.
+ * @return int Returns SUCCESS_CODE if exactly one bit is set, otherwise ERROR_CODE.
+ */
+static int check_line(uint16_t line)
+{
+    if (line == 0 || (line & (line - 1)) != 0)
+    {
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Initializes a shift register chain and leaves its lines low.
+ *
+ * @param chain The chain to initialize.
+ * @param port A pointer to the port where the clock, data and latch lines are connected.
+ * @param clock The mask of the clock line, on which the registers shift on the rising edge.
+ * @param data The mask of the serial data line.
+ * @param latch The mask of the latch line, on which the outputs are updated on the rising edge.
+ * @param banks The number of banks of 16 outputs, at least 1.
+ * @param stream The buffer for the port words of a frame, which must outlive the chain.
+ * @param capacity The number of words of the buffer, at least LEDS_SHIFT_STREAM_WORDS(banks).
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_shift_init(leds_shift_t *chain, uint16_t *port, uint16_t clock, uint16_t data, uint16_t latch, int banks,
+                    uint16_t *stream, int capacity)
+{
+    if (chain == NULL || port == NULL || stream == NULL || banks < 1 || capacity < LEDS_SHIFT_STREAM_WORDS(banks))
+    {
+        return ERROR_CODE;
+    }
+    if (check_line(clock) == ERROR_CODE || check_line(data) == ERROR_CODE || check_line(latch) == ERROR_CODE ||
+        clock == data || clock == latch || data == latch)
+    {
+        return ERROR_CODE;
+    }
+    chain->port = port;
+    chain->clock = clock;
+    chain->data = data;
+    chain->latch = latch;
+    chain->banks = banks;
+    chain->stream = stream;
+    *port = 0;
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Converts a frame into the port words that shift it into the chain and latch it.
+ *
+ * The last bank is shifted first, most significant bit first, so that each word ends in
+ * its own bank. Each frame word is converted as a whole: its bits are taken from the top
+ * by shifting, and the data line is selected with a mask instead of a branch.
+ *
+ * @param chain The chain.
+ * @param frame One word per bank, bank 1 first.
+ * @return int The number of port words of the stream, or ERROR_CODE if an argument is invalid.
+ */
+int leds_shift_encode(leds_shift_t *chain, const uint16_t frame[])
+{
+    uint16_t *out;
+    int bank;
+
+    if (chain == NULL || chain->port == NULL || frame == NULL)
+    {
+        return ERROR_CODE;
+    }
+    out = chain->stream;
+    for (bank = chain->banks - 1; bank >= 0; bank--)
+    {
+        uint32_t word = frame[bank];
+        int bit;
+
+        for (bit = 0; bit < 16; bit++)
+        {
+            const uint16_t data = (uint16_t)(chain->data & (0u - ((word >> 15) & 1u)));
+            out[0] = data;
+            out[1] = (uint16_t)(data | chain->clock);
+            out += 2;
+            word <<= 1;
+        }
+    }
+    out[0] = chain->latch;
+    out[1] = 0;
+    return LEDS_SHIFT_STREAM_WORDS(chain->banks);
+}
+
+/**
+ * @brief Writes the stream of the last encoded frame to the port, ending with its latch pulse.
+ *
+ * @param chain The chain.
+ * @return int Returns ERROR_CODE if the chain is not initialized, otherwise SUCCESS_CODE.
+ */
+int leds_shift_send(const leds_shift_t *chain)
+{
+    volatile uint16_t *port;
+    const uint16_t *word;
+    const uint16_t *end;
+
+    if (chain == NULL || chain->port == NULL)
+    {
+        return ERROR_CODE;
+    }
+    port = chain->port;
+    end = chain->stream + LEDS_SHIFT_STREAM_WORDS(chain->banks);
+    for (word = chain->stream; word != end; word++)
+    {
+        *port = *word;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Encodes a frame and writes it to the chain.
+ *
+ * @param chain The chain.
+ * @param frame One word per bank, bank 1 first.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_shift_write(leds_shift_t *chain, const uint16_t frame[])
+{
+    if (leds_shift_encode(chain, frame) == ERROR_CODE)
+    {
+        return ERROR_CODE;
+    }
+    return leds_shift_send(chain);
+}
@@ -0,0 +1,37 @@
+#include <stdint.h>
+
+/*
+ * @brief Output backend for a chain of serial-in, parallel-out shift registers of the
+ * 74HC595 kind, driven from three lines of the port: clock, data and latch.
+ *
+ * A frame has one 16-bit word per bank of 16 outputs, bank 1 being the closest to the
+ * port. Output n of a bank is bit n-1 of its word, like the LEDs of leds.h. The frame is
+ * converted into the sequence of port words that shifts it into the chain, in a buffer
+ * allocated by the caller, and written to the port with a single latch pulse at the end,
+ * so the outputs change all at once. The other lines of the port are held low.
+ */
+
+/*
+ * @brief Number of port words in the stream of a frame: two per bit, a clock low and a
+ * clock high word, followed by the latch pulse.
+ */
+#define LEDS_SHIFT_STREAM_WORDS(banks) ((banks) * 32 + 2)
+
+typedef struct
+{
+    uint16_t *port;
+    uint16_t clock;
+    uint16_t data;
+    uint16_t latch;
+    int banks;
+    uint16_t *stream;
+} leds_shift_t;
+
+int leds_shift_init(leds_shift_t *chain, uint16_t *port, uint16_t clock, uint16_t data, uint16_t latch, int banks,
+                    uint16_t *stream, int capacity);
+
+int leds_shift_encode(leds_shift_t *chain, const uint16_t frame[]);
+
+int leds_shift_send(const leds_shift_t *chain);
+
+int leds_shift_write(leds_shift_t *chain, const uint16_t frame[]);
@@ -0,0 +1,133 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "leds_ws2812.h"
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/*
+ * The symbols of the 8 bits of a byte, most significant bit first, packed at the top of a
+ * 32-bit word with one bit per port word. The tables are built by the preprocessor.
+ */
+#define SYMBOL3(byte, bit) ((((byte) >> (bit)) & 1) ? 0x6u : 0x4u)
+#define SYMBOL4(byte, bit) ((((byte) >> (bit)) & 1) ? 0xEu : 0x8u)
+
+#define SYMBOLS3(b)                                                                                                    \
+    ((SYMBOL3(b, 7) << 29) | (SYMBOL3(b, 6) << 26) | (SYMBOL3(b, 5) << 23) | (SYMBOL3(b, 4) << 20) |                   \
+     (SYMBOL3(b, 3) << 17) | (SYMBOL3(b, 2) << 14) | (SYMBOL3(b, 1) << 11) | (SYMBOL3(b, 0) << 8))
+#define SYMBOLS4(b)                                                                                                    \
+    ((SYMBOL4(b, 7) << 28) | (SYMBOL4(b, 6) << 24) | (SYMBOL4(b, 5) << 20) | (SYMBOL4(b, 4) << 16) |                   \
+     (SYMBOL4(b, 3) << 12) | (SYMBOL4(b, 2) << 8) | (SYMBOL4(b, 1) << 4) | SYMBOL4(b, 0))
+
+#define ROW3(n) SYMBOLS3(n), SYMBOLS3(n + 1), SYMBOLS3(n + 2), SYMBOLS3(n + 3)
+#define ROWS3(n) ROW3(n), ROW3(n + 4), ROW3(n + 8), ROW3(n + 12)
+#define BLOCK3(n) ROWS3(n), ROWS3(n + 16), ROWS3(n + 32), ROWS3(n + 48)
+#define ROW4(n) SYMBOLS4(n), SYMBOLS4(n + 1), SYMBOLS4(n + 2), SYMBOLS4(n + 3)
+#define ROWS4(n) ROW4(n), ROW4(n + 4), ROW4(n + 8), ROW4(n + 12)
+#define BLOCK4(n) ROWS4(n), ROWS4(n + 16), ROWS4(n + 32), ROWS4(n + 48)
+
+static const uint32_t leds_ws2812_symbols3[256] = {BLOCK3(0), BLOCK3(64), BLOCK3(128), BLOCK3(192)};
+static const uint32_t leds_ws2812_symbols4[256] = {BLOCK4(0), BLOCK4(64), BLOCK4(128), BLOCK4(192)};
+
+/**
+ * @brief Initializes the encoder of a strip and fills its buffer with low words.
+ *
+ * @param strip The strip to initialize.
+ * @param data The mask of the port line connected to the data input of the strip.
+ * @param symbol_words The number of port words per data bit, 3 or 4.
+ * @param pixels The number of LEDs of the strip, at least 1.
+ * @param reset_words The number of low words that latch the colours at the end of the buffer.
+ * @param buffer The buffer of port words, which must outlive the strip.
+ * @param capacity The number of words of the buffer, at least LEDS_WS2812_BUFFER_WORDS.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_ws2812_init(leds_ws2812_t *strip, uint16_t data, int symbol_words, int pixels, int reset_words,
+                     uint16_t *buffer, int capacity)
+{
+    int word;
+
+    if (strip == NULL || buffer == NULL || data == 0 || (symbol_words != 3 && symbol_words != 4) || pixels < 1 ||
+        reset_words < 0 || capacity < LEDS_WS2812_BUFFER_WORDS(pixels, symbol_words, reset_words))
+    {
+        return ERROR_CODE;
+    }
+    strip->data = data;
+    strip->symbol_words = symbol_words;
+    strip->pixels = pixels;
+    strip->reset_words = reset_words;
+    strip->buffer = buffer;
+    for (word = 0; word < LEDS_WS2812_BUFFER_WORDS(pixels, symbol_words, reset_words); word++)
+    {
+        buffer[word] = 0;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Encodes a range of pixels into their place of the buffer, leaving the others untouched.
+ *
+ * Only the pixels that changed need to be encoded again. Each byte takes one lookup in the
+ * symbol table, and its symbols are expanded into port words with a mask instead of a branch.
+ *
+ * @param strip The strip.
+ * @param grb The colours of the whole strip, 3 bytes per pixel in green, red, blue order.
+ * @param first The index of the first pixel to encode, from 0.
+ * @param count The number of pixels to encode.
+ * @return int Returns ERROR_CODE if an argument is invalid or the range is outside the strip, otherwise SUCCESS_CODE.
+ */
+int leds_ws2812_encode(leds_ws2812_t *strip, const uint8_t *grb, int first, int count)
+{
+    const uint32_t *symbols;
+    const uint8_t *byte;
+    const uint8_t *end;
+    uint16_t *out;
+    int width;
+
+    if (strip == NULL || strip->buffer == NULL || grb == NULL || first < 0 || count < 0 ||
+        count > strip->pixels - first)
+    {
+        return ERROR_CODE;
+    }
+    symbols = (strip->symbol_words == 3) ? leds_ws2812_symbols3 : leds_ws2812_symbols4;
+    width = 8 * strip->symbol_words;
+    out = strip->buffer + first * LEDS_WS2812_BITS_PER_PIXEL * strip->symbol_words;
+    end = grb + 3 * (first + count);
+    for (byte = grb + 3 * first; byte != end; byte++)
+    {
+        uint32_t pattern = symbols[*byte];
+        int word;
+
+        for (word = 0; word < width; word++)
+        {
+            out[word] = (uint16_t)(strip->data & (0u - (pattern >> 31)));
+            pattern <<= 1;
+        }
+        out += width;
+    }
+    return SUCCESS_CODE;
+}
+
+/**
+ * @brief Writes the whole buffer to the port, as the DMA would.
+ *
+ * @param strip The strip.
+ * @param port A pointer to the port where the strip is connected.
+ * @return int Returns ERROR_CODE if an argument is invalid, otherwise SUCCESS_CODE.
+ */
+int leds_ws2812_send(const leds_ws2812_t *strip, uint16_t *port)
+{
+    volatile uint16_t *const data = port;
+    const uint16_t *word;
+    const uint16_t *end;
+
+    if (strip == NULL || strip->buffer == NULL || port == NULL)
+    {
+        return ERROR_CODE;
+    }
+    end = strip->buffer + LEDS_WS2812_BUFFER_WORDS(strip->pixels, strip->symbol_words, strip->reset_words);
+    for (word = strip->buffer; word != end; word++)
+    {
+        *data = *word;
+    }
+    return SUCCESS_CODE;
+}
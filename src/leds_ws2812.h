@@ -0,0 +1,36 @@
+#include <stdint.h>
+
+/*
+ * @brief Encoder for strips of addressable RGB LEDs of the WS2812 kind, driven from one
+ * line of the port by writing a buffer of port words at a fixed rate, as a DMA would.
+ *
+ * Every data bit becomes a symbol of 3 or 4 port words: the line is high on the first
+ * word, high on the following ones only for a 1, and low on the last one. At 3 words per
+ * bit the words go out every 0.4 us, and at 4 words per bit every 0.3 us. The pixels are
+ * given as 3 bytes each, in the green, red, blue order the LEDs expect, and the buffer
+ * ends with low words that latch the colours.
+ */
+
+#define LEDS_WS2812_BITS_PER_PIXEL 24
+
+/*
+ * @brief Number of port words of the buffer for a strip of the given length.
+ */
+#define LEDS_WS2812_BUFFER_WORDS(pixels, symbol_words, reset_words)                                                   \
+    ((pixels)*LEDS_WS2812_BITS_PER_PIXEL * (symbol_words) + (reset_words))
+
+typedef struct
+{
+    uint16_t data;
+    int symbol_words;
+    int pixels;
+    int reset_words;
+    uint16_t *buffer;
+} leds_ws2812_t;
+
+int leds_ws2812_init(leds_ws2812_t *strip, uint16_t data, int symbol_words, int pixels, int reset_words,
+                     uint16_t *buffer, int capacity);
+
+int leds_ws2812_encode(leds_ws2812_t *strip, const uint8_t *grb, int first, int count);
+
+int leds_ws2812_send(const leds_ws2812_t *strip, uint16_t *port);
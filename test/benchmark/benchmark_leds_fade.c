@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include "leds_fade.h"
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_registry.h"
+
+/**
+ * @file benchmark_leds_fade.c
+ * @brief Benchmark of the LEDs per second of the fade engine.
+ *
+ * A tick of 16384 LEDs is timed in both formats, together with the bit planes that show
+ * it, and compared against interpolating each LED in floating point, which is what the
+ * fixed-point levels replace.
+ */
+#define BANCOS 1024
+#define CANTIDAD (BANCOS * 16)
+#define PASOS 1000000
+
+static uint8_t desde[CANTIDAD];
+static uint8_t hasta[CANTIDAD];
+static uint8_t brillo[CANTIDAD];
+static uint16_t niveles8[CANTIDAD];
+static uint16_t pasos8[CANTIDAD];
+static uint32_t niveles16[CANTIDAD];
+static uint32_t pasos16[CANTIDAD];
+static uint16_t planos[LEDS_FADE_PLANES * BANCOS];
+static leds_fade_t fundido8;
+static leds_fade_t fundido16;
+
+void setUp(void)
+{
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        desde[led] = (uint8_t)(led * 71 + 5);
+        hasta[led] = (uint8_t)(led * 29 + 200);
+    }
+    leds_fade_init_q8_8(&fundido8, CANTIDAD, niveles8, pasos8);
+    leds_fade_init_q16_16(&fundido16, CANTIDAD, niveles16, pasos16);
+    leds_fade_start(&fundido8, desde, hasta, PASOS);
+    leds_fade_start(&fundido16, desde, hasta, PASOS);
+}
+
+/**
+ * @brief Interpolates every LED in floating point, as done without the fade engine.
+ */
+static void interpolar_en_coma_flotante(float fraccion)
+{
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        brillo[led] = (uint8_t)(desde[led] + (hasta[led] - desde[led]) * fraccion);
+    }
+}
+
+/**
+ * @brief Prints the LEDs per second of the most recent benchmark.
+ */
+static void informar_leds_por_segundo(void)
+{
+    char mensaje[64];
+    const UNITY_BENCHMARK_RESULT_T *resultado = UnityBenchmarkLastResult();
+
+    snprintf(mensaje, sizeof(mensaje), "%s: %.0f LEDs/s", resultado->Name, CANTIDAD * 1e9 / resultado->MedianNs);
+    TEST_MESSAGE(mensaje);
+}
+
+REGISTER_TEST(test_leds_por_segundo_del_fundido)
+{
+    float fraccion = 0.0f;
+
+    TEST_BENCHMARK_BEGIN("float tick of 16384 LEDs")
+        fraccion += 1e-6f;
+        interpolar_en_coma_flotante(fraccion);
+    TEST_BENCHMARK_END();
+    informar_leds_por_segundo();
+
+    TEST_BENCHMARK_BEGIN("Q16.16 tick of 16384 LEDs")
+        leds_fade_tick(&fundido16, brillo);
+    TEST_BENCHMARK_END();
+    informar_leds_por_segundo();
+
+    TEST_BENCHMARK_BEGIN("Q8.8 tick of 16384 LEDs")
+        leds_fade_tick(&fundido8, brillo);
+    TEST_BENCHMARK_END();
+    informar_leds_por_segundo();
+    TEST_ASSERT_FASTER_THAN("float tick of 16384 LEDs");
+
+    TEST_BENCHMARK_BEGIN("planes of 16384 LEDs")
+        leds_fade_planes(brillo, BANCOS, planos);
+    TEST_BENCHMARK_END();
+    informar_leds_por_segundo();
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
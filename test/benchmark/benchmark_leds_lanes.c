@@ -0,0 +1,109 @@
+#include "leds_lanes.h"
+#include "leds_shift.h"
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_registry.h"
+
+/**
+ * @file benchmark_leds_lanes.c
+ * @brief Benchmark of the 16-lane parallel output against bit-banging a single chain.
+ *
+ * The transpose kernel must beat building the port words one bit at a time, and shifting
+ * 16 chains in parallel must beat shifting the same bits through one chain with the
+ * backend of leds_shift.c, which needs 32 port words per 16 bits instead of 16 per 256.
+ */
+#define PALABRAS 8
+
+static uint16_t buffers[LEDS_LANES][PALABRAS];
+static const uint16_t *cadenas[LEDS_LANES];
+static uint16_t flujo[LEDS_SHIFT_STREAM_WORDS(LEDS_LANES * PALABRAS)];
+static uint16_t puerto_virtual;
+
+/**
+ * @brief Fills the chain buffers with a fixed pattern.
+ */
+void setUp(void)
+{
+    int carril;
+    int palabra;
+
+    for (carril = 0; carril < LEDS_LANES; carril++)
+    {
+        for (palabra = 0; palabra < PALABRAS; palabra++)
+        {
+            buffers[carril][palabra] = (uint16_t)(0x9E37u * (unsigned)(carril * PALABRAS + palabra + 1));
+        }
+        cadenas[carril] = buffers[carril];
+    }
+}
+
+/**
+ * @brief Naive reference: the port word of each clock gets bit 15 - clock of every chain, one bit at a time.
+ */
+static void transponer_bit_a_bit(const uint16_t carriles[LEDS_LANES], uint16_t relojes[16])
+{
+    int reloj;
+    int carril;
+
+    for (reloj = 0; reloj < 16; reloj++)
+    {
+        relojes[reloj] = 0;
+        for (carril = 0; carril < LEDS_LANES; carril++)
+        {
+            if (carriles[carril] & (1u << (15 - reloj)))
+            {
+                relojes[reloj] |= (uint16_t)(1u << carril);
+            }
+        }
+    }
+}
+
+REGISTER_TEST(test_la_transpuesta_es_mas_rapida_que_la_referencia_bit_a_bit)
+{
+    uint16_t carriles[LEDS_LANES];
+    uint16_t relojes[16];
+    int carril;
+
+    for (carril = 0; carril < LEDS_LANES; carril++)
+    {
+        carriles[carril] = buffers[carril][0];
+    }
+    TEST_BENCHMARK_BEGIN("transpose bit by bit")
+        transponer_bit_a_bit(carriles, relojes);
+        UNITY_BENCHMARK_KEEP(relojes[7]);
+    TEST_BENCHMARK_END();
+    TEST_BENCHMARK_BEGIN("transpose 16x16")
+        leds_lanes_transpose(carriles, relojes);
+        UNITY_BENCHMARK_KEEP(relojes[7]);
+    TEST_BENCHMARK_END();
+    TEST_ASSERT_FASTER_THAN("transpose bit by bit");
+}
+
+REGISTER_TEST(test_dieciseis_carriles_son_mas_rapidos_que_una_sola_cadena)
+{
+    leds_shift_t cadena;
+
+    leds_shift_init(&cadena, &puerto_virtual, 0x0001, 0x0002, 0x0004, LEDS_LANES * PALABRAS, flujo,
+                    LEDS_SHIFT_STREAM_WORDS(LEDS_LANES * PALABRAS));
+    TEST_BENCHMARK_BEGIN("one chain, 2048 bits")
+        leds_shift_write(&cadena, &buffers[0][0]);
+    TEST_BENCHMARK_END();
+    TEST_BENCHMARK_BEGIN("16 lanes, 2048 bits")
+        leds_lanes_encode(cadenas, PALABRAS, flujo, LEDS_LANES_STREAM_WORDS(PALABRAS));
+        leds_lanes_send(&puerto_virtual, flujo, LEDS_LANES_STREAM_WORDS(PALABRAS));
+    TEST_BENCHMARK_END();
+    TEST_ASSERT_FASTER_THAN("one chain, 2048 bits");
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,64 @@
+#include "leds_matrix.h"
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_registry.h"
+
+/**
+ * @file benchmark_leds_matrix.c
+ * @brief Benchmark of the scan tick of the LED matrix driver.
+ *
+ * The tick is timed on the smallest matrix with every pixel off and on the largest one
+ * with every pixel on and rows of different brightness. Since the port word of each row
+ * is computed when the framebuffer changes, both must cost the same.
+ */
+
+/**
+ * @brief How much slower the tick of the full matrix may be, to allow for timing noise.
+ */
+#define TOLERANCIA 1.5
+
+static uint16_t puerto_virtual;
+static leds_matrix_t matriz;
+
+void setUp(void)
+{
+}
+
+REGISTER_TEST(test_el_costo_del_tick_no_depende_de_la_matriz)
+{
+    double chica;
+    double grande;
+    int fila;
+
+    leds_matrix_init(&matriz, &puerto_virtual, 1, 1, 0x0000);
+    TEST_BENCHMARK_BEGIN("tick 1x1 apagada")
+        leds_matrix_scan(&matriz);
+    TEST_BENCHMARK_END();
+    chica = UnityBenchmarkLastResult()->MedianNs;
+
+    leds_matrix_init(&matriz, &puerto_virtual, 8, 8, 0x00FF);
+    for (fila = 1; fila <= 8; fila++)
+    {
+        leds_matrix_set_row(&matriz, fila, 0xFF);
+        leds_matrix_set_brightness(&matriz, fila, fila * 2);
+    }
+    TEST_BENCHMARK_BEGIN("tick 8x8 encendida")
+        leds_matrix_scan(&matriz);
+    TEST_BENCHMARK_END();
+    grande = UnityBenchmarkLastResult()->MedianNs;
+
+    TEST_ASSERT_TRUE_MESSAGE(grande < chica * TOLERANCIA + 1.0, "The scan tick depends on the size of the matrix");
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
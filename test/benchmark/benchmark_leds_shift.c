@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include "leds_shift.h"
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_registry.h"
+
+/**
+ * @file benchmark_leds_shift.c
+ * @brief Benchmark of the frames per second of the shift register chain backend.
+ *
+ * A whole frame is encoded and written to a virtual port for a chain of one bank and for
+ * one of eight banks. The frame rate is printed, and the cost of a frame must grow
+ * linearly with the number of banks.
+ */
+#define BANCOS 8
+
+static uint16_t puerto_virtual;
+static uint16_t flujo[LEDS_SHIFT_STREAM_WORDS(BANCOS)];
+static leds_shift_t cadena;
+
+void setUp(void)
+{
+}
+
+/**
+ * @brief Prints the frames per second of the most recent benchmark.
+ */
+static void informar_cuadros_por_segundo(void)
+{
+    char mensaje[64];
+    const UNITY_BENCHMARK_RESULT_T *resultado = UnityBenchmarkLastResult();
+
+    snprintf(mensaje, sizeof(mensaje), "%s: %.0f frames/s", resultado->Name, 1e9 / resultado->MedianNs);
+    TEST_MESSAGE(mensaje);
+}
+
+REGISTER_TEST(test_cuadros_por_segundo_de_la_cadena)
+{
+    const uint16_t cuadro[BANCOS] = {0x0001, 0x8000, 0xA5A5, 0x5A5A, 0xFFFF, 0x0000, 0x1234, 0xFEDC};
+    double uno;
+    double ocho;
+
+    leds_shift_init(&cadena, &puerto_virtual, 0x0001, 0x0002, 0x0004, 1, flujo, LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    TEST_BENCHMARK_BEGIN("frame 1 bank")
+        leds_shift_write(&cadena, cuadro);
+    TEST_BENCHMARK_END();
+    informar_cuadros_por_segundo();
+    uno = UnityBenchmarkLastResult()->MedianNs;
+
+    leds_shift_init(&cadena, &puerto_virtual, 0x0001, 0x0002, 0x0004, BANCOS, flujo, LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    TEST_BENCHMARK_BEGIN("frame 8 banks")
+        leds_shift_write(&cadena, cuadro);
+    TEST_BENCHMARK_END();
+    informar_cuadros_por_segundo();
+    ocho = UnityBenchmarkLastResult()->MedianNs;
+
+    TEST_ASSERT_TRUE_MESSAGE(ocho < uno * BANCOS * 1.5, "The cost of a frame grows faster than the number of banks");
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
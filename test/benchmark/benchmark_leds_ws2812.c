@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include "leds_ws2812.h"
+#include "unity.h"
+#include "unity_benchmark.h"
+#include "unity_registry.h"
+
+/**
+ * @file benchmark_leds_ws2812.c
+ * @brief Benchmark of the pixels per second of the addressable LED encoder.
+ *
+ * A strip of 256 pixels is encoded whole and then only one pixel of it, which must be
+ * much cheaper, since incremental encoding is what a frame with few changes pays.
+ */
+#define PIXELES 256
+
+static uint16_t buffer[LEDS_WS2812_BUFFER_WORDS(PIXELES, 3, 64)];
+static uint8_t colores[3 * PIXELES];
+static leds_ws2812_t tira;
+
+void setUp(void)
+{
+    int indice;
+
+    leds_ws2812_init(&tira, 0x0001, 3, PIXELES, 64, buffer, (int)(sizeof(buffer) / sizeof(buffer[0])));
+    for (indice = 0; indice < 3 * PIXELES; indice++)
+    {
+        colores[indice] = (uint8_t)(indice * 37 + 11);
+    }
+}
+
+/**
+ * @brief Prints the pixels per second of the most recent benchmark.
+ */
+static void informar_pixeles_por_segundo(int pixeles)
+{
+    char mensaje[64];
+    const UNITY_BENCHMARK_RESULT_T *resultado = UnityBenchmarkLastResult();
+
+    snprintf(mensaje, sizeof(mensaje), "%s: %.0f pixels/s", resultado->Name, pixeles * 1e9 / resultado->MedianNs);
+    TEST_MESSAGE(mensaje);
+}
+
+REGISTER_TEST(test_pixeles_por_segundo_del_codificador)
+{
+    TEST_BENCHMARK_BEGIN("encode 256 pixels")
+        leds_ws2812_encode(&tira, colores, 0, PIXELES);
+    TEST_BENCHMARK_END();
+    informar_pixeles_por_segundo(PIXELES);
+
+    TEST_BENCHMARK_BEGIN("encode 1 changed pixel")
+        leds_ws2812_encode(&tira, colores, PIXELES / 2, 1);
+    TEST_BENCHMARK_END();
+    informar_pixeles_por_segundo(1);
+
+    TEST_ASSERT_FASTER_THAN("encode 256 pixels");
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
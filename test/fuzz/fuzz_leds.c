@@ -0,0 +1,206 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "leds.h"
+
+/**
+ * @file fuzz_leds.c
+ * @brief Coverage-guided fuzz target for the LED controller.
+ *
+ * Each input is read as a sequence of driver calls. The low three bits of a byte select the call:
+ *
+ * | Bits | Call                               | Extra byte                  |
+ * |------|------------------------------------|-----------------------------|
+ * | 0    | leds_turn_on(led)                  | led, as a signed 8-bit value |
+ * | 1    | leds_turn_off(led)                 | led, as a signed 8-bit value |
+ * | 2    | leds_state(led)                    | led, as a signed 8-bit value |
+ * | 3    | leds_turn_all_on()                 |                             |
+ * | 4    | leds_turn_all_off()                |                             |
+ * | 5    | leds_init(&port_a)                 |                             |
+ * | 6    | leds_init(&port_b)                 |                             |
+ * | 7    | leds_init(NULL)                    |                             |
+ *
+ * The same calls are applied to a reference model, and after each one the return value and both virtual ports
+ * must match it: the attached port holds the model's LEDs and the other port is never written. The high bits of
+ * an initialization byte are written to the port first, so that the initialization must clear them.
+ * leds_init(NULL) must be ignored.
+ *
+ * Every input starts with port a attached and both ports cleared. The first input of a process is also run once
+ * before that, while the driver has never been initialized, so the calls made without a port are checked too;
+ * an input run on its own is the first one, so it reproduces either run.
+ * Built with clang -fsanitize=fuzzer this file is a libFuzzer target; fuzz_replay.c runs it on saved inputs.
+ */
+
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+static uint16_t port_a;
+static uint16_t port_b;
+
+/** @brief What the driver should have done so far. */
+static struct
+{
+    uint16_t *port;
+    uint16_t leds;
+} model;
+
+/**
+ * @brief Reports a mismatch between the driver and the model and aborts, which the fuzzer records as a crash.
+ */
+static void fuzz_fail(size_t offset, const char *call, int led, int returned, int expected)
+{
+    fprintf(stderr,
+            "fuzz_leds: byte %lu, %s(%d) returned %d (expected %d), port a 0x%04X, port b 0x%04X, model %c 0x%04X\n",
+            (unsigned long)offset, call, led, returned, expected, (unsigned)port_a, (unsigned)port_b,
+            model.port == NULL ? '-' : (model.port == &port_a ? 'a' : 'b'), (unsigned)model.leds);
+    abort();
+}
+
+static int model_valid(int led) { return model.port != NULL && led >= 1 && led <= 16; }
+
+static uint16_t model_bit(int led) { return (uint16_t)(1u << (led - 1)); }
+
+/**
+ * @brief Checks both virtual ports against the model after a call.
+ *
+ * @param untouched_a The value port a must still hold if it is not attached.
+ * @param untouched_b The value port b must still hold if it is not attached.
+ * @return int 1 when both ports hold what the model expects.
+ */
+static int model_matches_ports(uint16_t untouched_a, uint16_t untouched_b)
+{
+    uint16_t expected_a = (model.port == &port_a) ? model.leds : untouched_a;
+    uint16_t expected_b = (model.port == &port_b) ? model.leds : untouched_b;
+    return port_a == expected_a && port_b == expected_b;
+}
+
+/**
+ * @brief Runs the calls of an input from the current state, aborting at the first one where the driver disagrees
+ * with the model.
+ *
+ * @param data The input bytes.
+ * @param size The number of input bytes.
+ */
+static void fuzz_run_calls(const uint8_t *data, size_t size)
+{
+    static const char *const names[] = {"leds_turn_on", "leds_turn_off", "leds_state", "leds_turn_all_on",
+                                        "leds_turn_all_off", "leds_init(a)", "leds_init(b)", "leds_init(NULL)"};
+    size_t i = 0;
+
+    while (i < size)
+    {
+        const size_t offset = i;
+        const uint8_t byte = data[i++];
+        const int call = byte & 7;
+        uint16_t *target = NULL;
+        uint16_t before_a;
+        uint16_t before_b;
+        int led = 0;
+        int returned = 0;
+        int expected = 0;
+
+        if (call <= 2)
+        {
+            if (i == size)
+            {
+                break;
+            }
+            led = (int8_t)data[i++];
+            expected = model_valid(led) ? SUCCESS_CODE : ERROR_CODE;
+        }
+        else if (call >= 5)
+        {
+            target = (call == 5) ? &port_a : (call == 6) ? &port_b : NULL;
+            if (target != NULL)
+            {
+                *target = (uint16_t)((byte >> 3) * 0x0841u);
+            }
+        }
+        before_a = port_a;
+        before_b = port_b;
+
+        switch (call)
+        {
+        case 0:
+            if (model_valid(led))
+            {
+                model.leds |= model_bit(led);
+            }
+            returned = leds_turn_on(led);
+            break;
+        case 1:
+            if (model_valid(led))
+            {
+                model.leds &= (uint16_t)~model_bit(led);
+            }
+            returned = leds_turn_off(led);
+            break;
+        case 2:
+            if (model_valid(led))
+            {
+                expected = (model.leds & model_bit(led)) != 0;
+            }
+            returned = leds_state(led);
+            break;
+        case 3:
+            if (model.port != NULL)
+            {
+                model.leds = 0xFFFF;
+            }
+            leds_turn_all_on();
+            break;
+        case 4:
+            if (model.port != NULL)
+            {
+                model.leds = 0;
+            }
+            leds_turn_all_off();
+            break;
+        default:
+            if (target != NULL)
+            {
+                model.port = target;
+                model.leds = 0;
+            }
+            leds_init(target);
+            break;
+        }
+
+        if (returned != expected || !model_matches_ports(before_a, before_b))
+        {
+            fuzz_fail(offset, names[call], led, returned, expected);
+        }
+    }
+}
+
+/**
+ * @brief Runs one input, aborting at the first call where the driver disagrees with the model.
+ *
+ * @param data The input bytes.
+ * @param size The number of input bytes.
+ * @return int Always 0, as libFuzzer requires.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static int initialized;
+
+    port_a = 0;
+    port_b = 0;
+    if (!initialized)
+    {
+        initialized = 1;
+        model.port = NULL;
+        model.leds = 0;
+        fuzz_run_calls(data, size);
+        port_a = 0;
+        port_b = 0;
+    }
+    leds_init(&port_a);
+    model.port = &port_a;
+    model.leds = 0;
+    fuzz_run_calls(data, size);
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file fuzz_replay.c
+ * @brief Runs a libFuzzer target on saved inputs, for compilers without -fsanitize=fuzzer.
+ *
+ * Each argument is a file or a directory of files, such as the seed corpus or a crash found by the fuzzer.
+ * With no argument, one input is read from standard input. Any mismatch aborts, as it does under libFuzzer.
+ */
+
+#define FUZZ_REPLAY_MAX_INPUT 65536
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static uint8_t input[FUZZ_REPLAY_MAX_INPUT];
+
+/**
+ * @brief Reads a whole input and runs the target on it.
+ *
+ * @return int 0 on success, 1 when the input cannot be read.
+ */
+static int replay_stream(FILE *stream, const char *name)
+{
+    size_t size = fread(input, 1, sizeof(input), stream);
+    if (ferror(stream))
+    {
+        fprintf(stderr, "fuzz_replay: cannot read %s\n", name);
+        return 1;
+    }
+    LLVMFuzzerTestOneInput(input, size);
+    return 0;
+}
+
+static int replay_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    int status;
+    if (file == NULL)
+    {
+        fprintf(stderr, "fuzz_replay: cannot open %s\n", path);
+        return 1;
+    }
+    status = replay_stream(file, path);
+    fclose(file);
+    return status;
+}
+
+/**
+ * @brief Replays every file of a directory, or the path itself when it is not a directory.
+ *
+ * @return int The number of inputs that could not be read.
+ */
+static int replay_path(const char *path, unsigned long *count)
+{
+    char child[4096];
+    struct dirent *entry;
+    DIR *dir = opendir(path);
+    int failures = 0;
+
+    if (dir == NULL)
+    {
+        (*count)++;
+        return replay_file(path);
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        (*count)++;
+        failures += replay_file(child);
+    }
+    closedir(dir);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long count = 0;
+    int failures = 0;
+    int i;
+
+    if (argc < 2)
+    {
+        return replay_stream(stdin, "standard input");
+    }
+    for (i = 1; i < argc; i++)
+    {
+        failures += replay_path(argv[i], &count);
+    }
+    printf("fuzz_replay: %lu inputs, %d unreadable\n", count, failures);
+    return failures != 0;
+}
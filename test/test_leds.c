@@ -1,5 +1,6 @@
-#include "/home/edda/Documentos/CESE/TSSE/Leds/src/leds.h"
-#include "/home/edda/Documentos/CESE/TSSE/Leds/lib/Unity/src/unity.h"
+#include "leds.h"
+#include "unity.h"
+#include "unity_registry.h"
 
 /**
  * @file test_leds.c
@@ -20,6 +21,7 @@
  * 8. Check the state of an LED that is off.
  * 9. Check parameter limits.
  * 10. Check parameters outside the limits.
+ * 11. Without a port, no LED is modified.
  *
  * * Test Cases:
  * 1. Initialize the controller: Verify that all LEDs are turned off. (Requirement 1)
@@ -32,11 +34,26 @@
  * 8. Check for limit values. (Requirement 10)
  * 9. Turn on multiple LEDs: Verify that multiple LEDs can be turned on simultaneously. (Requirement 4)
  * 10. Turn off multiple LEDs: Verify that multiple LEDs can be turned off simultaneously. (Requirement 4)
+ * 11. Release the port: Verify that no call modifies the previous port or succeeds. (Requirement 11)
  */
 static uint16_t leds_virtuales;
 #define ERROR_CODE -1
 #define SUCCESS_CODE 1
 
+#ifdef LEDS_DIFFERENTIAL_CHECK
+/**
+ * @brief Fails the running test when the driver and the reference model disagree.
+ *
+ * Installed in differential builds, so that every test also checks the driver against the model.
+ *
+ * @param mensaje The description of the mismatch.
+ */
+static void fallar_por_diferencia(const char *mensaje)
+{
+    TEST_FAIL_MESSAGE(mensaje);
+}
+#endif
+
 /**
  * @brief Set up function for the test case.
  *
@@ -45,10 +62,13 @@ static uint16_t leds_virtuales;
  */
 void setUp(void)
 {
+#ifdef LEDS_DIFFERENTIAL_CHECK
+    leds_differential_set_handler(fallar_por_diferencia);
+#endif
     leds_init(&leds_virtuales);
 }
 
-void test_todos_los_leds_inician_apagados(void)
+REGISTER_TEST(test_todos_los_leds_inician_apagados)
 {
     uint16_t leds_virtuales = 0xFF;
     leds_init(&leds_virtuales);
@@ -62,7 +82,7 @@ void test_todos_los_leds_inician_apagados(void)
  * It verifies that the LED is turned on and the corresponding bit in the
  * virtual LED state is set to high.
  */
-void test_encender_un_led(void)
+REGISTER_TEST(test_encender_un_led)
 {
     static const int LED = 1;
     leds_turn_on(LED);
@@ -76,7 +96,7 @@ void test_encender_un_led(void)
  * It verifies that the LED is turned off and the corresponding bit in the
  * virtual LED state is set to low.
  */
-void test_apagar_un_led_previamente_encendido(void)
+REGISTER_TEST(test_apagar_un_led_previamente_encendido)
 {
     static const int LED = 1;
     leds_turn_on(LED);
@@ -91,7 +111,7 @@ void test_apagar_un_led_previamente_encendido(void)
  * This function tests the functionality of checking the state of a specific LED.
  * It verifies that the LED is reported as on after being turned on.
  */
-void test_verificar_estado_de_led_encendido(void)
+REGISTER_TEST(test_verificar_estado_de_led_encendido)
 {
     static const int LED = 3;
     leds_turn_on(LED);
@@ -106,7 +126,7 @@ void test_verificar_estado_de_led_encendido(void)
  *
  * @note The expected value of leds_virtuales after calling leds_turn_all_on() is 0xFFFF.
  */
-void test_encender_todos_los_leds_apagados(void)
+REGISTER_TEST(test_encender_todos_los_leds_apagados)
 {
     leds_turn_all_on();
     TEST_ASSERT_EQUAL_HEX16(0XFFFF, leds_virtuales);
@@ -119,7 +139,7 @@ void test_encender_todos_los_leds_apagados(void)
  * and then asserts that the `leds_virtuales` variable is equal to 0x00,
  * indicating that all LEDs are indeed turned off.
  */
-void test_apagar_todos_los_leds_encendidos(void)
+REGISTER_TEST(test_apagar_todos_los_leds_encendidos)
 {
     leds_turn_all_off();
     TEST_ASSERT_EQUAL_HEX16(0x00, leds_virtuales);
@@ -135,7 +155,7 @@ void test_apagar_todos_los_leds_encendidos(void)
  * @note This function uses the `leds_turn_on` function to turn on the LEDs
  * and `TEST_ASSERT_EQUAL_HEX16` to assert the expected state.
  */
-void test_encender_multiples_leds(void)
+REGISTER_TEST(test_encender_multiples_leds)
 {
     static const int LED7 = 7;
     static const int LED13 = 13;
@@ -157,7 +177,7 @@ void test_encender_multiples_leds(void)
  * @note This function uses the `leds_turn_on` and `leds_turn_off` functions to control the LEDs.
  *       It also uses the `TEST_ASSERT_EQUAL_HEX16` macro to verify the final state of the LEDs.
  */
-void test_apagar_multiples_leds(void)
+REGISTER_TEST(test_apagar_multiples_leds)
 {
     static const int LED1 = 1;
     static const int LED5 = 5;
@@ -182,7 +202,7 @@ void test_apagar_multiples_leds(void)
  *
  * @note The boundary values tested are LED1 (16) and LED2 (1).
  */
-void test_verificar_valores_limites(void)
+REGISTER_TEST(test_verificar_valores_limites)
 {
     static const int LED1 = 16;
     static const int LED2 = 1;
@@ -206,7 +226,7 @@ void test_verificar_valores_limites(void)
  * Expected behavior:
  * - The `leds_turn_on` function should return `ERROR_CODE` for each of the invalid LED indices.
  */
-void test_encender_leds_fuera_de_limites(void)
+REGISTER_TEST(test_encender_leds_fuera_de_limites)
 {
     static const int LED1 = 17, LED2 = -4, LED3 = 0;
     TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(LED1));
@@ -225,7 +245,7 @@ void test_encender_leds_fuera_de_limites(void)
  *
  * The function asserts that the `leds_turn_off` function returns `ERROR_CODE` for each of these invalid indices.
  */
-void test_apagar_leds_fuera_de_limites(void)
+REGISTER_TEST(test_apagar_leds_fuera_de_limites)
 {
     static const int LED1 = 33, LED2 = -12, LED3 = 0;
     TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_off(LED1));
@@ -249,7 +269,7 @@ void test_apagar_leds_fuera_de_limites(void)
  * The expected behavior is that the `leds_state` function returns `ERROR_CODE` for each of these
  * invalid indices.
  */
-void test_verificar_estado_de_led_fuera_de_limites(void)
+REGISTER_TEST(test_verificar_estado_de_led_fuera_de_limites)
 {
     static const int LED1 = 33, LED2 = -12, LED3 = 0;
     ;
@@ -258,22 +278,43 @@ void test_verificar_estado_de_led_fuera_de_limites(void)
     TEST_ASSERT_EQUAL(ERROR_CODE, leds_state(LED3));
 }
 
-int main(void)
+/**
+ * @brief Test function to verify that initializing with a NULL port is ignored.
+ *
+ * The driver must keep the port it had, with its LEDs, and go on using it.
+ */
+REGISTER_TEST(test_iniciar_sin_puerto_se_ignora)
+{
+    leds_turn_on(3);
+    leds_init(NULL);
+    TEST_ASSERT_EQUAL_HEX16(0x0004, leds_virtuales);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(5));
+    TEST_ASSERT_EQUAL(1, leds_state(3));
+    TEST_ASSERT_EQUAL_HEX16(0x0014, leds_virtuales);
+}
+
+#ifdef LEDS_DIFFERENTIAL_CHECK
+/**
+ * @brief Test function to verify that the differential check detects a port that does not match the model.
+ *
+ * The port is written behind the driver's back, so the next call leaves it different from the reference model.
+ */
+REGISTER_TEST(test_la_verificacion_diferencial_detecta_diferencias)
+{
+    const unsigned long diferencias = leds_differential_mismatches();
+    leds_differential_set_handler(NULL);
+    leds_virtuales = 0x8000;
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(1));
+    TEST_ASSERT_EQUAL(diferencias + 1, leds_differential_mismatches());
+}
+#endif
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
 {
-    UNITY_BEGIN();
-    RUN_TEST(test_todos_los_leds_inician_apagados);
-    RUN_TEST(test_encender_un_led);
-    RUN_TEST(test_apagar_un_led_previamente_encendido);
-    RUN_TEST(test_verificar_estado_de_led_encendido);
-    RUN_TEST(test_encender_todos_los_leds_apagados);
-    RUN_TEST(test_apagar_todos_los_leds_encendidos);
-    RUN_TEST(test_encender_multiples_leds);
-    RUN_TEST(test_apagar_multiples_leds);
-    RUN_TEST(test_verificar_estado_de_led_encendido);
-    RUN_TEST(test_encender_leds_fuera_de_limites);
-    RUN_TEST(test_apagar_leds_fuera_de_limites);
-    RUN_TEST(test_verificar_estado_de_led_fuera_de_limites);
-    return UNITY_END();
+    return UnityRegistryMain(argc, argv);
 }
 
 void tearDown(void)
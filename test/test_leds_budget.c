@@ -0,0 +1,207 @@
+#include "leds.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_budget.c
+ * @brief Test cases for the power budget of the LED controller.
+ *
+ * The budget is attached to a virtual port and shared with another bank, whose words are
+ * charged with leds_budget_request. It is not run in the differential build, since the
+ * reference model has no budget.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+static uint16_t leds_virtuales;
+static leds_budget_t presupuesto;
+
+void setUp(void)
+{
+    leds_set_budget(NULL);
+    leds_init(&leds_virtuales);
+}
+
+REGISTER_TEST(test_no_se_encienden_mas_leds_que_los_del_presupuesto)
+{
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 3, 100, NULL));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_set_budget(&presupuesto));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(1));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(2));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(3));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(4));
+    TEST_ASSERT_EQUAL_HEX16(0x0007, leds_virtuales);
+    TEST_ASSERT_EQUAL(3, presupuesto.lit);
+    TEST_ASSERT_EQUAL(3, presupuesto.current);
+}
+
+REGISTER_TEST(test_apagar_un_led_libera_su_parte_del_presupuesto)
+{
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 2, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(1);
+    leds_turn_on(2);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_off(2));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(4));
+    TEST_ASSERT_EQUAL_HEX16(0x0009, leds_virtuales);
+    leds_turn_all_off();
+    TEST_ASSERT_EQUAL(0, presupuesto.lit);
+    TEST_ASSERT_EQUAL(0, presupuesto.current);
+}
+
+REGISTER_TEST(test_encender_un_led_ya_encendido_no_consume_presupuesto)
+{
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 1, 100, NULL);
+    leds_set_budget(&presupuesto);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(5));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(5));
+    TEST_ASSERT_EQUAL(1, presupuesto.lit);
+}
+
+REGISTER_TEST(test_la_corriente_suma_el_peso_de_cada_linea)
+{
+    const uint8_t pesos[16] = {10, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 255};
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 16, 16, pesos);
+    leds_set_budget(&presupuesto);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(1));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(2));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(3));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(4));
+    TEST_ASSERT_EQUAL(16, presupuesto.current);
+    leds_turn_off(1);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(16));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(4));
+    TEST_ASSERT_EQUAL(9, presupuesto.current);
+}
+
+REGISTER_TEST(test_encender_todos_sin_lugar_no_cambia_el_puerto)
+{
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 4, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(9);
+    leds_turn_all_on();
+    TEST_ASSERT_EQUAL_HEX16(0x0100, leds_virtuales);
+    TEST_ASSERT_EQUAL(1, presupuesto.lit);
+}
+
+REGISTER_TEST(test_encender_todos_escalado_enciende_los_que_entran)
+{
+    const uint8_t pesos[16] = {9, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_SCALE, 4, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_all_on();
+    TEST_ASSERT_EQUAL_HEX16(0x000F, leds_virtuales);
+    leds_turn_all_off();
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_SCALE, 16, 5, pesos);
+    leds_set_budget(&presupuesto);
+    leds_turn_all_on();
+    TEST_ASSERT_EQUAL_HEX16(0x003E, leds_virtuales);
+    TEST_ASSERT_EQUAL(5, presupuesto.lit);
+    TEST_ASSERT_EQUAL(5, presupuesto.current);
+}
+
+REGISTER_TEST(test_el_presupuesto_se_comparte_entre_bancos)
+{
+    uint16_t otro_banco = 0x00FF;
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_SCALE, 6, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(1);
+    leds_turn_on(2);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_request(&presupuesto, 0x0000, &otro_banco));
+    TEST_ASSERT_EQUAL_HEX16(0x000F, otro_banco);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(3));
+
+    otro_banco = 0x0001;
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_budget_request(&presupuesto, 0x000F, &otro_banco));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(3));
+    TEST_ASSERT_EQUAL(4, presupuesto.lit);
+}
+
+REGISTER_TEST(test_asignar_un_presupuesto_cobra_los_leds_ya_encendidos)
+{
+    leds_turn_on(1);
+    leds_turn_on(2);
+    leds_turn_on(3);
+    leds_budget_init(&presupuesto, LEDS_BUDGET_SCALE, 2, 100, NULL);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_set_budget(&presupuesto));
+    TEST_ASSERT_EQUAL(0, presupuesto.lit);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_turn_on(4));
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 5, 100, NULL);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_set_budget(&presupuesto));
+    TEST_ASSERT_EQUAL(4, presupuesto.lit);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_set_budget(NULL));
+    TEST_ASSERT_EQUAL(0, presupuesto.lit);
+}
+
+REGISTER_TEST(test_un_presupuesto_rechazado_deja_el_anterior_en_vigor)
+{
+    leds_budget_t mas_chico;
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 3, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(1);
+    leds_turn_on(2);
+    leds_turn_on(3);
+    leds_budget_init(&mas_chico, LEDS_BUDGET_REJECT, 2, 100, NULL);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_set_budget(&mas_chico));
+    TEST_ASSERT_EQUAL(0, mas_chico.lit);
+    TEST_ASSERT_EQUAL(3, presupuesto.lit);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_turn_on(4));
+    leds_turn_all_on();
+    TEST_ASSERT_EQUAL_HEX16(0x0007, leds_virtuales);
+}
+
+REGISTER_TEST(test_asignar_otra_vez_el_mismo_presupuesto_no_cobra_dos_veces)
+{
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 2, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(1);
+    leds_turn_on(2);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_set_budget(&presupuesto));
+    TEST_ASSERT_EQUAL(2, presupuesto.lit);
+}
+
+REGISTER_TEST(test_cambiar_de_puerto_libera_el_presupuesto)
+{
+    uint16_t otro_puerto = 0xFFFF;
+
+    leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 3, 100, NULL);
+    leds_set_budget(&presupuesto);
+    leds_turn_on(1);
+    leds_turn_on(2);
+    leds_init(&otro_puerto);
+    TEST_ASSERT_EQUAL(0, presupuesto.lit);
+    TEST_ASSERT_EQUAL_HEX16(0x0003, leds_virtuales);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, otro_puerto);
+}
+
+REGISTER_TEST(test_parametros_invalidos_devuelven_error)
+{
+    uint16_t palabra = 0x0001;
+
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_init(NULL, LEDS_BUDGET_REJECT, 1, 1, NULL));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_init(&presupuesto, (leds_budget_mode_t)7, 1, 1, NULL));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, -1, 1, NULL));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 1, -1, NULL));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_budget_init(&presupuesto, LEDS_BUDGET_REJECT, 1, 1, NULL));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_request(NULL, 0, &palabra));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_budget_request(&presupuesto, 0, NULL));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,196 @@
+#include <string.h>
+#include "leds_charlieplex.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_charlieplex.c
+ * @brief Test cases for the charlieplexed LED driver.
+ *
+ * The port is a virtual tri-state port of a direction and a level word. A model of the
+ * wiring lights the LED between two lines only when both are outputs, the first one high
+ * and the second one low, so the tests see the LEDs a real board would light, including
+ * any lit by mistake.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+#define LINEAS 4
+#define LEDS (LINEAS * (LINEAS - 1))
+
+static uint16_t direccion;
+static uint16_t nivel;
+static leds_charlieplex_t charlieplex;
+
+/**
+ * @brief Set up function for the test case.
+ *
+ * Initializes 12 LEDs on 4 lines, over a port with every line driven high.
+ */
+void setUp(void)
+{
+    direccion = 0xFFFF;
+    nivel = 0xFFFF;
+    leds_charlieplex_init(&charlieplex, &direccion, &nivel, LINEAS);
+}
+
+/**
+ * @brief Returns whether the virtual port lights the LED from line alta to line baja, counted from 1.
+ */
+static int puerto_enciende(int alta, int baja)
+{
+    const uint16_t bit_alta = (uint16_t)(1u << (alta - 1));
+    const uint16_t bit_baja = (uint16_t)(1u << (baja - 1));
+    return (direccion & bit_alta) && (direccion & bit_baja) && (nivel & bit_alta) && !(nivel & bit_baja);
+}
+
+/**
+ * @brief Scans a whole frame and marks every LED the virtual port lit in any of its steps.
+ *
+ * @param encendidos One flag per LED, from LED 1.
+ */
+static void escanear_cuadro(int lineas, int encendidos[])
+{
+    int paso;
+    int led;
+    int alta;
+    int baja;
+
+    memset(encendidos, 0, sizeof(int) * (size_t)(lineas * (lineas - 1)));
+    for (paso = 0; paso < leds_charlieplex_steps(&charlieplex); paso++)
+    {
+        leds_charlieplex_scan(&charlieplex);
+        for (led = 1; led <= lineas * (lineas - 1); led++)
+        {
+            leds_charlieplex_lines(&charlieplex, led, &alta, &baja);
+            encendidos[led - 1] |= puerto_enciende(alta, baja);
+        }
+    }
+}
+
+REGISTER_TEST(test_al_iniciar_todas_las_lineas_quedan_en_alta_impedancia)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x0000, direccion);
+    TEST_ASSERT_EQUAL(0, leds_charlieplex_steps(&charlieplex));
+}
+
+REGISTER_TEST(test_iniciar_con_parametros_invalidos_devuelve_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_init(&charlieplex, &direccion, NULL, LINEAS));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_init(&charlieplex, &direccion, &nivel, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_init(&charlieplex, &direccion, &nivel, 17));
+}
+
+REGISTER_TEST(test_los_leds_se_numeran_por_linea_alta_y_luego_por_linea_baja)
+{
+    int alta;
+    int baja;
+
+    leds_charlieplex_lines(&charlieplex, 1, &alta, &baja);
+    TEST_ASSERT_EQUAL(1, alta);
+    TEST_ASSERT_EQUAL(2, baja);
+    leds_charlieplex_lines(&charlieplex, 4, &alta, &baja);
+    TEST_ASSERT_EQUAL(2, alta);
+    TEST_ASSERT_EQUAL(1, baja);
+    leds_charlieplex_lines(&charlieplex, LEDS, &alta, &baja);
+    TEST_ASSERT_EQUAL(4, alta);
+    TEST_ASSERT_EQUAL(3, baja);
+}
+
+REGISTER_TEST(test_prender_un_led_enciende_solo_ese_led)
+{
+    int encendidos[LEDS];
+    const int esperados[LEDS] = {0, 0, 0, 0, 0, 1};
+
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_charlieplex_turn_on(&charlieplex, 6));
+    TEST_ASSERT_EQUAL(1, leds_charlieplex_steps(&charlieplex));
+    escanear_cuadro(LINEAS, encendidos);
+    TEST_ASSERT_EQUAL_INT_ARRAY(esperados, encendidos, LEDS);
+    TEST_ASSERT_EQUAL(1, leds_charlieplex_state(&charlieplex, 6));
+}
+
+REGISTER_TEST(test_los_leds_de_una_misma_linea_alta_se_encienden_en_un_solo_paso)
+{
+    int encendidos[LEDS];
+    const int esperados[LEDS] = {0, 0, 0, 1, 1, 1};
+
+    leds_charlieplex_turn_on(&charlieplex, 4);
+    leds_charlieplex_turn_on(&charlieplex, 5);
+    leds_charlieplex_turn_on(&charlieplex, 6);
+    TEST_ASSERT_EQUAL(1, leds_charlieplex_steps(&charlieplex));
+    escanear_cuadro(LINEAS, encendidos);
+    TEST_ASSERT_EQUAL_INT_ARRAY(esperados, encendidos, LEDS);
+}
+
+REGISTER_TEST(test_cada_linea_alta_con_leds_prendidos_agrega_un_paso)
+{
+    int encendidos[LEDS];
+    const int esperados[LEDS] = {1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    leds_charlieplex_turn_on(&charlieplex, 1);
+    leds_charlieplex_turn_on(&charlieplex, 3);
+    leds_charlieplex_turn_on(&charlieplex, 8);
+    leds_charlieplex_turn_on(&charlieplex, 12);
+    TEST_ASSERT_EQUAL(3, leds_charlieplex_steps(&charlieplex));
+    escanear_cuadro(LINEAS, encendidos);
+    TEST_ASSERT_EQUAL_INT_ARRAY(esperados, encendidos, LEDS);
+}
+
+REGISTER_TEST(test_apagar_un_led_lo_quita_del_cuadro)
+{
+    int encendidos[LEDS];
+    const int esperados[LEDS] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    leds_charlieplex_turn_on(&charlieplex, 2);
+    leds_charlieplex_turn_on(&charlieplex, 8);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_charlieplex_turn_off(&charlieplex, 2));
+    TEST_ASSERT_EQUAL(1, leds_charlieplex_steps(&charlieplex));
+    escanear_cuadro(LINEAS, encendidos);
+    TEST_ASSERT_EQUAL_INT_ARRAY(esperados, encendidos, LEDS);
+    TEST_ASSERT_EQUAL(0, leds_charlieplex_state(&charlieplex, 2));
+}
+
+REGISTER_TEST(test_sin_leds_prendidos_las_lineas_quedan_en_alta_impedancia)
+{
+    leds_charlieplex_turn_on(&charlieplex, 5);
+    leds_charlieplex_scan(&charlieplex);
+    leds_charlieplex_turn_all_off(&charlieplex);
+    leds_charlieplex_scan(&charlieplex);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, direccion);
+    TEST_ASSERT_EQUAL(0, leds_charlieplex_steps(&charlieplex));
+}
+
+REGISTER_TEST(test_los_leds_fuera_de_rango_devuelven_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_turn_on(&charlieplex, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_turn_on(&charlieplex, LEDS + 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_turn_off(&charlieplex, LEDS + 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_charlieplex_state(&charlieplex, -1));
+}
+
+REGISTER_TEST(test_dieciseis_lineas_encienden_240_leds_en_16_pasos)
+{
+    static int encendidos[LEDS_CHARLIEPLEX_MAX_LEDS];
+    int led;
+
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_charlieplex_init(&charlieplex, &direccion, &nivel, 16));
+    for (led = 1; led <= LEDS_CHARLIEPLEX_MAX_LEDS; led++)
+    {
+        TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_charlieplex_turn_on(&charlieplex, led));
+    }
+    TEST_ASSERT_EQUAL(16, leds_charlieplex_steps(&charlieplex));
+    escanear_cuadro(16, encendidos);
+    TEST_ASSERT_EACH_EQUAL_INT(1, encendidos, LEDS_CHARLIEPLEX_MAX_LEDS);
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,146 @@
+#include "leds_display.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_display.c
+ * @brief Test cases for the 16-segment display layer.
+ *
+ * Three virtual ports act as three digits. The tests check the font table, writing
+ * whole strings across the banks and the precomputed frames of a scrolling marquee.
+ */
+#define BANCOS 3
+#define ERROR_CODE -1
+
+static uint16_t digitos[BANCOS];
+static uint16_t *const puertos[BANCOS] = {&digitos[0], &digitos[1], &digitos[2]};
+
+/** @brief Segment words of 'H', 'O' and 'L', written with the segment constants. */
+#define GLIFO_H                                                                                                        \
+    (LEDS_DISPLAY_SEGMENT_B | LEDS_DISPLAY_SEGMENT_C | LEDS_DISPLAY_SEGMENT_E | LEDS_DISPLAY_SEGMENT_F |               \
+     LEDS_DISPLAY_SEGMENT_G1 | LEDS_DISPLAY_SEGMENT_G2)
+#define GLIFO_O                                                                                                        \
+    (LEDS_DISPLAY_SEGMENT_A1 | LEDS_DISPLAY_SEGMENT_A2 | LEDS_DISPLAY_SEGMENT_B | LEDS_DISPLAY_SEGMENT_C |             \
+     LEDS_DISPLAY_SEGMENT_D1 | LEDS_DISPLAY_SEGMENT_D2 | LEDS_DISPLAY_SEGMENT_E | LEDS_DISPLAY_SEGMENT_F)
+#define GLIFO_L (LEDS_DISPLAY_SEGMENT_D1 | LEDS_DISPLAY_SEGMENT_D2 | LEDS_DISPLAY_SEGMENT_E | LEDS_DISPLAY_SEGMENT_F)
+
+/**
+ * @brief Set up function for the test case.
+ *
+ * Fills the digits with segments that every test must overwrite.
+ */
+void setUp(void)
+{
+    digitos[0] = 0xFFFF;
+    digitos[1] = 0xFFFF;
+    digitos[2] = 0xFFFF;
+}
+
+REGISTER_TEST(test_cada_caracter_se_convierte_en_sus_segmentos)
+{
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_H, leds_display_glyph('H'));
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_O, leds_display_glyph('O'));
+    TEST_ASSERT_EQUAL_HEX16(LEDS_DISPLAY_SEGMENT_B | LEDS_DISPLAY_SEGMENT_C | LEDS_DISPLAY_SEGMENT_J,
+                            leds_display_glyph('1'));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, leds_display_glyph(' '));
+}
+
+REGISTER_TEST(test_las_minusculas_se_muestran_como_mayusculas)
+{
+    TEST_ASSERT_EQUAL_HEX16(leds_display_glyph('H'), leds_display_glyph('h'));
+    TEST_ASSERT_EQUAL_HEX16(leds_display_glyph('Z'), leds_display_glyph('z'));
+}
+
+REGISTER_TEST(test_los_caracteres_fuera_de_la_fuente_se_muestran_apagados)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x0000, leds_display_glyph('\n'));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, leds_display_glyph(0x7F));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, leds_display_glyph((char)0xE9));
+}
+
+REGISTER_TEST(test_escribir_un_texto_carga_un_digito_por_banco)
+{
+    TEST_ASSERT_EQUAL(3, leds_display_write(puertos, BANCOS, "HOL"));
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_H, digitos[0]);
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_O, digitos[1]);
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_L, digitos[2]);
+}
+
+REGISTER_TEST(test_un_texto_corto_apaga_los_bancos_sobrantes)
+{
+    TEST_ASSERT_EQUAL(1, leds_display_write(puertos, BANCOS, "H"));
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_H, digitos[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, digitos[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, digitos[2]);
+}
+
+REGISTER_TEST(test_un_texto_largo_se_corta_en_el_ultimo_banco)
+{
+    TEST_ASSERT_EQUAL(BANCOS, leds_display_write(puertos, BANCOS, "HOLA"));
+    TEST_ASSERT_EQUAL_HEX16(GLIFO_L, digitos[2]);
+}
+
+REGISTER_TEST(test_escribir_con_parametros_invalidos_no_modifica_los_bancos)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_write(NULL, BANCOS, "HOL"));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_write(puertos, 0, "HOL"));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_write(puertos, BANCOS, NULL));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, digitos[0]);
+}
+
+REGISTER_TEST(test_la_marquesina_precalcula_todos_los_cuadros)
+{
+    static const uint16_t esperados[][BANCOS] = {
+        {0, 0, 0}, {0, 0, GLIFO_H}, {0, GLIFO_H, GLIFO_O}, {GLIFO_H, GLIFO_O, 0}, {GLIFO_O, 0, 0}, {0, 0, 0},
+    };
+    uint16_t cuadros[LEDS_DISPLAY_MARQUEE_WORDS(2, BANCOS)];
+    leds_display_marquee_t marquesina;
+    int cuadro;
+
+    TEST_ASSERT_EQUAL(6, leds_display_marquee_prepare(&marquesina, "HO", BANCOS, cuadros, 8));
+    for (cuadro = 0; cuadro < 6; cuadro++)
+    {
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(esperados[cuadro], leds_display_marquee_frame(&marquesina, cuadro), BANCOS);
+    }
+    TEST_ASSERT_NULL(leds_display_marquee_frame(&marquesina, 6));
+    TEST_ASSERT_NULL(leds_display_marquee_frame(&marquesina, -1));
+}
+
+REGISTER_TEST(test_la_marquesina_muestra_los_cuadros_en_orden_y_vuelve_a_empezar)
+{
+    uint16_t cuadros[LEDS_DISPLAY_MARQUEE_WORDS(2, BANCOS)];
+    leds_display_marquee_t marquesina;
+    int cuadro;
+
+    leds_display_marquee_prepare(&marquesina, "HO", BANCOS, cuadros, 8);
+    for (cuadro = 0; cuadro < 6; cuadro++)
+    {
+        TEST_ASSERT_EQUAL(cuadro, leds_display_marquee_show(&marquesina, puertos));
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(leds_display_marquee_frame(&marquesina, cuadro), digitos, BANCOS);
+    }
+    TEST_ASSERT_EQUAL(0, leds_display_marquee_show(&marquesina, puertos));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, digitos[2]);
+}
+
+REGISTER_TEST(test_la_marquesina_no_se_prepara_en_un_buffer_chico)
+{
+    uint16_t cuadros[LEDS_DISPLAY_MARQUEE_WORDS(2, BANCOS)];
+    leds_display_marquee_t marquesina;
+
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_marquee_prepare(&marquesina, "HO", BANCOS, cuadros, 7));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_marquee_prepare(&marquesina, "HO", 0, cuadros, 8));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_display_marquee_prepare(NULL, "HO", BANCOS, cuadros, 8));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,168 @@
+#include "leds_dither.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_dither.c
+ * @brief Test cases for the temporal dithering of on/off LEDs.
+ *
+ * The on frames of each LED are counted over a whole cycle of 2^bits frames and compared
+ * against its intensity, and after every frame against the ideal fraction of the frames.
+ */
+#define BANCOS 3
+#define LEDS_POR_BANCO 16
+#define CANTIDAD (BANCOS * LEDS_POR_BANCO)
+
+static uint16_t errores[CANTIDAD];
+static uint16_t intensidades[CANTIDAD];
+static uint16_t palabras[BANCOS];
+static long encendidos[CANTIDAD];
+static leds_dither_t difusion;
+
+void setUp(void)
+{
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        encendidos[led] = 0;
+    }
+}
+
+/** @brief The number of frames of a cycle an intensity is on: one more for the upper half. */
+static long cuadros_encendidos(uint16_t intensidad, int bits)
+{
+    return (long)intensidad + (intensidad >> (bits - 1));
+}
+
+/** @brief Adds the LEDs that are on in the words of a frame to their counters. */
+static void contar_encendidos(void)
+{
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        encendidos[led] += (palabras[led / LEDS_POR_BANCO] >> (led % LEDS_POR_BANCO)) & 1;
+    }
+}
+
+REGISTER_TEST(test_en_un_ciclo_cada_led_se_enciende_segun_su_intensidad)
+{
+    int cuadro;
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        intensidades[led] = (uint16_t)((led * 887 + 3) % 4096);
+    }
+    intensidades[0] = 0;
+    intensidades[1] = 1;
+    intensidades[2] = 2047;
+    intensidades[3] = 2048;
+    intensidades[4] = 4095;
+    TEST_ASSERT_EQUAL(1, leds_dither_init(&difusion, 12, BANCOS, errores));
+    for (cuadro = 1; cuadro <= 4096; cuadro++)
+    {
+        TEST_ASSERT_EQUAL(1, leds_dither_frame(&difusion, intensidades, palabras));
+        contar_encendidos();
+        for (led = 0; led < CANTIDAD; led++)
+        {
+            const long ideal = cuadros_encendidos(intensidades[led], 12) * cuadro;
+            TEST_ASSERT_TRUE(encendidos[led] * 4096 > ideal - 4096 && encendidos[led] * 4096 < ideal + 4096);
+        }
+    }
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        TEST_ASSERT_EQUAL(cuadros_encendidos(intensidades[led], 12), encendidos[led]);
+    }
+}
+
+REGISTER_TEST(test_con_16_bits_el_ciclo_tiene_65536_cuadros)
+{
+    long cuadro;
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        intensidades[led] = (uint16_t)(led * 14057u + 1u);
+    }
+    intensidades[0] = 0;
+    intensidades[1] = 65535;
+    TEST_ASSERT_EQUAL(1, leds_dither_init(&difusion, 16, BANCOS, errores));
+    for (cuadro = 0; cuadro < 65536; cuadro++)
+    {
+        leds_dither_frame(&difusion, intensidades, palabras);
+        contar_encendidos();
+    }
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        TEST_ASSERT_EQUAL(cuadros_encendidos(intensidades[led], 16), encendidos[led]);
+    }
+}
+
+REGISTER_TEST(test_el_maximo_siempre_esta_encendido_y_el_cero_siempre_apagado)
+{
+    int cuadro;
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        intensidades[led] = (led < LEDS_POR_BANCO) ? 4095 : 0;
+    }
+    TEST_ASSERT_EQUAL(1, leds_dither_init(&difusion, 12, BANCOS, errores));
+    for (cuadro = 0; cuadro < 100; cuadro++)
+    {
+        leds_dither_frame(&difusion, intensidades, palabras);
+        TEST_ASSERT_EQUAL_HEX16(0xFFFF, palabras[0]);
+        TEST_ASSERT_EQUAL_HEX16(0x0000, palabras[1]);
+        TEST_ASSERT_EQUAL_HEX16(0x0000, palabras[2]);
+    }
+}
+
+REGISTER_TEST(test_leds_con_la_misma_intensidad_no_se_encienden_juntos)
+{
+    uint16_t todos = 0;
+    int cuadro;
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        intensidades[led] = 256;
+    }
+    TEST_ASSERT_EQUAL(1, leds_dither_init(&difusion, 12, BANCOS, errores));
+    for (cuadro = 0; cuadro < LEDS_POR_BANCO; cuadro++)
+    {
+        leds_dither_frame(&difusion, intensidades, palabras);
+        TEST_ASSERT_TRUE(palabras[0] != 0 && (palabras[0] & (palabras[0] - 1)) == 0);
+        TEST_ASSERT_EQUAL_HEX16(palabras[0], palabras[2]);
+        todos = (uint16_t)(todos | palabras[0]);
+    }
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, todos);
+}
+
+REGISTER_TEST(test_parametros_invalidos_devuelven_error)
+{
+    leds_dither_t sin_iniciar = {12, 1, NULL};
+
+    TEST_ASSERT_EQUAL(-1, leds_dither_init(NULL, 12, BANCOS, errores));
+    TEST_ASSERT_EQUAL(-1, leds_dither_init(&difusion, 8, BANCOS, errores));
+    TEST_ASSERT_EQUAL(-1, leds_dither_init(&difusion, 12, 0, errores));
+    TEST_ASSERT_EQUAL(-1, leds_dither_init(&difusion, 16, BANCOS, NULL));
+    TEST_ASSERT_EQUAL(-1, leds_dither_frame(&sin_iniciar, intensidades, palabras));
+    TEST_ASSERT_EQUAL(1, leds_dither_init(&difusion, 12, BANCOS, errores));
+    TEST_ASSERT_EQUAL(-1, leds_dither_frame(&difusion, NULL, palabras));
+    TEST_ASSERT_EQUAL(-1, leds_dither_frame(&difusion, intensidades, NULL));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,197 @@
+#include "leds_fade.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_fade.c
+ * @brief Test cases for the fixed-point fade engine.
+ *
+ * Every tick is compared against the exact linear interpolation between the two frames,
+ * and the bit planes against the bits of each level taken one by one. The number of LEDs
+ * is not a multiple of 16, so both the SIMD loop and its tail are run.
+ */
+#define BANCOS 4
+#define LEDS_POR_BANCO 16
+#define CANTIDAD (BANCOS * LEDS_POR_BANCO - 3)
+
+static uint8_t desde[CANTIDAD];
+static uint8_t hasta[CANTIDAD];
+static uint8_t brillo[CANTIDAD];
+static uint16_t niveles8[CANTIDAD];
+static uint16_t pasos8[CANTIDAD];
+static uint32_t niveles16[CANTIDAD];
+static uint32_t pasos16[CANTIDAD];
+static leds_fade_t fundido;
+
+void setUp(void)
+{
+    int led;
+
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        desde[led] = (uint8_t)(led * 71 + 5);
+        hasta[led] = (uint8_t)(led * 29 + 200);
+    }
+    desde[0] = 0;
+    hasta[0] = 255;
+    desde[1] = 255;
+    hasta[1] = 0;
+}
+
+/**
+ * @brief Runs a whole fade and checks every tick against the linear interpolation.
+ *
+ * Steps are rounded towards zero, so a level may lag behind the exact value by one,
+ * never more, and never goes past the target.
+ */
+static void verificar_fundido(int pasos)
+{
+    int paso;
+    int led;
+
+    TEST_ASSERT_EQUAL(1, leds_fade_start(&fundido, desde, hasta, pasos));
+    for (paso = 1; paso <= pasos; paso++)
+    {
+        TEST_ASSERT_EQUAL(pasos - paso, leds_fade_tick(&fundido, brillo));
+        for (led = 0; led < CANTIDAD; led++)
+        {
+            const int diferencia = hasta[led] - desde[led];
+
+            TEST_ASSERT_INT_WITHIN(1, desde[led] + diferencia * paso / pasos, brillo[led]);
+            if (diferencia >= 0)
+            {
+                TEST_ASSERT_TRUE(brillo[led] <= hasta[led]);
+            }
+            else
+            {
+                TEST_ASSERT_TRUE(brillo[led] >= hasta[led]);
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(hasta, brillo, CANTIDAD);
+}
+
+REGISTER_TEST(test_un_fundido_q8_8_sigue_la_interpolacion_y_termina_en_el_destino)
+{
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q8_8(&fundido, CANTIDAD, niveles8, pasos8));
+    verificar_fundido(1);
+    verificar_fundido(7);
+    verificar_fundido(100);
+}
+
+REGISTER_TEST(test_un_fundido_q16_16_sigue_la_interpolacion_y_termina_en_el_destino)
+{
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q16_16(&fundido, CANTIDAD, niveles16, pasos16));
+    verificar_fundido(1);
+    verificar_fundido(7);
+    verificar_fundido(1000);
+}
+
+REGISTER_TEST(test_al_iniciar_todos_los_leds_estan_apagados)
+{
+    int led;
+
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q8_8(&fundido, CANTIDAD, niveles8, pasos8));
+    TEST_ASSERT_EQUAL(0, leds_fade_tick(&fundido, brillo));
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0, brillo[led]);
+    }
+}
+
+REGISTER_TEST(test_despues_del_fundido_se_mantiene_el_destino)
+{
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q8_8(&fundido, CANTIDAD, niveles8, pasos8));
+    TEST_ASSERT_EQUAL(1, leds_fade_start(&fundido, desde, hasta, 3));
+    TEST_ASSERT_EQUAL(2, leds_fade_tick(&fundido, brillo));
+    TEST_ASSERT_EQUAL(1, leds_fade_tick(&fundido, brillo));
+    TEST_ASSERT_EQUAL(0, leds_fade_tick(&fundido, brillo));
+    TEST_ASSERT_EQUAL(0, leds_fade_tick(&fundido, brillo));
+    TEST_ASSERT_EQUAL(0, leds_fade_tick(&fundido, brillo));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(hasta, brillo, CANTIDAD);
+}
+
+REGISTER_TEST(test_un_fundido_cruzado_parte_del_brillo_mostrado)
+{
+    uint8_t mostrado[CANTIDAD];
+    int led;
+
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q16_16(&fundido, CANTIDAD, niveles16, pasos16));
+    TEST_ASSERT_EQUAL(1, leds_fade_start(&fundido, desde, hasta, 10));
+    leds_fade_tick(&fundido, brillo);
+    leds_fade_tick(&fundido, brillo);
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        mostrado[led] = brillo[led];
+    }
+    TEST_ASSERT_EQUAL(1, leds_fade_start(&fundido, mostrado, desde, 4));
+    TEST_ASSERT_EQUAL(3, leds_fade_tick(&fundido, brillo));
+    for (led = 0; led < CANTIDAD; led++)
+    {
+        const int diferencia = desde[led] - mostrado[led];
+        TEST_ASSERT_INT_WITHIN(1, mostrado[led] + diferencia / 4, brillo[led]);
+    }
+}
+
+REGISTER_TEST(test_los_planos_tienen_un_bit_de_cada_nivel)
+{
+    uint8_t niveles[BANCOS * LEDS_POR_BANCO];
+    uint16_t planos[LEDS_FADE_PLANES * BANCOS];
+    int plano;
+    int banco;
+    int led;
+
+    for (led = 0; led < BANCOS * LEDS_POR_BANCO; led++)
+    {
+        niveles[led] = (uint8_t)(led * 97 + 13);
+    }
+    TEST_ASSERT_EQUAL(1, leds_fade_planes(niveles, BANCOS, planos));
+    for (plano = 0; plano < LEDS_FADE_PLANES; plano++)
+    {
+        for (banco = 0; banco < BANCOS; banco++)
+        {
+            uint16_t esperado = 0;
+
+            for (led = 0; led < LEDS_POR_BANCO; led++)
+            {
+                if ((niveles[banco * LEDS_POR_BANCO + led] >> plano) & 1)
+                {
+                    esperado = (uint16_t)(esperado | (1u << led));
+                }
+            }
+            TEST_ASSERT_EQUAL_HEX16(esperado, planos[plano * BANCOS + banco]);
+        }
+    }
+}
+
+REGISTER_TEST(test_parametros_invalidos_devuelven_error)
+{
+    leds_fade_t sin_iniciar = {LEDS_FADE_Q8_8, 0, 0, NULL, NULL, NULL, NULL, NULL};
+    uint16_t planos[LEDS_FADE_PLANES];
+
+    TEST_ASSERT_EQUAL(-1, leds_fade_init_q8_8(NULL, CANTIDAD, niveles8, pasos8));
+    TEST_ASSERT_EQUAL(-1, leds_fade_init_q8_8(&fundido, 0, niveles8, pasos8));
+    TEST_ASSERT_EQUAL(-1, leds_fade_init_q8_8(&fundido, CANTIDAD, NULL, pasos8));
+    TEST_ASSERT_EQUAL(-1, leds_fade_init_q16_16(&fundido, CANTIDAD, niveles16, NULL));
+    TEST_ASSERT_EQUAL(-1, leds_fade_start(&sin_iniciar, desde, hasta, 1));
+    TEST_ASSERT_EQUAL(-1, leds_fade_tick(&sin_iniciar, brillo));
+    TEST_ASSERT_EQUAL(1, leds_fade_init_q8_8(&fundido, CANTIDAD, niveles8, pasos8));
+    TEST_ASSERT_EQUAL(-1, leds_fade_start(&fundido, desde, hasta, 0));
+    TEST_ASSERT_EQUAL(-1, leds_fade_start(&fundido, NULL, hasta, 1));
+    TEST_ASSERT_EQUAL(-1, leds_fade_tick(&fundido, NULL));
+    TEST_ASSERT_EQUAL(-1, leds_fade_planes(desde, 0, planos));
+    TEST_ASSERT_EQUAL(-1, leds_fade_planes(NULL, 1, planos));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
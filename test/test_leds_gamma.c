@@ -0,0 +1,119 @@
+#include <math.h>
+#include "leds_gamma.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_gamma.c
+ * @brief Test cases for the brightness correction tables.
+ *
+ * Every entry of the tables is compared against the floating-point formula it caches,
+ * and applying a table to whole banks against looking up each level on its own.
+ */
+#define BANCOS 5
+#define LEDS_POR_BANCO 16
+
+void setUp(void)
+{
+}
+
+/** @brief The CIE 1931 relative luminance of a lightness from 0 to 100. */
+static double luminancia_cie(double claridad)
+{
+    return (claridad <= 8.0) ? claridad / 903.3 : pow((claridad + 16.0) / 116.0, 3.0);
+}
+
+REGISTER_TEST(test_la_tabla_gamma_sigue_la_formula)
+{
+    const uint8_t *tabla8 = leds_gamma_table8(LEDS_GAMMA_CURVE_POWER);
+    const uint16_t *tabla12 = leds_gamma_table12(LEDS_GAMMA_CURVE_POWER);
+    int nivel;
+
+    for (nivel = 0; nivel < LEDS_GAMMA_LEVELS; nivel++)
+    {
+        const double ciclo = pow(nivel / 255.0, LEDS_GAMMA);
+        TEST_ASSERT_INT_WITHIN(1, (int)lround(ciclo * 255.0), tabla8[nivel]);
+        TEST_ASSERT_INT_WITHIN(1, (int)lround(ciclo * 4095.0), tabla12[nivel]);
+    }
+}
+
+REGISTER_TEST(test_la_tabla_cie_sigue_la_formula)
+{
+    const uint8_t *tabla8 = leds_gamma_table8(LEDS_GAMMA_CURVE_CIE1931);
+    const uint16_t *tabla12 = leds_gamma_table12(LEDS_GAMMA_CURVE_CIE1931);
+    int nivel;
+
+    for (nivel = 0; nivel < LEDS_GAMMA_LEVELS; nivel++)
+    {
+        const double ciclo = luminancia_cie(nivel * 100.0 / 255.0);
+        TEST_ASSERT_INT_WITHIN(1, (int)lround(ciclo * 255.0), tabla8[nivel]);
+        TEST_ASSERT_INT_WITHIN(1, (int)lround(ciclo * 4095.0), tabla12[nivel]);
+    }
+}
+
+REGISTER_TEST(test_las_tablas_van_de_apagado_a_encendido_sin_bajar)
+{
+    const leds_gamma_curve_t curvas[2] = {LEDS_GAMMA_CURVE_POWER, LEDS_GAMMA_CURVE_CIE1931};
+    int curva;
+    int nivel;
+
+    for (curva = 0; curva < 2; curva++)
+    {
+        const uint8_t *tabla8 = leds_gamma_table8(curvas[curva]);
+        const uint16_t *tabla12 = leds_gamma_table12(curvas[curva]);
+
+        TEST_ASSERT_EQUAL_UINT8(0, tabla8[0]);
+        TEST_ASSERT_EQUAL_UINT8(255, tabla8[255]);
+        TEST_ASSERT_EQUAL_UINT16(0, tabla12[0]);
+        TEST_ASSERT_EQUAL_UINT16(4095, tabla12[255]);
+        for (nivel = 1; nivel < LEDS_GAMMA_LEVELS; nivel++)
+        {
+            TEST_ASSERT_TRUE(tabla8[nivel] >= tabla8[nivel - 1]);
+            TEST_ASSERT_TRUE(tabla12[nivel] >= tabla12[nivel - 1]);
+        }
+    }
+}
+
+REGISTER_TEST(test_cada_tabla_se_calcula_una_sola_vez)
+{
+    TEST_ASSERT_EQUAL_PTR(leds_gamma_table8(LEDS_GAMMA_CURVE_CIE1931), leds_gamma_table8(LEDS_GAMMA_CURVE_CIE1931));
+    TEST_ASSERT_NULL(leds_gamma_table8((leds_gamma_curve_t)7));
+    TEST_ASSERT_NULL(leds_gamma_table12((leds_gamma_curve_t)7));
+}
+
+REGISTER_TEST(test_aplicar_a_los_bancos_busca_cada_nivel_en_la_tabla)
+{
+    const uint8_t *tabla8 = leds_gamma_table8(LEDS_GAMMA_CURVE_CIE1931);
+    const uint16_t *tabla12 = leds_gamma_table12(LEDS_GAMMA_CURVE_POWER);
+    uint8_t niveles[BANCOS * LEDS_POR_BANCO + 3];
+    uint8_t ciclos8[BANCOS * LEDS_POR_BANCO + 3];
+    uint16_t ciclos12[BANCOS * LEDS_POR_BANCO + 3];
+    size_t led;
+
+    for (led = 0; led < sizeof(niveles); led++)
+    {
+        niveles[led] = (uint8_t)(led * 53 + 7);
+    }
+    leds_gamma_apply8(tabla8, niveles, ciclos8, sizeof(niveles));
+    leds_gamma_apply12(tabla12, niveles, ciclos12, sizeof(niveles));
+    for (led = 0; led < sizeof(niveles); led++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(tabla8[niveles[led]], ciclos8[led]);
+        TEST_ASSERT_EQUAL_UINT16(tabla12[niveles[led]], ciclos12[led]);
+    }
+    leds_gamma_apply8(tabla8, niveles, niveles, sizeof(niveles));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ciclos8, niveles, sizeof(niveles));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
@@ -0,0 +1,164 @@
+#include "leds_lanes.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_lanes.c
+ * @brief Test cases for the 16-lane parallel shift register output.
+ *
+ * The transpose kernel and the encoder are compared against a naive reference that builds
+ * every port word one bit at a time, on fixed and on pseudo-random chain buffers. The same
+ * tests run against the SSE2 and the portable kernels.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+#define PALABRAS 4
+#define MATRICES_AL_AZAR 1000
+
+static uint32_t semilla;
+
+void setUp(void)
+{
+    semilla = 0x2545F491u;
+}
+
+/** @brief Returns the next number of a xorshift32 sequence. */
+static uint16_t al_azar(void)
+{
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return (uint16_t)(semilla >> 8);
+}
+
+/**
+ * @brief Naive reference: the port word of each clock gets bit 15 - clock of every chain, one bit at a time.
+ */
+static void transponer_bit_a_bit(const uint16_t carriles[LEDS_LANES], uint16_t relojes[16])
+{
+    int reloj;
+    int carril;
+
+    for (reloj = 0; reloj < 16; reloj++)
+    {
+        relojes[reloj] = 0;
+        for (carril = 0; carril < LEDS_LANES; carril++)
+        {
+            if (carriles[carril] & (1u << (15 - reloj)))
+            {
+                relojes[reloj] |= (uint16_t)(1u << carril);
+            }
+        }
+    }
+}
+
+REGISTER_TEST(test_el_bit_mas_significativo_de_cada_cadena_sale_primero)
+{
+    uint16_t carriles[LEDS_LANES] = {0};
+    uint16_t relojes[16];
+
+    carriles[2] = 0x8000;
+    carriles[15] = 0x0001;
+    leds_lanes_transpose(carriles, relojes);
+    TEST_ASSERT_EQUAL_HEX16(0x0004, relojes[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, relojes[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x8000, relojes[15]);
+}
+
+REGISTER_TEST(test_una_cadena_encendida_aparece_en_su_linea_en_todos_los_relojes)
+{
+    uint16_t carriles[LEDS_LANES] = {0};
+    uint16_t relojes[16];
+
+    carriles[0] = 0xFFFF;
+    leds_lanes_transpose(carriles, relojes);
+    TEST_ASSERT_EACH_EQUAL_HEX16(0x0001, relojes, 16);
+}
+
+REGISTER_TEST(test_la_transpuesta_coincide_con_la_referencia_bit_a_bit)
+{
+    uint16_t carriles[LEDS_LANES];
+    uint16_t esperados[16];
+    uint16_t relojes[16];
+    int matriz;
+    int carril;
+
+    for (matriz = 0; matriz < MATRICES_AL_AZAR; matriz++)
+    {
+        for (carril = 0; carril < LEDS_LANES; carril++)
+        {
+            carriles[carril] = al_azar();
+        }
+        transponer_bit_a_bit(carriles, esperados);
+        leds_lanes_transpose(carriles, relojes);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(esperados, relojes, 16);
+    }
+}
+
+REGISTER_TEST(test_codificar_transpone_las_palabras_de_las_cadenas_en_orden)
+{
+    static uint16_t buffers[LEDS_LANES][PALABRAS];
+    const uint16_t *cadenas[LEDS_LANES];
+    uint16_t esperados[LEDS_LANES_STREAM_WORDS(PALABRAS)];
+    uint16_t flujo[LEDS_LANES_STREAM_WORDS(PALABRAS)];
+    uint16_t carriles[LEDS_LANES];
+    int palabra;
+    int carril;
+
+    for (carril = 0; carril < LEDS_LANES; carril++)
+    {
+        for (palabra = 0; palabra < PALABRAS; palabra++)
+        {
+            buffers[carril][palabra] = al_azar();
+        }
+        cadenas[carril] = buffers[carril];
+    }
+    for (palabra = 0; palabra < PALABRAS; palabra++)
+    {
+        for (carril = 0; carril < LEDS_LANES; carril++)
+        {
+            carriles[carril] = buffers[carril][palabra];
+        }
+        transponer_bit_a_bit(carriles, esperados + 16 * palabra);
+    }
+    TEST_ASSERT_EQUAL(LEDS_LANES_STREAM_WORDS(PALABRAS),
+                      leds_lanes_encode(cadenas, PALABRAS, flujo, LEDS_LANES_STREAM_WORDS(PALABRAS)));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(esperados, flujo, LEDS_LANES_STREAM_WORDS(PALABRAS));
+}
+
+REGISTER_TEST(test_codificar_con_parametros_invalidos_devuelve_error)
+{
+    static uint16_t buffer[1];
+    const uint16_t *cadenas[LEDS_LANES] = {buffer, buffer, buffer, buffer, buffer, buffer, buffer, buffer,
+                                           buffer, buffer, buffer, buffer, buffer, buffer, buffer, NULL};
+    uint16_t flujo[LEDS_LANES_STREAM_WORDS(1)];
+
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_lanes_encode(cadenas, 1, flujo, LEDS_LANES_STREAM_WORDS(1)));
+    cadenas[15] = buffer;
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_lanes_encode(cadenas, 1, flujo, LEDS_LANES_STREAM_WORDS(1) - 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_lanes_encode(cadenas, 0, flujo, LEDS_LANES_STREAM_WORDS(1)));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_lanes_encode(NULL, 1, flujo, LEDS_LANES_STREAM_WORDS(1)));
+}
+
+REGISTER_TEST(test_enviar_deja_en_el_puerto_la_ultima_palabra_del_flujo)
+{
+    const uint16_t flujo[3] = {0x1111, 0x2222, 0x3333};
+    uint16_t puerto_virtual = 0;
+
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_lanes_send(&puerto_virtual, flujo, 3));
+    TEST_ASSERT_EQUAL_HEX16(0x3333, puerto_virtual);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_lanes_send(NULL, flujo, 3));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
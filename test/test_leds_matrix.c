@@ -0,0 +1,153 @@
+#include "leds_matrix.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_matrix.c
+ * @brief Test cases for the multiplexed LED matrix driver.
+ *
+ * An 8x8 matrix uses the whole virtual port: the rows on lines 1 to 8, in the low byte,
+ * and the columns on lines 9 to 16, in the high byte. Each test checks the port word
+ * left by the scan ticks.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+static uint16_t puerto_virtual;
+static leds_matrix_t matriz;
+
+/**
+ * @brief Set up function for the test case.
+ *
+ * Initializes an 8x8 matrix with every line active high.
+ */
+void setUp(void)
+{
+    puerto_virtual = 0xFFFF;
+    leds_matrix_init(&matriz, &puerto_virtual, 8, 8, 0x0000);
+}
+
+/**
+ * @brief Scans the given number of rows and returns the last port word.
+ */
+static uint16_t escanear(int filas)
+{
+    while (filas-- > 0)
+    {
+        leds_matrix_scan(&matriz);
+    }
+    return puerto_virtual;
+}
+
+REGISTER_TEST(test_al_iniciar_la_matriz_el_puerto_queda_apagado)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x0000, puerto_virtual);
+    TEST_ASSERT_EQUAL(0, leds_matrix_pixel(&matriz, 1, 1));
+}
+
+REGISTER_TEST(test_iniciar_con_parametros_invalidos_devuelve_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_init(&matriz, NULL, 8, 8, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_init(&matriz, &puerto_virtual, 0, 8, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_init(&matriz, &puerto_virtual, 9, 8, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_init(&matriz, &puerto_virtual, 8, 9, 0));
+}
+
+REGISTER_TEST(test_cada_tick_selecciona_la_fila_siguiente)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x0001, escanear(1));
+    TEST_ASSERT_EQUAL_HEX16(0x0002, escanear(1));
+    TEST_ASSERT_EQUAL_HEX16(0x0080, escanear(6));
+    TEST_ASSERT_EQUAL_HEX16(0x0001, escanear(1));
+}
+
+REGISTER_TEST(test_la_fila_muestra_sus_pixeles_encendidos_en_las_columnas)
+{
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_matrix_set_pixel(&matriz, 2, 1, 1));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_matrix_set_pixel(&matriz, 2, 8, 1));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_matrix_set_pixel(&matriz, 3, 4, 1));
+    TEST_ASSERT_EQUAL_HEX16(0x0001, escanear(1));
+    TEST_ASSERT_EQUAL_HEX16(0x8102, escanear(1));
+    TEST_ASSERT_EQUAL_HEX16(0x0804, escanear(1));
+    TEST_ASSERT_EQUAL(1, leds_matrix_pixel(&matriz, 2, 8));
+}
+
+REGISTER_TEST(test_apagar_un_pixel_lo_quita_de_su_fila)
+{
+    leds_matrix_set_row(&matriz, 1, 0xFF);
+    leds_matrix_set_pixel(&matriz, 1, 5, 0);
+    TEST_ASSERT_EQUAL_HEX16(0xEF01, escanear(1));
+    leds_matrix_clear(&matriz);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, escanear(8));
+}
+
+REGISTER_TEST(test_los_pixeles_fuera_de_la_matriz_devuelven_error)
+{
+    leds_matrix_init(&matriz, &puerto_virtual, 4, 5, 0x0000);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_pixel(&matriz, 5, 1, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_pixel(&matriz, 1, 6, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_pixel(&matriz, 0, 1, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_pixel(&matriz, 1, 0, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_pixel(&matriz, 1, 40, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_pixel(&matriz, 1, 0));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_row(&matriz, 5, 0x01));
+}
+
+REGISTER_TEST(test_una_matriz_chica_usa_las_lineas_siguientes_a_sus_filas)
+{
+    leds_matrix_init(&matriz, &puerto_virtual, 4, 5, 0x0000);
+    leds_matrix_set_row(&matriz, 4, 0xFF);
+    TEST_ASSERT_EQUAL_HEX16(0x01F8, escanear(4));
+    TEST_ASSERT_EQUAL_HEX16(0x0001, escanear(1));
+}
+
+REGISTER_TEST(test_las_lineas_activas_en_bajo_se_invierten)
+{
+    leds_matrix_init(&matriz, &puerto_virtual, 8, 8, 0x00FF);
+    TEST_ASSERT_EQUAL_HEX16(0x00FF, puerto_virtual);
+    leds_matrix_set_pixel(&matriz, 1, 3, 1);
+    TEST_ASSERT_EQUAL_HEX16(0x04FE, escanear(1));
+    TEST_ASSERT_EQUAL_HEX16(0x00FD, escanear(1));
+}
+
+REGISTER_TEST(test_una_fila_con_brillo_parcial_se_muestra_en_parte_de_los_barridos)
+{
+    int barrido;
+    int mostrada = 0;
+
+    leds_matrix_set_row(&matriz, 1, 0x01);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_matrix_set_brightness(&matriz, 1, LEDS_MATRIX_BRIGHTNESS_LEVELS / 4));
+    for (barrido = 0; barrido < 2 * LEDS_MATRIX_BRIGHTNESS_LEVELS; barrido++)
+    {
+        mostrada += escanear(1) == 0x0101;
+        TEST_ASSERT_EQUAL_HEX16(0x0002, escanear(1));
+        escanear(6);
+    }
+    TEST_ASSERT_EQUAL(LEDS_MATRIX_BRIGHTNESS_LEVELS / 2, mostrada);
+}
+
+REGISTER_TEST(test_una_fila_sin_brillo_nunca_se_muestra)
+{
+    int barrido;
+
+    leds_matrix_set_row(&matriz, 8, 0xFF);
+    leds_matrix_set_brightness(&matriz, 8, 0);
+    for (barrido = 0; barrido < LEDS_MATRIX_BRIGHTNESS_LEVELS; barrido++)
+    {
+        TEST_ASSERT_EQUAL_HEX16(0x0000, escanear(8));
+    }
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_matrix_set_brightness(&matriz, 8, LEDS_MATRIX_BRIGHTNESS_LEVELS + 1));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
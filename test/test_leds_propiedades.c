@@ -0,0 +1,208 @@
+#include "leds.h"
+#include "unity.h"
+#include "unity_property.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_propiedades.c
+ * @brief Property tests for the LED controller.
+ *
+ * Instead of checking a few hand-picked cases, each property draws random
+ * sequences of driver calls, with LED indices inside and outside 1..16, and
+ * compares the port and every return value against a reference model after
+ * each call. A failing sequence is shrunk to the shortest one that still
+ * fails, and printed as the list of calls that reproduce it.
+ * In differential builds, each call is also checked against leds_reference.c.
+ */
+static uint16_t leds_virtuales;
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+
+/**
+ * @brief Number of random sequences tried by each property.
+ */
+#ifndef SECUENCIAS_POR_PROPIEDAD
+#define SECUENCIAS_POR_PROPIEDAD 100000
+#endif
+
+#define LARGO_MAXIMO_SECUENCIA 32
+
+/** @brief Draws an LED index, out of range about one time in five. */
+static int generar_led(void)
+{
+    return UnityPropertyIntBetween(-2, 18);
+}
+
+static int modelo_led_valido(int led) { return led >= 1 && led <= 16; }
+
+static uint16_t modelo_bit(int led) { return (uint16_t)(1u << (led - 1)); }
+
+static void anotar_llamada(const char *funcion, int led)
+{
+    UnityPropertyNote(funcion);
+    UnityPropertyNote("(");
+    UnityPropertyNoteInt(led);
+    UnityPropertyNote(") ");
+}
+
+/**
+ * @brief Applies a random sequence of driver calls and the same calls to a
+ * reference model, failing at the first call where they disagree.
+ *
+ * @return int 1 when the driver matched the model for the whole sequence.
+ */
+static int el_driver_se_comporta_como_el_modelo(void)
+{
+    const int largo = UnityPropertyIntBetween(1, LARGO_MAXIMO_SECUENCIA);
+#ifdef LEDS_DIFFERENTIAL_CHECK
+    const unsigned long diferencias = leds_differential_mismatches();
+#endif
+    uint16_t modelo = 0;
+    int esperado;
+    int obtenido;
+    int led;
+    int i;
+
+    leds_virtuales = (uint16_t)UnityPropertyRandom();
+    leds_init(&leds_virtuales);
+    UnityPropertyNote("leds_init() ");
+
+    for (i = 0; i < largo; i++)
+    {
+        esperado = 0;
+        obtenido = 0;
+        switch (UnityPropertyChoose(6))
+        {
+        case 0:
+            led = generar_led();
+            anotar_llamada("leds_turn_on", led);
+            esperado = modelo_led_valido(led) ? SUCCESS_CODE : ERROR_CODE;
+            if (modelo_led_valido(led))
+            {
+                modelo |= modelo_bit(led);
+            }
+            obtenido = leds_turn_on(led);
+            break;
+        case 1:
+            led = generar_led();
+            anotar_llamada("leds_turn_off", led);
+            esperado = modelo_led_valido(led) ? SUCCESS_CODE : ERROR_CODE;
+            if (modelo_led_valido(led))
+            {
+                modelo &= (uint16_t)~modelo_bit(led);
+            }
+            obtenido = leds_turn_off(led);
+            break;
+        case 2:
+            led = generar_led();
+            anotar_llamada("leds_state", led);
+            esperado = modelo_led_valido(led) ? ((modelo & modelo_bit(led)) != 0) : ERROR_CODE;
+            obtenido = leds_state(led);
+            break;
+        case 3:
+            UnityPropertyNote("leds_turn_all_on() ");
+            modelo = 0xFFFF;
+            leds_turn_all_on();
+            break;
+        case 4:
+            UnityPropertyNote("leds_turn_all_off() ");
+            modelo = 0;
+            leds_turn_all_off();
+            break;
+        default:
+            UnityPropertyNote("leds_init() ");
+            leds_virtuales = (uint16_t)UnityPropertyRandom();
+            modelo = 0;
+            leds_init(&leds_virtuales);
+            break;
+        }
+        if (obtenido != esperado || leds_virtuales != modelo)
+        {
+            UnityPropertyNote("returned ");
+            UnityPropertyNoteInt(obtenido);
+            UnityPropertyNote(" with the port at ");
+            UnityPropertyNoteInt(leds_virtuales);
+            UnityPropertyNote(", expected ");
+            UnityPropertyNoteInt(esperado);
+            UnityPropertyNote(" with the port at ");
+            UnityPropertyNoteInt(modelo);
+            return 0;
+        }
+#ifdef LEDS_DIFFERENTIAL_CHECK
+        if (leds_differential_mismatches() != diferencias)
+        {
+            UnityPropertyNote("disagrees with leds_reference.c");
+            return 0;
+        }
+#endif
+    }
+    return 1;
+}
+
+/**
+ * @brief Applies random calls with valid LED indices only and checks that
+ * leds_state reports exactly the LEDs left on.
+ *
+ * @return int 1 when every LED reports the state of its bit in the port.
+ */
+static int el_estado_refleja_el_puerto(void)
+{
+    const int largo = UnityPropertyIntBetween(1, LARGO_MAXIMO_SECUENCIA);
+    int led;
+    int i;
+
+    leds_init(&leds_virtuales);
+    for (i = 0; i < largo; i++)
+    {
+        led = UnityPropertyIntBetween(1, 16);
+        if (UnityPropertyOneIn(2))
+        {
+            anotar_llamada("leds_turn_on", led);
+            leds_turn_on(led);
+        }
+        else
+        {
+            anotar_llamada("leds_turn_off", led);
+            leds_turn_off(led);
+        }
+    }
+    for (led = 1; led <= 16; led++)
+    {
+        if (leds_state(led) != ((leds_virtuales >> (led - 1)) & 1))
+        {
+            anotar_llamada("leds_state", led);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Set up function for the test case.
+ */
+void setUp(void)
+{
+    leds_init(&leds_virtuales);
+}
+
+REGISTER_TEST(test_el_driver_se_comporta_como_el_modelo)
+{
+    TEST_ASSERT_PROPERTY(el_driver_se_comporta_como_el_modelo, SECUENCIAS_POR_PROPIEDAD);
+}
+
+REGISTER_TEST(test_el_estado_refleja_el_puerto)
+{
+    TEST_ASSERT_PROPERTY(el_estado_refleja_el_puerto, SECUENCIAS_POR_PROPIEDAD);
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+}
@@ -0,0 +1,175 @@
+#include "leds_shift.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_shift.c
+ * @brief Test cases for the shift register chain backend.
+ *
+ * Every port word of the stream is applied to a virtual chain of 74HC595 registers, two
+ * per bank: on the rising edge of the clock every register shifts one position, the data
+ * line entering output 1 of bank 1 and output 16 of each bank passing to the next one,
+ * and on the rising edge of the latch the shifted bits are copied to the outputs.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+#define BANCOS 3
+#define RELOJ 0x0001
+#define DATO 0x0002
+#define CERROJO 0x0004
+
+static uint16_t puerto_virtual;
+static uint16_t flujo[LEDS_SHIFT_STREAM_WORDS(BANCOS)];
+static leds_shift_t cadena;
+
+/** @brief The virtual chain: the shift registers, the latched outputs and the last port word seen. */
+static struct
+{
+    uint16_t registros[BANCOS];
+    uint16_t salidas[BANCOS];
+    uint16_t anterior;
+    int cerrojos;
+} virtual;
+
+/**
+ * @brief Applies one port word to the virtual chain.
+ */
+static void aplicar_palabra(uint16_t palabra)
+{
+    const uint16_t subidas = (uint16_t)(palabra & ~virtual.anterior);
+    int banco;
+
+    if (subidas & RELOJ)
+    {
+        for (banco = BANCOS - 1; banco > 0; banco--)
+        {
+            virtual.registros[banco] = (uint16_t)((virtual.registros[banco] << 1) | (virtual.registros[banco - 1] >> 15));
+        }
+        virtual.registros[0] = (uint16_t)((virtual.registros[0] << 1) | ((palabra & DATO) ? 1 : 0));
+    }
+    if (subidas & CERROJO)
+    {
+        for (banco = 0; banco < BANCOS; banco++)
+        {
+            virtual.salidas[banco] = virtual.registros[banco];
+        }
+        virtual.cerrojos++;
+    }
+    virtual.anterior = palabra;
+}
+
+/**
+ * @brief Applies the first palabras words of the stream to the virtual chain.
+ */
+static void aplicar_flujo(int palabras)
+{
+    int indice;
+
+    for (indice = 0; indice < palabras; indice++)
+    {
+        aplicar_palabra(flujo[indice]);
+    }
+}
+
+/**
+ * @brief Set up function for the test case.
+ *
+ * Initializes a chain of three banks and a virtual chain with every register and output off.
+ */
+void setUp(void)
+{
+    int banco;
+
+    puerto_virtual = 0xFFFF;
+    leds_shift_init(&cadena, &puerto_virtual, RELOJ, DATO, CERROJO, BANCOS, flujo, LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    for (banco = 0; banco < BANCOS; banco++)
+    {
+        virtual.registros[banco] = 0;
+        virtual.salidas[banco] = 0;
+    }
+    virtual.anterior = 0;
+    virtual.cerrojos = 0;
+}
+
+REGISTER_TEST(test_al_iniciar_las_lineas_quedan_en_bajo)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x0000, puerto_virtual);
+}
+
+REGISTER_TEST(test_iniciar_con_parametros_invalidos_devuelve_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_shift_init(&cadena, &puerto_virtual, RELOJ, DATO, CERROJO, BANCOS, flujo,
+                                                  LEDS_SHIFT_STREAM_WORDS(BANCOS) - 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE,
+                      leds_shift_init(&cadena, &puerto_virtual, RELOJ, RELOJ, CERROJO, BANCOS, flujo, 100));
+    TEST_ASSERT_EQUAL(ERROR_CODE,
+                      leds_shift_init(&cadena, &puerto_virtual, 0x0003, DATO, CERROJO, BANCOS, flujo, 100));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_shift_init(&cadena, &puerto_virtual, RELOJ, DATO, 0, BANCOS, flujo, 100));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_shift_init(&cadena, NULL, RELOJ, DATO, CERROJO, BANCOS, flujo, 100));
+}
+
+REGISTER_TEST(test_cada_banco_recibe_su_palabra_del_cuadro)
+{
+    const uint16_t cuadro[BANCOS] = {0xA5C3, 0x0001, 0x8000};
+
+    TEST_ASSERT_EQUAL(LEDS_SHIFT_STREAM_WORDS(BANCOS), leds_shift_encode(&cadena, cuadro));
+    aplicar_flujo(LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(cuadro, virtual.salidas, BANCOS);
+}
+
+REGISTER_TEST(test_las_salidas_cambian_solo_con_el_unico_cerrojo_del_cuadro)
+{
+    const uint16_t cuadro[BANCOS] = {0xFFFF, 0x1234, 0xFFFF};
+    const uint16_t apagado[BANCOS] = {0};
+
+    leds_shift_encode(&cadena, cuadro);
+    aplicar_flujo(LEDS_SHIFT_STREAM_WORDS(BANCOS) - 2);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(apagado, virtual.salidas, BANCOS);
+    TEST_ASSERT_EQUAL(0, virtual.cerrojos);
+    aplicar_flujo(LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    TEST_ASSERT_EQUAL(1, virtual.cerrojos);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(cuadro, virtual.salidas, BANCOS);
+}
+
+REGISTER_TEST(test_el_flujo_solo_usa_las_lineas_de_la_cadena)
+{
+    const uint16_t cuadro[BANCOS] = {0xFFFF, 0xFFFF, 0xFFFF};
+    uint16_t usadas = 0;
+    int indice;
+
+    leds_shift_encode(&cadena, cuadro);
+    for (indice = 0; indice < LEDS_SHIFT_STREAM_WORDS(BANCOS); indice++)
+    {
+        usadas |= flujo[indice];
+    }
+    TEST_ASSERT_EQUAL_HEX16(RELOJ | DATO | CERROJO, usadas);
+}
+
+REGISTER_TEST(test_enviar_escribe_el_flujo_y_deja_las_lineas_en_bajo)
+{
+    const uint16_t cuadro[BANCOS] = {0x00FF, 0xFF00, 0x0F0F};
+
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_shift_write(&cadena, cuadro));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, puerto_virtual);
+    aplicar_flujo(LEDS_SHIFT_STREAM_WORDS(BANCOS));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(cuadro, virtual.salidas, BANCOS);
+}
+
+REGISTER_TEST(test_escribir_sin_cuadro_devuelve_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_shift_write(&cadena, NULL));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_shift_send(NULL));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}
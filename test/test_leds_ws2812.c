@@ -0,0 +1,194 @@
+#include <string.h>
+#include "leds_ws2812.h"
+#include "unity.h"
+#include "unity_registry.h"
+
+/**
+ * @file test_leds_ws2812.c
+ * @brief Test cases for the addressable LED encoder.
+ *
+ * A decoder reads the buffer back the way a strip would: it checks the shape of every
+ * symbol and takes a 1 when the line stays high for more than one port word. Colours are
+ * encoded and decoded with 3 and 4 words per bit, whole and a few pixels at a time.
+ */
+#define ERROR_CODE -1
+#define SUCCESS_CODE 1
+#define DATO 0x0100
+#define PIXELES 16
+#define REINICIO 8
+
+static uint16_t buffer[LEDS_WS2812_BUFFER_WORDS(PIXELES, 4, REINICIO)];
+static uint8_t colores[3 * PIXELES];
+static leds_ws2812_t tira;
+
+/**
+ * @brief Set up function for the test case.
+ *
+ * Initializes a strip of 16 pixels with 3 words per bit and fills the colours with a pattern.
+ */
+void setUp(void)
+{
+    int indice;
+
+    leds_ws2812_init(&tira, DATO, 3, PIXELES, REINICIO, buffer, (int)(sizeof(buffer) / sizeof(buffer[0])));
+    for (indice = 0; indice < 3 * PIXELES; indice++)
+    {
+        colores[indice] = (uint8_t)(indice * 37 + 11);
+    }
+}
+
+/**
+ * @brief Decodes one symbol: the line must be high on a first run of words and low on the rest.
+ *
+ * @return int The decoded bit, or -1 if the symbol is malformed.
+ */
+static int decodificar_simbolo(const uint16_t *simbolo, int palabras)
+{
+    int altas = 0;
+    int palabra;
+
+    while (altas < palabras && simbolo[altas] == DATO)
+    {
+        altas++;
+    }
+    for (palabra = altas; palabra < palabras; palabra++)
+    {
+        if (simbolo[palabra] != 0)
+        {
+            return -1;
+        }
+    }
+    if (altas == palabras - 1)
+    {
+        return 1;
+    }
+    return (altas == 1) ? 0 : -1;
+}
+
+/**
+ * @brief Decodes the buffer of the strip into colours.
+ *
+ * @return int The number of decoded bytes, or -1 at the first malformed symbol or reset word.
+ */
+static int decodificar(uint8_t *decodificados)
+{
+    const int palabras = tira.symbol_words;
+    const uint16_t *simbolo = tira.buffer;
+    int byte;
+    int bit;
+    int palabra;
+
+    for (byte = 0; byte < 3 * tira.pixels; byte++)
+    {
+        decodificados[byte] = 0;
+        for (bit = 0; bit < 8; bit++, simbolo += palabras)
+        {
+            const int valor = decodificar_simbolo(simbolo, palabras);
+            if (valor < 0)
+            {
+                return -1;
+            }
+            decodificados[byte] = (uint8_t)((decodificados[byte] << 1) | valor);
+        }
+    }
+    for (palabra = 0; palabra < tira.reset_words; palabra++)
+    {
+        if (simbolo[palabra] != 0)
+        {
+            return -1;
+        }
+    }
+    return byte;
+}
+
+REGISTER_TEST(test_un_cero_y_un_uno_tienen_la_forma_de_su_simbolo)
+{
+    uint8_t pixel[3] = {0x80, 0x00, 0x00};
+    const uint16_t esperados[6] = {DATO, DATO, 0, DATO, 0, 0};
+
+    leds_ws2812_encode(&tira, pixel, 0, 1);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(esperados, buffer, 6);
+    leds_ws2812_init(&tira, DATO, 4, PIXELES, REINICIO, buffer, (int)(sizeof(buffer) / sizeof(buffer[0])));
+    pixel[0] = 0x7F;
+    leds_ws2812_encode(&tira, pixel, 0, 1);
+    TEST_ASSERT_EQUAL_HEX16(DATO, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX16(0, buffer[1]);
+    TEST_ASSERT_EQUAL_HEX16(DATO, buffer[6]);
+    TEST_ASSERT_EQUAL_HEX16(0, buffer[7]);
+}
+
+REGISTER_TEST(test_los_colores_vuelven_iguales_al_decodificar_con_tres_palabras_por_bit)
+{
+    uint8_t decodificados[3 * PIXELES];
+
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_ws2812_encode(&tira, colores, 0, PIXELES));
+    TEST_ASSERT_EQUAL(3 * PIXELES, decodificar(decodificados));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(colores, decodificados, 3 * PIXELES);
+}
+
+REGISTER_TEST(test_los_colores_vuelven_iguales_al_decodificar_con_cuatro_palabras_por_bit)
+{
+    uint8_t decodificados[3 * PIXELES];
+
+    leds_ws2812_init(&tira, DATO, 4, PIXELES, REINICIO, buffer, (int)(sizeof(buffer) / sizeof(buffer[0])));
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_ws2812_encode(&tira, colores, 0, PIXELES));
+    TEST_ASSERT_EQUAL(3 * PIXELES, decodificar(decodificados));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(colores, decodificados, 3 * PIXELES);
+}
+
+REGISTER_TEST(test_codificar_algunos_pixeles_solo_cambia_su_parte_del_buffer)
+{
+    static uint16_t completo[LEDS_WS2812_BUFFER_WORDS(PIXELES, 4, REINICIO)];
+    uint8_t decodificados[3 * PIXELES];
+
+    leds_ws2812_encode(&tira, colores, 0, PIXELES);
+    colores[3 * 5 + 1] = 0xFF;
+    colores[3 * 6 + 2] = 0x00;
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_ws2812_encode(&tira, colores, 5, 2));
+    TEST_ASSERT_EQUAL(3 * PIXELES, decodificar(decodificados));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(colores, decodificados, 3 * PIXELES);
+
+    memcpy(completo, buffer, sizeof(buffer));
+    leds_ws2812_encode(&tira, colores, 0, PIXELES);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(buffer, completo, LEDS_WS2812_BUFFER_WORDS(PIXELES, 3, REINICIO));
+}
+
+REGISTER_TEST(test_el_buffer_termina_con_las_palabras_de_reinicio_en_bajo)
+{
+    leds_ws2812_encode(&tira, colores, 0, PIXELES);
+    TEST_ASSERT_EACH_EQUAL_HEX16(0, buffer + LEDS_WS2812_BUFFER_WORDS(PIXELES, 3, 0), REINICIO);
+}
+
+REGISTER_TEST(test_enviar_escribe_el_buffer_y_deja_la_linea_en_bajo)
+{
+    uint16_t puerto_virtual = 0xFFFF;
+
+    leds_ws2812_encode(&tira, colores, 0, PIXELES);
+    TEST_ASSERT_EQUAL(SUCCESS_CODE, leds_ws2812_send(&tira, &puerto_virtual));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, puerto_virtual);
+}
+
+REGISTER_TEST(test_parametros_invalidos_devuelven_error)
+{
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_init(&tira, DATO, 2, PIXELES, REINICIO, buffer, 10000));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_init(&tira, 0, 3, PIXELES, REINICIO, buffer, 10000));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_init(&tira, DATO, 3, PIXELES, REINICIO, buffer,
+                                                   LEDS_WS2812_BUFFER_WORDS(PIXELES, 3, REINICIO) - 1));
+    leds_ws2812_init(&tira, DATO, 3, PIXELES, REINICIO, buffer, 10000);
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_encode(&tira, colores, PIXELES - 1, 2));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_encode(&tira, colores, -1, 1));
+    TEST_ASSERT_EQUAL(ERROR_CODE, leds_ws2812_encode(&tira, NULL, 0, 1));
+}
+
+/**
+ * @brief Runs every test registered with REGISTER_TEST, each one once.
+ */
+int main(int argc, char **argv)
+{
+    return UnityRegistryMain(argc, argv);
+}
+
+void tearDown(void)
+{
+    // vacia por ahora
+}